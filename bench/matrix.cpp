@@ -0,0 +1,222 @@
+// Compares cell access on the chunked Matrix layout with the flat x-major
+// layout it replaced (cells at x + y * width + z * width * height, read
+// through the bounds-checked get_copy()).
+//
+// Usage: mobitrenderer_bench_matrix [width height]
+// Defaults to a 1000x1000x3 level of GeoCells.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+#include <MobitRenderer/matrix.h>
+
+using clock_type = std::chrono::steady_clock;
+using mr::GeoCell;
+using mr::GeoType;
+using mr::matrix_t;
+
+static constexpr int rounds = 50;
+static constexpr matrix_t depth = 3;
+
+// The camera window scanned per camera by the renderer's preparation.
+static constexpr int window_width = 100, window_height = 60;
+
+/// @brief The previous Matrix storage, kept here as the baseline.
+class flat_matrix {
+  std::vector<GeoCell> _cells;
+  matrix_t _width, _height, _depth;
+
+public:
+  bool is_in_bounds(int x, int y, int z) const {
+    return x >= 0 && x < _width && y >= 0 && y < _height && z >= 0 && z < _depth;
+  }
+
+  GeoCell get_copy(matrix_t x, matrix_t y, matrix_t z) const {
+    if (!is_in_bounds(x, y, z))
+      throw std::out_of_range("matrix index is out bounds");
+
+    return _cells[x + (y * _width) + (z * _width * _height)];
+  }
+
+  void set(matrix_t x, matrix_t y, matrix_t z, GeoCell cell) {
+    _cells[x + (y * _width) + (z * _width * _height)] = cell;
+  }
+
+  flat_matrix(matrix_t width, matrix_t height, matrix_t depth)
+    : _cells(static_cast<size_t>(width) * height * depth), _width(width), _height(height), _depth(depth) {}
+};
+
+struct result {
+  double seconds;
+
+  // Keeps the scans from being optimized away.
+  long long checksum;
+};
+
+static inline int weigh(const GeoCell &cell) {
+  return static_cast<int>(cell.type) + cell.is_solid();
+}
+
+template <typename Run>
+static result best_of(Run run) {
+  result best{0, 0};
+
+  for (int i = 0; i < rounds; i++) {
+    result r{0, 0};
+    auto start = clock_type::now();
+
+    r.checksum = run();
+    r.seconds = std::chrono::duration<double>(clock_type::now() - start).count();
+
+    if (i == 0 || r.seconds < best.seconds)
+      best = r;
+  }
+
+  return best;
+}
+
+static void print(const char *name, const result &r, const result &baseline) {
+  std::printf("%-40s %12.3f %8.2fx\n", name, r.seconds * 1000,
+              baseline.seconds / r.seconds);
+
+  if (r.checksum != baseline.checksum)
+    std::fprintf(stderr, "warning: %s: the scans disagree\n", name);
+}
+
+int main(int argc, char **argv) {
+  matrix_t width = 1000, height = 1000;
+
+  if (argc == 3) {
+    width = static_cast<matrix_t>(std::atoi(argv[1]));
+    height = static_cast<matrix_t>(std::atoi(argv[2]));
+  } else if (argc != 1) {
+    std::fprintf(stderr, "usage: %s [width height]\n", argv[0]);
+    return 1;
+  }
+
+  if (width == 0 || height == 0) {
+    std::fprintf(stderr, "the level size cannot be zero\n");
+    return 1;
+  }
+
+  flat_matrix flat(width, height, depth);
+  mr::Matrix<GeoCell> chunked(width, height, depth);
+
+  // The same pseudo-random level in both layouts.
+  unsigned int seed = 1;
+
+  for (matrix_t z = 0; z < depth; z++) {
+    for (matrix_t y = 0; y < height; y++) {
+      for (matrix_t x = 0; x < width; x++) {
+        seed = seed * 1103515245 + 12345;
+
+        GeoCell cell = chunked.get_copy(x, y, z);
+        cell.type = static_cast<GeoType>((seed >> 16) % 10);
+
+        flat.set(x, y, z, cell);
+        chunked.get(x, y, z) = cell;
+      }
+    }
+  }
+
+  std::printf("level: %ux%ux%u, best of %d rounds\n\n", static_cast<unsigned>(width),
+              static_cast<unsigned>(height), static_cast<unsigned>(depth), rounds);
+  std::printf("%-40s %12s %9s\n", "full layer scans", "time (ms)", "speedup");
+
+  const result flat_scan = best_of([&]() {
+    long long sum = 0;
+
+    for (matrix_t z = 0; z < depth; z++)
+      for (matrix_t x = 0; x < width; x++)
+        for (matrix_t y = 0; y < height; y++)
+          sum += weigh(flat.get_copy(x, y, z));
+
+    return sum;
+  });
+
+  const result chunked_get_copy = best_of([&]() {
+    long long sum = 0;
+
+    for (matrix_t z = 0; z < depth; z++)
+      for (matrix_t x = 0; x < width; x++)
+        for (matrix_t y = 0; y < height; y++)
+          sum += weigh(chunked.get_copy(x, y, z));
+
+    return sum;
+  });
+
+  const result chunked_for_each = best_of([&]() {
+    long long sum = 0;
+    const auto view = chunked.view();
+
+    for (matrix_t z = 0; z < depth; z++)
+      view.for_each(z, [&sum](matrix_t, matrix_t, const GeoCell &cell) { sum += weigh(cell); });
+
+    return sum;
+  });
+
+  const result chunked_region_at = best_of([&]() {
+    long long sum = 0;
+    const auto view = chunked.view();
+
+    for (matrix_t z = 0; z < depth; z++)
+      for (matrix_t x = 0; x < width; x++)
+        for (matrix_t y = 0; y < height; y++)
+          sum += weigh(view.at(x, y, z));
+
+    return sum;
+  });
+
+  print("flat get_copy(), x-major (baseline)", flat_scan, flat_scan);
+  print("chunked get_copy(), x-major", chunked_get_copy, flat_scan);
+  print("chunked for_each()", chunked_for_each, flat_scan);
+  print("chunked region at(), x-major", chunked_region_at, flat_scan);
+
+  std::printf("\n%-40s %12s %9s\n", "camera windows", "time (ms)", "speedup");
+
+  const result flat_windows = best_of([&]() {
+    long long sum = 0;
+
+    for (int wy = 0; wy < height; wy += window_height) {
+      for (int wx = 0; wx < width; wx += window_width) {
+        for (matrix_t z = 0; z < depth; z++) {
+          for (int x = wx; x < wx + window_width; x++) {
+            for (int y = wy; y < wy + window_height; y++) {
+              if (!flat.is_in_bounds(x, y, z)) continue;
+              sum += weigh(flat.get_copy(x, y, z));
+            }
+          }
+        }
+      }
+    }
+
+    return sum;
+  });
+
+  const result region_windows = best_of([&]() {
+    long long sum = 0;
+
+    for (int wy = 0; wy < height; wy += window_height) {
+      for (int wx = 0; wx < width; wx += window_width) {
+        const auto region = chunked.region(wx, wy, window_width, window_height);
+
+        for (matrix_t z = 0; z < depth; z++) {
+          for (int x = region.get_x(); x < region.get_x() + region.get_width(); x++) {
+            for (int y = region.get_y(); y < region.get_y() + region.get_height(); y++)
+              sum += weigh(region.at(x, y, z));
+          }
+        }
+      }
+    }
+
+    return sum;
+  });
+
+  print("flat get_copy() (baseline)", flat_windows, flat_windows);
+  print("chunked region at()", region_windows, flat_windows);
+
+  return 0;
+}
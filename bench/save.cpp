@@ -0,0 +1,196 @@
+// Saves a large synthetic level with ser_level(), reads it back with
+// deser_level() and checks that the round trip kept the level.
+//
+// Usage: mobitrenderer_bench_save [width height]
+// Defaults to 500x300 and 1000x1000 levels; the project is written to the
+// temporary directory and removed afterwards.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <MobitRenderer/level.h>
+#include <MobitRenderer/matrix.h>
+#include <MobitRenderer/serialization.h>
+
+using clock_type = std::chrono::steady_clock;
+using mr::GeoCell;
+using mr::GeoFeature;
+using mr::GeoType;
+using mr::Level;
+using mr::matrix_t;
+using mr::TileCell;
+using mr::TileType;
+
+static const char *const materials[] = { "Concrete", "Standard", "Chaotic Stone", "Small Pipes" };
+
+/// @brief Fills the level with a deterministic mix of geometry and
+/// materials, plus a camera per screen.
+static std::unique_ptr<Level> make_level(matrix_t width, matrix_t height) {
+  auto level = std::make_unique<Level>(width, height);
+
+  auto &geo = level->get_geo_matrix();
+  auto &tiles = level->get_tile_matrix();
+
+  unsigned state = 0x2545f491u;
+
+  for (matrix_t z = 0; z < 3; z++) {
+    for (matrix_t y = 0; y < height; y++) {
+      for (matrix_t x = 0; x < width; x++) {
+        state = state * 1664525u + 1013904223u;
+
+        auto type = static_cast<GeoType>((state >> 8) % 8);
+        if (type == GeoType::shortcut_entrance) type = GeoType::solid;
+
+        auto features = (state >> 16) % 4 == 0 ? GeoFeature::vertical_pole : GeoFeature::none;
+
+        geo.set_noexcept(x, y, z, GeoCell(type, features));
+
+        if ((state >> 20) % 3 == 0) {
+          tiles.set_noexcept(x, y, z, TileCell(materials[(state >> 24) % 4], true));
+        }
+      }
+    }
+  }
+
+  level->cameras.clear();
+
+  for (int y = 0; y + 40 <= height; y += 40) {
+    for (int x = 0; x + 70 <= width; x += 70) {
+      level->cameras.emplace_back(Vector2{x * 20.0f, y * 20.0f});
+    }
+  }
+
+  level->water = height / 2;
+  level->front_water = true;
+  level->seed = 4242;
+  level->light_angle = 90;
+  level->light_flatness = 3;
+  level->default_material = "Concrete";
+  level->buffer_geos = mr::BufferGeos(12, 3, 12, 5);
+
+  return level;
+}
+
+static bool same_cells(const Level &a, const Level &b) {
+  const auto &ageo = a.get_const_geo_matrix(), &bgeo = b.get_const_geo_matrix();
+  const auto &atiles = a.get_const_tile_matrix(), &btiles = b.get_const_tile_matrix();
+
+  if (ageo.get_width() != bgeo.get_width() || ageo.get_height() != bgeo.get_height()) return false;
+  if (atiles.get_width() != btiles.get_width() || atiles.get_height() != btiles.get_height()) return false;
+
+  for (matrix_t z = 0; z < 3; z++) {
+    for (matrix_t y = 0; y < ageo.get_height(); y++) {
+      for (matrix_t x = 0; x < ageo.get_width(); x++) {
+        if (ageo.get_const(x, y, z) != bgeo.get_const(x, y, z)) {
+          std::fprintf(stderr, "geometry differs at (%d, %d, %d)\n", x, y, z);
+          return false;
+        }
+
+        const auto &acell = atiles.get_const(x, y, z), &bcell = btiles.get_const(x, y, z);
+
+        if (acell.type != bcell.type || acell.und_name() != bcell.und_name()) {
+          std::fprintf(stderr, "tiles differ at (%d, %d, %d)\n", x, y, z);
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+static bool same_settings(const Level &a, const Level &b) {
+  if (a.cameras.size() != b.cameras.size()) return false;
+
+  for (size_t c = 0; c < a.cameras.size(); c++) {
+    const auto &ap = a.cameras[c].get_position(), &bp = b.cameras[c].get_position();
+    if (ap.x != bp.x || ap.y != bp.y) return false;
+  }
+
+  return a.water == b.water &&
+         a.front_water == b.front_water &&
+         a.light == b.light &&
+         a.terrain == b.terrain &&
+         a.seed == b.seed &&
+         a.light_angle == b.light_angle &&
+         a.light_flatness == b.light_flatness &&
+         a.default_material == b.default_material &&
+         a.buffer_geos.left == b.buffer_geos.left &&
+         a.buffer_geos.top == b.buffer_geos.top &&
+         a.buffer_geos.right == b.buffer_geos.right &&
+         a.buffer_geos.bottom == b.buffer_geos.bottom;
+}
+
+static double seconds_since(clock_type::time_point start) {
+  return std::chrono::duration<double>(clock_type::now() - start).count();
+}
+
+static bool run(matrix_t width, matrix_t height) {
+  auto level = make_level(width, height);
+
+  const auto path = std::filesystem::temp_directory_path() /
+    ("mobitrenderer_bench_save_" + std::to_string(width) + "x" + std::to_string(height) + ".txt");
+
+  auto start = clock_type::now();
+  mr::serde::ser_level(*level, path, nullptr, nullptr);
+  const auto save = seconds_since(start);
+
+  // Saving over the project again also covers carrying its settings over.
+  start = clock_type::now();
+  mr::serde::ser_level(*level, path, nullptr, nullptr);
+  const auto resave = seconds_since(start);
+
+  start = clock_type::now();
+  auto loaded = mr::serde::deser_level(path, false);
+  const auto load = seconds_since(start);
+
+  const auto size = std::filesystem::file_size(path);
+
+  std::error_code ec;
+  std::filesystem::remove(path, ec);
+
+  const bool same = same_cells(*level, *loaded) && same_settings(*level, *loaded);
+
+  std::printf(
+    "%5dx%-5d %8.1f KiB   save %8.3f ms   resave %8.3f ms   load %8.3f ms   %s\n",
+    width,
+    height,
+    size / 1024.0,
+    save * 1000,
+    resave * 1000,
+    load * 1000,
+    same ? "round trip ok" : "ROUND TRIP MISMATCH"
+  );
+
+  return same;
+}
+
+int main(int argc, char *argv[]) {
+  std::vector<std::pair<matrix_t, matrix_t>> sizes;
+
+  if (argc >= 3) {
+    sizes.emplace_back(
+      static_cast<matrix_t>(std::atoi(argv[1])),
+      static_cast<matrix_t>(std::atoi(argv[2]))
+    );
+  } else {
+    sizes = { {500, 300}, {1000, 1000} };
+  }
+
+  bool ok = true;
+
+  try {
+    for (const auto &[width, height] : sizes) ok &= run(width, height);
+  } catch (const std::exception &e) {
+    std::fprintf(stderr, "%s\n", e.what());
+    return 1;
+  }
+
+  return ok ? 0 : 1;
+}
@@ -43,6 +43,9 @@ struct Config {
   int event_handle_per_frame, load_per_frame;
   bool list_wrap, strict_deserialization;
 
+  /// @brief Whether textures keyed for the renderer are cached on disk.
+  bool cache_keyed_textures;
+
   GenericPageConfig default_sprites;
 
   GeoPageConfig geometry;
@@ -11,6 +11,7 @@
 
 #include <MobitRenderer/managed.h>
 #include <MobitRenderer/quad.h>
+#include <MobitRenderer/registry.h>
 #include <MobitRenderer/vec.h>
 
 namespace mr {
@@ -43,20 +44,35 @@ private:
   // const int first_layer_y;
   // const int total_layers;
   const std::unordered_set<std::string> tags;
+  const TagSet tag_set;
   std::filesystem::path texture_path;
   Rectangle _preview_rectangle;
 
+  def_id_t id;
+
   /// Auto-calculated
   const ivec2 head_offset;
 
-  bool _is_texture_loaded;
+  bool _is_texture_loaded, _is_keyed_texture_loaded;
 
-  Texture2D texture;
+  /// @brief Whether the keyed texture was loaded or failed to, so that
+  /// a bad texture is only decoded once.
+  bool _is_keyed_texture_tried;
+
+  Texture2D texture, keyed_texture;
+
+  /// @brief Loads whichever of the two textures is asked for and not
+  /// loaded yet, decoding the image file once.
+  void _load_textures(bool plain, bool keyed);
 
 public:
   inline const std::string &get_name() const noexcept { return name; }
   inline TileDefType get_type() const noexcept { return type; }
 
+  /// @brief The index of the tile in its dex.
+  inline def_id_t get_id() const noexcept { return id; }
+  inline void set_id(def_id_t new_id) noexcept { id = new_id; }
+
   inline const std::string &get_category() const noexcept { return category; }
   inline void set_category(std::string new_category) noexcept { category = new_category; }
 
@@ -84,6 +100,8 @@ public:
   inline const std::vector<int> &get_repeat() const noexcept { return repeat; }
 
   inline const std::unordered_set<std::string> &get_tags() const noexcept { return tags; }
+  inline const TagSet &get_tag_set() const noexcept { return tag_set; }
+  inline bool has_tag(Tag tag) const noexcept { return tag_set.has(tag); }
   inline int get_rnd() const noexcept { return rnd; }
 
   /// @brief Retrieves the rectangle to draw the preview section of the texture.
@@ -93,18 +111,32 @@ public:
   inline const std::filesystem::path &get_texture_path() const noexcept { return texture_path; }
 
   inline bool is_texture_loaded() const noexcept { return _is_texture_loaded; }
-  void load_texture();
+  inline void load_texture() { _load_textures(true, false); }
   void unload_texture();
   inline void reload_texture() { unload_texture(); load_texture(); }
+
+  /// @brief Loads both the texture and the keyed texture, from the same
+  /// decoded image when neither is loaded yet.
+  inline void load_textures() { _load_textures(true, true); }
   
   inline const Texture2D &get_texture() const noexcept { return texture; }
   
   /// @brief Loads the tile texture before accessing the texture.
   inline const Texture2D &get_loaded_texture() {
-    if (!_is_texture_loaded) reload_texture();
+    if (!_is_texture_loaded) load_texture();
     return texture;
   };
 
+  /// @brief Loads only the tile texture with white keyed out (see
+  /// key_white()), to be drawn with BLEND_ALPHA_PREMULTIPLY instead of the
+  /// white remover shader.
+  /// @note Unloaded with the texture. A texture that fails to load is not
+  /// retried until the texture is unloaded.
+  inline void load_keyed_texture() { _load_textures(false, true); }
+
+  inline const Texture2D &get_keyed_texture() const noexcept { return keyed_texture; }
+  inline bool is_keyed_texture_loaded() const noexcept { return _is_keyed_texture_loaded; }
+
   TileDef &operator=(TileDef &&) noexcept = delete;
   TileDef &operator=(const TileDef &) = delete;
 
@@ -149,9 +181,16 @@ protected:
   const Color color;
   const MaterialRenderType type;
 
+  def_id_t id;
+
 public:
 
   inline const std::string &get_name() const noexcept { return name; }
+
+  /// @brief The index of the material in its dex.
+  inline def_id_t get_id() const noexcept { return id; }
+  inline void set_id(def_id_t new_id) noexcept { id = new_id; }
+
   inline const std::string &get_category() const noexcept { return category; }
   inline void set_category(std::string new_category) noexcept { category = new_category; }
   inline Color get_color() const noexcept { return color; }
@@ -350,12 +389,21 @@ protected:
   bool loaded;
   Texture2D texture;
 
+  def_id_t id;
+
 public:
 
   const int depth; // 0 - 29
   const PropType type;
   const std::string name;
   const std::unordered_set<std::string> tags;
+  const TagSet tag_set;
+
+  /// @brief The index of the prop in its dex.
+  inline def_id_t get_id() const noexcept { return id; }
+  inline void set_id(def_id_t new_id) noexcept { id = new_id; }
+
+  inline bool has_tag(Tag tag) const noexcept { return tag_set.has(tag); }
 
   inline const std::string &get_category() const noexcept { return category; }
   inline void set_category(std::string name) noexcept { category = name; }
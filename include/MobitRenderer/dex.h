@@ -10,6 +10,8 @@
 
 #include <MobitRenderer/definitions.h>
 #include <MobitRenderer/castlibs.h>
+#include <MobitRenderer/matrix.h>
+#include <MobitRenderer/registry.h>
 
 namespace mr {
 
@@ -20,19 +22,10 @@ class TileDex {
 
 private:
 
-    std::unordered_map<std::string, TileDef*> _tiles;
+    DefRegistry<TileDef, TileDefCategory> _tiles;
 
-    /// @brief An array of tile categories, in the 
-    /// order they were registered.
-    std::vector<TileDefCategory> _categories;
-
-    /// @brief An array of tiles ordered by registering 
-    /// and grouped by associated category orderer.
-    std::vector<std::vector<TileDef*>> _sorted_tiles; 
-
-    /// @brief A map of category name with associated tiles, 
-    /// that are ordered by registering orderer.
-    std::unordered_map<std::string, std::vector<TileDef*>> _category_tiles;
+    /// Tiles by interned name (see intern_tile_name()), for resolving cells.
+    std::vector<TileDef*> _named;
 
 public:
 
@@ -40,7 +33,19 @@ public:
     /// @return A pointer to the tile if found; otherwise a null pointer is returned.
     TileDef *tile(const std::string&) const noexcept;
 
-    const std::unordered_map<std::string, TileDef*> &tiles() const noexcept;
+    /// @brief Retrieves a tile definition by its ID.
+    /// @return nullptr if the ID is out of range.
+    inline TileDef *tile(def_id_t id) const noexcept { return _tiles.get(id); }
+
+    /// @brief Resolves the tile of a head or a body cell by its name.
+    /// @return nullptr for other cells and for tiles this dex doesn't have.
+    inline TileDef *tile(const TileCell &cell) const noexcept {
+        if (cell.type != TileType::head && cell.type != TileType::body) return nullptr;
+        return cell.name < _named.size() ? _named[cell.name] : nullptr;
+    }
+
+    /// @brief All tiles, indexed by ID.
+    const std::vector<TileDef*> &tiles() const noexcept;
 
     /// @brief An array of tile categories, in the 
     /// order they were registered.
@@ -60,6 +65,19 @@ public:
     /// @attention The path's parent directory must contain the tile textures.
     void register_from(std::filesystem::path const&file, CastLibs const*libs = nullptr);
 
+    /// @brief Registers tiles from several Init text files, in order.
+    /// @note The files' lines are deserialized in parallel, but the tiles
+    /// and categories are registered in the order they're listed.
+    /// @attention Each path's parent directory must contain its tile textures.
+    void register_from(std::vector<std::filesystem::path> const&files, CastLibs const*libs = nullptr);
+
+    /// @brief Appends a category; tiles added afterwards belong to it.
+    void add_category(const TileDefCategory&);
+
+    /// @brief Appends a tile to the latest category and takes ownership of it.
+    /// @note Unlike register_from(), duplicates are not checked for.
+    void add(TileDef*);
+
     /// @brief Unloads all textures of tiles. 
     /// Must be called before CloseWindow().
     void unload_textures();
@@ -84,25 +102,13 @@ class PropDex {
 
 private:
 
-    std::unordered_map<std::string, PropDef*> _props;
-
-    /// @brief An array of prop categories, in the 
-    /// order they were registered.
-    std::vector<PropDefCategory> _categories;
-
-    /// @brief An array of props ordered by registering 
-    /// and grouped by associated category orderer.
-    std::vector<std::vector<PropDef*>> _sorted_props; 
+    DefRegistry<PropDef, PropDefCategory> _props;
 
-    /// @brief A map of category name with associated props, 
-    /// that are ordered by registering orderer.
-    std::unordered_map<std::string, std::vector<PropDef*>> _category_props;
-
-    /// Tiles as props
-    std::unordered_map<std::string, TileDef*> _tiles;
+    /// Tiles as props, referenced from the tile dex.
+    const TileDex *_tile_dex;
+    std::vector<bool> _tile_props;
     std::vector<TileDefCategory> _tile_categories;
     std::vector<std::vector<TileDef*>> _sorted_tiles;
-    std::unordered_map<std::string, std::vector<TileDef*>> _category_tiles;
 
 public:
 
@@ -110,7 +116,12 @@ public:
     /// @return A pointer to the prop if found; otherwise a null pointer is returned.
     PropDef *prop(const std::string&) const noexcept;
 
-    const std::unordered_map<std::string, PropDef*> &props() const noexcept;
+    /// @brief Retrieves a prop definition by its ID.
+    /// @return nullptr if the ID is out of range.
+    inline PropDef *prop(def_id_t id) const noexcept { return _props.get(id); }
+
+    /// @brief All props, indexed by ID.
+    const std::vector<PropDef*> &props() const noexcept;
 
     /// @brief An array of prop categories, in the 
     /// order they were registered.
@@ -124,11 +135,15 @@ public:
     /// that are ordered by registering orderer.
     const std::unordered_map<std::string, std::vector<PropDef*>> &category_props() const noexcept;
 
+    /// @brief Retrieves a tile that can be used as a prop by its name.
+    /// @return A pointer to the tile if found; otherwise a null pointer is returned.
     TileDef *tile(const std::string&) const noexcept;
-    const std::unordered_map<std::string, TileDef*> &tiles() const noexcept;
+
+    /// @return Whether a tile of the registered tile dex can be used as a prop.
+    inline bool is_tile_prop(def_id_t id) const noexcept { return id < _tile_props.size() && _tile_props[id]; }
+
     const std::vector<TileDefCategory> &tile_categories() const noexcept;
     const std::vector<std::vector<TileDef*>> &sorted_tiles() const noexcept;
-    const std::unordered_map<std::string, std::vector<TileDef*>> &category_tiles() const noexcept;
 
     /// @brief Registers props from an Init text file.
     /// @param file The path to the Init.txt file.
@@ -136,7 +151,24 @@ public:
     /// @attention The path's parent directory must contain the prop textures.
     void register_from(std::filesystem::path const&file, CastLibs const*libs = nullptr);
 
+    /// @brief Registers props from several Init text files, in order.
+    /// @note The files' lines are deserialized in parallel, but the props
+    /// and categories are registered in the order they're listed.
+    /// @attention Each path's parent directory must contain its prop textures.
+    void register_from(std::vector<std::filesystem::path> const&files, CastLibs const*libs = nullptr);
+
+    /// @brief Appends a category; props added afterwards belong to it.
+    void add_category(const PropDefCategory&);
+
+    /// @brief Appends a prop to the latest category and takes ownership of it.
+    /// @note Unlike register_from(), duplicates are not checked for.
+    void add(PropDef*);
+
     void register_embedded(const CastLibs*);
+
+    /// @brief Makes the tiles that can be used as props available.
+    /// @note The tiles are referenced, not copied; the tile dex
+    /// must outlive this one, or unload_all() be called first.
     void register_tiles(const TileDex*);
 
     /// @brief Unloads all textures of props. 
@@ -160,31 +192,36 @@ class MaterialDex {
 
 private:
 
-    std::unordered_map<std::string, MaterialDef*> _materials;
-    std::vector<std::string> _categories;
-    std::vector<std::vector<MaterialDef*>> _sorted_materials;
-    std::unordered_map<std::string, std::vector<MaterialDef*>> _category_materials;
+    DefRegistry<MaterialDef, std::string> _materials;
+
+    /// Materials by interned name (see intern_tile_name()), for resolving cells.
+    std::vector<MaterialDef*> _named;
+
+    void _add(MaterialDef*);
 
 public:
 
-    inline MaterialDef *material(std::string const&name) const noexcept {
-        auto def = _materials.find(name);
-        if (def == _materials.end()) return nullptr;
-        return def->second;
-    }
-    inline const std::vector<std::string> &categories() const noexcept { return _categories; }
-    inline const std::vector<std::vector<MaterialDef*>> &sorted_materials() const noexcept { return _sorted_materials; }
-    inline const std::unordered_map<std::string, std::vector<MaterialDef*>> &category_materials() const noexcept { return _category_materials; }
+    inline MaterialDef *material(std::string const&name) const noexcept { return _materials.find(name); }
 
-    inline void unload_all() noexcept {
-        for (auto &m : _materials) delete m.second;
+    /// @return nullptr if the ID is out of range.
+    inline MaterialDef *material(def_id_t id) const noexcept { return _materials.get(id); }
 
-        _materials.clear();
-        _categories.clear();
-        _sorted_materials.clear();
-        _category_materials.clear();
+    /// @brief Resolves the material of a material cell by its name.
+    /// @return nullptr for other cells and for materials this dex doesn't have.
+    inline MaterialDef *material(const TileCell &cell) const noexcept {
+        if (cell.type != TileType::material) return nullptr;
+        return cell.name < _named.size() ? _named[cell.name] : nullptr;
     }
 
+    /// @brief All materials, indexed by ID.
+    inline const std::vector<MaterialDef*> &materials() const noexcept { return _materials.defs(); }
+
+    inline const std::vector<std::string> &categories() const noexcept { return _materials.categories(); }
+    inline const std::vector<std::vector<MaterialDef*>> &sorted_materials() const noexcept { return _materials.sorted(); }
+    inline const std::unordered_map<std::string, std::vector<MaterialDef*>> &category_materials() const noexcept { return _materials.category_defs(); }
+
+    inline void unload_all() noexcept { _materials.clear(); _named.clear(); }
+
     void unload_textures();
 
     /// @brief Loads internal materials.
@@ -200,4 +237,19 @@ public:
 
 };
 
+/// @brief The files of an Init file's directory by lowercase file name,
+/// for resolve_init_texture().
+/// @note Only listed where file names are case-sensitive (Linux and macOS);
+/// elsewhere the map is empty.
+std::unordered_map<std::string, std::filesystem::path> list_init_directory(std::filesystem::path const &directory);
+
+/// @brief The texture of a definition that isn't internal: the PNG named
+/// after it in its Init file's directory, whatever the case of the file.
+/// @param files The directory's listing (see list_init_directory()).
+std::filesystem::path resolve_init_texture(
+    std::filesystem::path const &directory,
+    std::unordered_map<std::string, std::filesystem::path> const &files,
+    std::string const &name
+);
+
 };
\ No newline at end of file
@@ -388,21 +388,25 @@ void draw_geo_and_poles_layer(Matrix<GeoCell> const& matrix, uint8_t layer, Colo
 
 /// @brief Draws an entire layer of a geometry matrix features.
 /// @param matrix A constant reference to the matrix.
+/// @param planes The feature planes of the matrix; only the cells
+/// that have a drawn feature are visited.
 /// @param atlas A constant reference to the textures atlas.
 /// @param color The brush color.
 /// @param scale The size of each cell in pixels.
-void draw_geo_features_layer(Matrix<GeoCell> const &matrix, const GE_Textures &atlas, uint8_t layer, Color color, float scale = 20.0f);
+void draw_geo_features_layer(Matrix<GeoCell> const &matrix, GeoFeaturePlanes const &planes, const GE_Textures &atlas, uint8_t layer, Color color, float scale = 20.0f);
 
 /// @brief Draws cracked terrain
 void draw_geo_cracked(
   Matrix<GeoCell> const &matrix, 
+  GeoFeaturePlanes const &planes,
   GE_Textures &atlas, 
   uint8_t layer,
   Color color, 
   float scale = 20.0f
 );
 
-void draw_geo_entrances(Matrix<GeoCell> const &matrix, GE_Textures &atlas, Color color, float scale = 20.0f);
+/// @brief Draws the shortcut entrances of the first layer.
+void draw_geo_entrances(Matrix<GeoCell> const &matrix, GeoFeaturePlanes const &planes, GE_Textures &atlas, Color color, float scale = 20.0f);
 
 }; // namespace draw
 
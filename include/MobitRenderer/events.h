@@ -11,4 +11,7 @@ void handle_level_loaded(context *, pages::pager *, const std::any &);
 void handle_level_selected(context *, pages::pager *, const std::any &);
 void handle_goto_page(context *, pages::pager *, const std::any &);
 
+/// @brief Writes the selected level back to its project file.
+void handle_save_level(context *, pages::pager *, const std::any &);
+
 }; // namespace mr
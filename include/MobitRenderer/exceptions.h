@@ -33,6 +33,15 @@ public:
   const char *what() const noexcept override;
 };
 
+class serialization_failure : public std::exception {
+private:
+  std::string msg_;
+
+public:
+  explicit serialization_failure(const std::string &);
+  const char *what() const noexcept override;
+};
+
 class dex_error : public std::exception {
 private:
   std::string msg_;
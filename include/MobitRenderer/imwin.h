@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <filesystem>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -11,6 +12,7 @@
 
 #include <MobitRenderer/managed.h>
 #include <MobitRenderer/matrix.h>
+#include <MobitRenderer/serialization.h>
 #include <MobitRenderer/state.h>
 
 namespace mr {
@@ -24,6 +26,11 @@ private:
   std::vector<std::string> entry_names;
   std::vector<bool> entry_is_dir;
 
+  /// Read lazily, the first time an entry is selected or hovered; empty if
+  /// the entry is not a readable level.
+  std::vector<std::optional<serde::LevelMetadata>> entry_metadata;
+  std::vector<bool> entry_metadata_read;
+
   size_t selected_entry, hovered_entry;
 
   size_t path_max_len;
@@ -44,6 +51,8 @@ private:
 
   void go_to(const std::filesystem::path &dir);
 
+  const serde::LevelMetadata *get_metadata(size_t entry) noexcept;
+
   void draw_preview() const noexcept;
   void new_preview(uint16_t width, uint16_t height);
 
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <filesystem>
+
+#include <raylib.h>
+
+namespace mr {
+
+/// @brief Makes pure white (255, 255, 255, 255) transparent, and
+/// premultiplies the remaining pixels by their alpha.
+/// @note The image is converted to R8G8B8A8. A keyed texture drawn with
+/// BLEND_ALPHA_PREMULTIPLY and no shader looks like the original drawn
+/// with the white remover shader.
+void key_white(Image &image);
+
+/// @brief Sets the directory keyed images are cached in.
+/// @param directory An empty path disables caching.
+void set_keyed_image_cache(const std::filesystem::path &directory);
+
+/// @brief Loads an image file, and keys it with key_white().
+/// @param skip_rows The number of rows cropped off the top of the image
+/// before keying it.
+/// @return An image without data if the file could not be loaded.
+/// Otherwise an R8G8B8A8 image to be unloaded with UnloadImage().
+/// @note Uses and fills the cache set by set_keyed_image_cache(), if any.
+Image load_keyed_image(const std::filesystem::path &path, int skip_rows = 0);
+
+}; // namespace mr
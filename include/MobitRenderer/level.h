@@ -183,17 +183,38 @@ struct EffectConfig {
   uint8_t choice_type;
 
   /// @brief If choice_type is 0, then choice is an index to options pointing to
-  /// the choice; otherwise, choice is just a number.
-  uint8_t choice;
+  /// the choice; otherwise, choice is just a number (e.g. a seed).
+  int choice;
+
+  /// @brief A choice that isn't one of the options, as it was read; choice is
+  /// then options.size(). Kept so that saving writes it back unchanged.
+  std::string unlisted_choice;
 };
 
 struct Effect {
   std::string name;
+
+  /// @brief The kind of the effect (#tp), e.g. "nn" or "standardErosion".
+  std::string type;
+
+  bool cross_screen;
+
+  /// @brief Only saved for "standardErosion" effects.
+  int repeats;
+  float affect_open_areas;
+
   std::vector<EffectConfig> config;
-  Matrix<float> matrix;
+  EffectMatrix matrix;
 
   Effect &operator=(const Effect &) noexcept = delete;
+  Effect &operator=(Effect &&) noexcept = default;
+
   Effect(const Effect &) = delete;
+  Effect(Effect &&) noexcept = default;
+
+  /// @param width The width of the level.
+  /// @param height The height of the level.
+  Effect(matrix_t width, matrix_t height);
 };
 
 struct BufferGeos {
@@ -223,6 +244,10 @@ private:
   Matrix<TileCell> tile_matrix;
   std::vector<Effect> effects;
 
+  // Built on first use.
+  mutable GeoFeaturePlanes feature_planes;
+  mutable bool feature_planes_stale;
+
   RenderTexture2D lightmap;
 
 public:
@@ -291,6 +316,24 @@ public:
   const Matrix<TileCell> &get_const_tile_matrix() const;
   const std::vector<Effect> &get_const_effects() const;
 
+  /// @brief A bitplane per feature per layer of the geometry matrix.
+  /// @note Built on first use; edits made through get_geo_matrix() must
+  /// be reported with geo_changed() to keep it current.
+  const GeoFeaturePlanes &get_feature_planes() const;
+
+  /// @brief Updates the feature planes of a box of edited cells.
+  void geo_changed(int x, int y, int z, int width, int height, int depth) noexcept;
+
+  /// @brief Marks the feature planes for rebuilding, after edits
+  /// too broad to report cell by cell.
+  void geo_changed() noexcept;
+
+  /// @brief Grows (positive) or crops (negative) each side of the level,
+  /// shifting the matrices, effects, props, cameras and the lightmap.
+  /// @note Tile bodies whose head was cropped off are cleared.
+  /// @note Requires a GL context if the lightmap is loaded.
+  /// @throws std::invalid_argument if the resulting size is invalid; the
+  /// level is left unchanged.
   void resize(int16_t left, int16_t top, int16_t right, int16_t bottom);
 
   Level() = delete;
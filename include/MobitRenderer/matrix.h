@@ -1,9 +1,12 @@
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #include <MobitRenderer/definitions.h>
@@ -144,31 +147,240 @@ struct GeoCell {
 
 enum class TileType : uint8_t { _default, head, body, material };
 
+/// @brief An interned tile or material name; 0 is the empty name.
+typedef uint32_t tile_name_t;
+
+/// @brief Interns a tile or material name, shared by every level.
+/// @note Thread-safe.
+/// @throws std::length_error if the names are exhausted.
+tile_name_t intern_tile_name(std::string_view);
+
+/// @note The returned view stays valid for the lifetime of the process.
+std::string_view tile_name(tile_name_t) noexcept;
+
+/// @brief A tile matrix cell.
+/// @note Cells only keep the ID of their name; definitions are resolved
+/// through the dexes the level is used with (see TileDex::tile() and
+/// MaterialDex::material()). Body cells carry the name of their head once
+/// the matrix is defined (see define_tile_matrix()).
 struct TileCell {
   TileType type;
 
-  std::string und_name;
-  uint16_t head_pos_x, head_pos_y, head_pos_z;
+  uint8_t head_pos_z;
+  uint16_t head_pos_x, head_pos_y;
 
-  TileDef *tile_def;
-  MaterialDef *material_def;
+  tile_name_t name;
+
+  inline std::string_view und_name() const noexcept { return tile_name(name); }
 
   TileCell();
   TileCell(TileDef *);
   TileCell(uint16_t x, uint16_t y, uint16_t z, TileDef *tile = nullptr);
   TileCell(MaterialDef *);
-  TileCell(std::string name, bool material = false);
+  TileCell(std::string_view name, bool material = false);
 };
 
+static_assert(sizeof(TileCell) <= 12, "TileCell is expected to stay compact");
+
 typedef uint16_t matrix_t;
 
+/// @brief The amounts (0 - 100) of an effect across a level.
+/// @note Amounts are kept in chunks of chunk_size^2 cells that are only
+/// allocated once one of their amounts is non-zero, since most effects
+/// cover a small part of the level.
+class EffectMatrix {
+public:
+  static constexpr matrix_t chunk_size = 16;
+  static constexpr size_t chunk_area = chunk_size * chunk_size;
+  static constexpr uint8_t max_amount = 100;
+
+private:
+  matrix_t width, height;
+
+  /// @brief The number of chunk columns and rows.
+  matrix_t columns, rows;
+
+  /// @brief Row-major; null chunks are all zeros. Cells are 
+  /// row-major within a chunk.
+  std::vector<std::unique_ptr<uint8_t[]>> chunks;
+
+  inline size_t chunk_index(matrix_t x, matrix_t y) const noexcept {
+    return (x / chunk_size) + static_cast<size_t>(y / chunk_size) * columns;
+  }
+
+  static inline size_t cell_index(matrix_t x, matrix_t y) noexcept {
+    return (x % chunk_size) + (y % chunk_size) * chunk_size;
+  }
+
+public:
+  inline matrix_t get_width() const noexcept { return width; }
+  inline matrix_t get_height() const noexcept { return height; }
+
+  inline matrix_t get_chunk_columns() const noexcept { return columns; }
+  inline matrix_t get_chunk_rows() const noexcept { return rows; }
+
+  bool is_in_bounds(int x, int y) const noexcept;
+
+  /// @return The amount, or 0 if out of bounds.
+  uint8_t get(matrix_t x, matrix_t y) const noexcept;
+
+  /// @brief Sets an amount; amounts above max_amount are clamped.
+  /// @throws std::out_of_range if the index is out of bounds.
+  void set(matrix_t x, matrix_t y, uint8_t amount);
+
+  /// @brief The amounts of a chunk, in row-major order.
+  /// @return nullptr if the chunk is all zeros.
+  const uint8_t *get_chunk(size_t index) const noexcept;
+
+  /// @brief The amounts of a chunk, which is allocated if it wasn't.
+  /// @warning Amounts written through it must not exceed max_amount.
+  uint8_t *get_or_allocate_chunk(size_t index);
+
+  /// @return The total number of chunks, allocated or not.
+  inline size_t chunk_count() const noexcept { return chunks.size(); }
+
+  size_t allocated_chunks() const noexcept;
+
+  /// @brief Frees the chunks that have been erased back to all zeros.
+  void shrink() noexcept;
+
+  void clear() noexcept;
+
+  /// @brief Grows (positive) or crops (negative) each side.
+  /// @note Only allocated chunks are visited.
+  void resize(int16_t left, int16_t top, int16_t right, int16_t bottom);
+
+  /// @brief Converts an amount as saved in a project,
+  /// which may be any number, to the stored range.
+  static uint8_t quantize(float amount) noexcept;
+
+  EffectMatrix &operator=(const EffectMatrix &) = delete;
+  EffectMatrix &operator=(EffectMatrix &&) noexcept = default;
+
+  EffectMatrix(const EffectMatrix &) = delete;
+  EffectMatrix(EffectMatrix &&) noexcept = default;
+
+  /// @throws std::invalid_argument if a dimension is zero.
+  EffectMatrix(matrix_t width, matrix_t height);
+};
+
+/// @brief Where the cells of a chunked matrix are stored.
+/// @note Each layer is kept in chunks of chunk_size * chunk_size cells;
+/// chunks are ordered column-major, and so are the cells within a chunk.
+/// A column of a chunk is therefore contiguous, and so are the 16 x 16
+/// neighborhoods most loops work on.
+struct MatrixLayout {
+  static constexpr matrix_t chunk_bits = 4;
+  static constexpr matrix_t chunk_size = 1 << chunk_bits;
+  static constexpr matrix_t chunk_mask = chunk_size - 1;
+  static constexpr size_t chunk_area = size_t(chunk_size) * chunk_size;
+
+  /// @brief The number of chunk rows.
+  matrix_t rows;
+
+  /// @brief The number of cells in a layer, padding included.
+  size_t layer_size;
+
+  inline size_t index(matrix_t x, matrix_t y, matrix_t z) const noexcept {
+    const size_t chunk = static_cast<size_t>(x >> chunk_bits) * rows + (y >> chunk_bits);
+
+    return z * layer_size + 
+      (chunk << (2 * chunk_bits)) +
+      (static_cast<size_t>(x & chunk_mask) << chunk_bits) + 
+      (y & chunk_mask);
+  }
+
+  /// @brief The number of chunks needed to cover a length.
+  static inline matrix_t chunks(matrix_t length) noexcept {
+    return static_cast<matrix_t>((length + chunk_mask) >> chunk_bits);
+  }
+};
+
+/// @brief A rectangular part of a matrix, clipped to its bounds.
+/// @note Accessors skip the bounds checks; the view is invalidated when
+/// the matrix is resized or moved.
+/// @tparam T The cell type; const for read-only views.
+template <typename T> class MatrixRegion {
+private:
+  T *_cells;
+  MatrixLayout _layout;
+  matrix_t _x, _y, _width, _height;
+
+public:
+  inline matrix_t get_x() const noexcept { return _x; }
+  inline matrix_t get_y() const noexcept { return _y; }
+  inline matrix_t get_width() const noexcept { return _width; }
+  inline matrix_t get_height() const noexcept { return _height; }
+
+  inline bool empty() const noexcept { return _width == 0 || _height == 0; }
+
+  /// @param x, y Matrix coordinates, which must be inside the region.
+  inline T &at(matrix_t x, matrix_t y, matrix_t z) const noexcept {
+    return _cells[_layout.index(x, y, z)];
+  }
+
+  /// @brief Visits every cell of a layer in storage order: chunk by chunk,
+  /// then column by column.
+  /// @param f Called as f(x, y, cell) with matrix coordinates.
+  template <typename F> void for_each(matrix_t z, F &&f) const {
+    if (empty()) return;
+
+    const int x_end = _x + _width, y_end = _y + _height;
+
+    for (int cx = _x >> MatrixLayout::chunk_bits; cx << MatrixLayout::chunk_bits < x_end; cx++) {
+      const int x0 = std::max<int>(_x, cx << MatrixLayout::chunk_bits);
+      const int x1 = std::min<int>(x_end, (cx + 1) << MatrixLayout::chunk_bits);
+
+      for (int cy = _y >> MatrixLayout::chunk_bits; cy << MatrixLayout::chunk_bits < y_end; cy++) {
+        const int y0 = std::max<int>(_y, cy << MatrixLayout::chunk_bits);
+        const int y1 = std::min<int>(y_end, (cy + 1) << MatrixLayout::chunk_bits);
+
+        for (int x = x0; x < x1; x++) {
+          T *cell = _cells + _layout.index(x, y0, z);
+
+          for (int y = y0; y < y1; y++, cell++) 
+            f(static_cast<matrix_t>(x), static_cast<matrix_t>(y), *cell);
+        }
+      }
+    }
+  }
+
+  /// @brief Visits every cell of a layer column by column, top to bottom,
+  /// for loops whose results depend on the order.
+  /// @param f Called as f(x, y, cell) with matrix coordinates.
+  template <typename F> void for_each_in_columns(matrix_t z, F &&f) const {
+    if (empty()) return;
+
+    const int x_end = _x + _width, y_end = _y + _height;
+
+    for (int x = _x; x < x_end; x++) {
+      for (int y = _y; y < y_end;) {
+        // Contiguous up to the end of the chunk.
+        const int segment_end = std::min<int>(y_end, (y | MatrixLayout::chunk_mask) + 1);
+        T *cell = _cells + _layout.index(x, y, z);
+
+        for (; y < segment_end; y++, cell++) 
+          f(static_cast<matrix_t>(x), static_cast<matrix_t>(y), *cell);
+      }
+    }
+  }
+
+  MatrixRegion(T *cells, MatrixLayout layout, matrix_t x, matrix_t y, matrix_t width, matrix_t height) noexcept
+    : _cells(cells), _layout(layout), _x(x), _y(y), _width(width), _height(height) {}
+};
+
 template <typename T> class Matrix {
 private:
   std::vector<T>
       matrix; // Might change it to a shared pointer (shared_ptr<vector<T>>)
   matrix_t width, height, depth;
 
-  uint64_t index(matrix_t x, matrix_t y, matrix_t z) const;
+  MatrixLayout layout;
+
+  inline size_t index(matrix_t x, matrix_t y, matrix_t z) const noexcept { return layout.index(x, y, z); }
+
+  /// @brief Clips a rectangle to the matrix.
+  void clip(int &x, int &y, int &w, int &h) const noexcept;
 
 public:
   matrix_t get_width() const;
@@ -192,7 +404,31 @@ public:
   void set(matrix_t x, matrix_t y, matrix_t z, T&& element);
   void set_noexcept(matrix_t x, matrix_t y, matrix_t z, const T &element) noexcept;
   void set_noexcept(matrix_t x, matrix_t y, matrix_t z, T &&element) noexcept;
-  
+
+  /// @brief A view of a rectangle, clipped to the matrix (and possibly empty).
+  MatrixRegion<T> region(int x, int y, int width, int height) noexcept;
+  MatrixRegion<const T> region(int x, int y, int width, int height) const noexcept;
+
+  /// @brief A view of the whole matrix.
+  MatrixRegion<T> view() noexcept;
+  MatrixRegion<const T> view() const noexcept;
+
+  /// @brief How cells are placed in the backing storage.
+  inline const MatrixLayout &get_layout() const noexcept { return layout; }
+
+  /// @brief The backing storage, padding cells included, in layout order.
+  /// @note Padding cells are default-constructed and never read by the
+  /// accessors; they're only exposed for whole-matrix copies.
+  inline T *data() noexcept { return matrix.data(); }
+  inline const T *data() const noexcept { return matrix.data(); }
+
+  /// @brief The number of cells in the backing storage, padding included.
+  inline size_t storage_size() const noexcept { return matrix.size(); }
+
+  /// @brief Grows (positive) or crops (negative) each side, moving the
+  /// kept cells in a single pass; new cells are default-constructed.
+  /// @throws std::invalid_argument if a resulting dimension is zero, 
+  /// negative or too large.
   void resize(int16_t left, int16_t top, int16_t right, int16_t bottom);
 
   Matrix<T> &operator=(const Matrix<T> &) = delete;
@@ -209,11 +445,6 @@ public:
   ~Matrix();
 };
 
-template <typename T>
-uint64_t Matrix<T>::index(matrix_t x, matrix_t y, matrix_t z) const {
-  return x + (y * width) + (z * width * height);
-}
-
 template <typename T>
 Matrix<T>::Matrix(matrix_t _width, matrix_t _height, matrix_t _depth) {
   if (_width == 0 || _height == 0 || _depth == 0)
@@ -223,26 +454,34 @@ Matrix<T>::Matrix(matrix_t _width, matrix_t _height, matrix_t _depth) {
   height = _height;
   depth = _depth;
 
-  matrix.resize(width * height * depth);
+  const matrix_t rows = MatrixLayout::chunks(height);
+
+  // The last chunks are padded.
+  layout = MatrixLayout{ 
+    rows, 
+    static_cast<size_t>(MatrixLayout::chunks(width)) * rows * MatrixLayout::chunk_area 
+  };
 
-  std::fill(matrix.begin(), matrix.end(), T());
+  matrix.resize(layout.layer_size * depth);
 }
 
 template <typename T>
-Matrix<T>::Matrix(Matrix<T> &&m) : width(0), height(0), depth(0) {
+Matrix<T>::Matrix(Matrix<T> &&m) : width(0), height(0), depth(0), layout{0, 0} {
   matrix = std::move(m.matrix);
 
   width = m.width;
   height = m.height;
   depth = m.depth;
+  layout = m.layout;
 
   m.width = 0;
   m.height = 0;
   m.depth = 0;
+  m.layout = MatrixLayout{0, 0};
 }
 
 template <typename T> Matrix<T> &Matrix<T>::operator=(Matrix<T> &&other) {
-  if (this == other)
+  if (this == &other)
     return *this;
 
   matrix = std::move(other.matrix);
@@ -250,14 +489,45 @@ template <typename T> Matrix<T> &Matrix<T>::operator=(Matrix<T> &&other) {
   width = other.width;
   height = other.height;
   depth = other.depth;
+  layout = other.layout;
 
   other.width = 0;
   other.height = 0;
   other.depth = 0;
+  other.layout = MatrixLayout{0, 0};
 
   return *this;
 }
 
+template <typename T>
+void Matrix<T>::clip(int &x, int &y, int &w, int &h) const noexcept {
+  if (x < 0) { w += x; x = 0; }
+  if (y < 0) { h += y; y = 0; }
+
+  if (w > width - x) w = width - x;
+  if (h > height - y) h = height - y;
+
+  if (w < 0 || h < 0) w = h = 0;
+}
+
+template <typename T>
+MatrixRegion<T> Matrix<T>::region(int x, int y, int w, int h) noexcept {
+  clip(x, y, w, h);
+  return MatrixRegion<T>(matrix.data(), layout, x, y, w, h);
+}
+
+template <typename T>
+MatrixRegion<const T> Matrix<T>::region(int x, int y, int w, int h) const noexcept {
+  clip(x, y, w, h);
+  return MatrixRegion<const T>(matrix.data(), layout, x, y, w, h);
+}
+
+template <typename T>
+MatrixRegion<T> Matrix<T>::view() noexcept { return region(0, 0, width, height); }
+
+template <typename T>
+MatrixRegion<const T> Matrix<T>::view() const noexcept { return region(0, 0, width, height); }
+
 template <typename T> Matrix<T>::~Matrix() {}
 
 template <typename T> matrix_t Matrix<T>::get_width() const { return width; }
@@ -352,36 +622,153 @@ void Matrix<T>::resize(int16_t left, int16_t top, int16_t right,
                        int16_t bottom) {
   if (left == 0 && top == 0 && right == 0 && bottom == 0)
     return;
-  if (-left == width || -right == width || -top == height || -bottom == height)
-    return;
 
-  matrix_t new_width = width + left + right;
-  matrix_t new_height = height + top + bottom;
+  const int new_width = width + left + right;
+  const int new_height = height + top + bottom;
 
-  std::vector<T> new_matrix{};
+  if (new_width <= 0 || new_height <= 0)
+    throw std::invalid_argument("matrix dimensions cannot be zero");
 
-  new_matrix.reserve(new_width * new_height * depth);
+  if (new_width > UINT16_MAX || new_height > UINT16_MAX)
+    throw std::invalid_argument("matrix dimensions are too large");
 
-  // Copy over
+  Matrix<T> resized(
+    static_cast<matrix_t>(new_width), 
+    static_cast<matrix_t>(new_height), 
+    depth
+  );
+
+  // The part that's kept, in the old coordinates.
+  const int x0 = std::max(0, -static_cast<int>(left));
+  const int y0 = std::max(0, -static_cast<int>(top));
+  const int x1 = std::min<int>(width, new_width - left);
+  const int y1 = std::min<int>(height, new_height - top);
 
-  for (matrix_t x = 0; x < width; x++) {
-    matrix_t new_x = x + left;
+  // Columns are moved in runs that stay within a chunk on both sides,
+  // so every cell is visited once.
+  for (matrix_t z = 0; z < depth; z++) {
+    for (int x = x0; x < x1; x++) {
+      for (int y = y0; y < y1;) {
+        const int new_y = y + top;
 
-    if (new_x < 0 || new_x >= new_width)
-      break;
+        const int run = std::min({
+          y1 - y,
+          MatrixLayout::chunk_size - (y & MatrixLayout::chunk_mask),
+          MatrixLayout::chunk_size - (new_y & MatrixLayout::chunk_mask)
+        });
 
-    for (matrix_t y = 0; y < height; y++) {
-      matrix_t new_y = y + top;
+        T *from = &matrix[index(x, y, z)];
+        T *to = &resized.matrix[resized.index(x + left, new_y, z)];
 
-      if (new_y < 0 || new_y >= new_height)
-        break;
+        std::move(from, from + run, to);
 
-      for (matrix_t z = 0; z < depth; z++) {
-        new_matrix[index(new_x, new_y, z)] = matrix[index(x, y, z)];
+        y += run;
       }
     }
   }
 
-  matrix = std::move(new_matrix);
+  *this = std::move(resized);
+}
+
+/// @brief A bit per cell for every feature of every layer of a geometry
+/// matrix, so that feature scans and counts test 64 cells at a time.
+/// @note The planes don't follow the matrix; edits must be reported with
+/// update(), or the planes rebuilt.
+class GeoFeaturePlanes {
+public:
+  static constexpr uint8_t feature_count = 16;
+  static constexpr matrix_t layers = 3;
+  static constexpr matrix_t word_bits = 64;
+
+private:
+  matrix_t width, height;
+
+  /// @brief The number of words in a row; the padding bits stay clear.
+  size_t row_words;
+
+  /// @brief Ordered by layer, then feature, then row.
+  std::vector<uint64_t> words;
+
+  inline size_t row_index(uint8_t feature, matrix_t y, matrix_t z) const noexcept {
+    return ((static_cast<size_t>(z) * feature_count + feature) * height + y) * row_words;
+  }
+
+  static uint8_t lowest_bit(uint64_t bits) noexcept;
+
+public:
+  inline matrix_t get_width() const noexcept { return width; }
+  inline matrix_t get_height() const noexcept { return height; }
+
+  /// @brief The index of a plane; features must be a single flag.
+  static uint8_t feature_index(GeoFeature feature) noexcept;
+
+  /// @return Whether the cell has the feature, or false if out of bounds.
+  bool test(GeoFeature feature, int x, int y, int z) const noexcept;
+
+  /// @return The number of cells of a layer that have the feature.
+  size_t count(GeoFeature feature, matrix_t z) const noexcept;
+
+  /// @return Whether any cell of a layer has any of the features.
+  bool any(GeoFeature features, matrix_t z) const noexcept;
+
+  /// @brief Calls f(x, y) for each cell of a rectangle of a layer that
+  /// has any of the features, in row-major order.
+  /// @note The rectangle is clipped to the planes.
+  template <typename F> void for_each(GeoFeature features, matrix_t z, int x, int y, int width, int height, F &&f) const;
+
+  /// @brief Calls f(x, y) for each cell of a layer that has any of the
+  /// features, in row-major order.
+  template <typename F> inline void for_each(GeoFeature features, matrix_t z, F &&f) const {
+    for_each(features, z, 0, 0, width, height, std::forward<F>(f));
+  }
+
+  /// @brief Resizes the planes to the matrix and sets every bit from it.
+  void rebuild(const Matrix<GeoCell> &matrix);
+
+  /// @brief Resets the bits of a box of cells from the matrix.
+  /// @note The box is clipped to the planes.
+  void update(const Matrix<GeoCell> &matrix, int x, int y, int z, int width, int height, int depth) noexcept;
+
+  GeoFeaturePlanes();
+};
+
+template <typename F>
+void GeoFeaturePlanes::for_each(GeoFeature features, matrix_t z, int x, int y, int w, int h, F &&f) const {
+  if (z >= layers || words.empty()) return;
+
+  const int x0 = std::max(x, 0), x1 = std::min(x + w, static_cast<int>(width));
+  const int y0 = std::max(y, 0), y1 = std::min(y + h, static_cast<int>(height));
+
+  if (x0 >= x1 || y0 >= y1) return;
+
+  uint8_t planes[feature_count];
+  uint8_t plane_count = 0;
+
+  for (uint8_t p = 0; p < feature_count; p++) {
+    if (static_cast<uint16_t>(features) & (1u << p)) planes[plane_count++] = p;
+  }
+
+  if (plane_count == 0) return;
+
+  const size_t first_word = x0 / word_bits, last_word = (x1 - 1) / word_bits;
+
+  // Masks off the columns outside of the rectangle.
+  const uint64_t first_mask = ~uint64_t(0) << (x0 % word_bits);
+  const uint64_t last_mask = ~uint64_t(0) >> (word_bits - 1 - (x1 - 1) % word_bits);
+
+  for (int cy = y0; cy < y1; cy++) {
+    for (size_t word = first_word; word <= last_word; word++) {
+      uint64_t bits = 0;
+
+      for (uint8_t p = 0; p < plane_count; p++) bits |= words[row_index(planes[p], cy, z) + word];
+
+      if (word == first_word) bits &= first_mask;
+      if (word == last_word) bits &= last_mask;
+
+      for (; bits != 0; bits &= bits - 1) {
+        f(static_cast<matrix_t>(word * word_bits + lowest_bit(bits)), static_cast<matrix_t>(cy));
+      }
+    }
+  }
 }
 }; // namespace mr
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace mr {
+
+/// @brief A dense index of a definition within its dex.
+typedef uint32_t def_id_t;
+
+/// @brief The ID of a definition that was never registered.
+constexpr def_id_t no_def_id = UINT32_MAX;
+
+/// @brief A tag interned to a single bit of a TagSet.
+/// @note A default-constructed tag is never set.
+struct Tag {
+  uint8_t word;
+  uint64_t mask;
+
+  inline constexpr bool is_valid() const noexcept { return mask != 0; }
+
+  constexpr Tag() : word(0), mask(0) {}
+  constexpr explicit Tag(size_t index) : word(static_cast<uint8_t>(index / 64)), mask(uint64_t(1) << (index % 64)) {}
+};
+
+/// @brief The tags of a definition, one bit per interned tag.
+/// @note Tags interned past the capacity are only kept as strings.
+class TagSet {
+public:
+  static constexpr size_t capacity = 128;
+
+private:
+  uint64_t _words[capacity / 64];
+
+public:
+  inline bool has(Tag tag) const noexcept { return (_words[tag.word] & tag.mask) != 0; }
+  inline void add(Tag tag) noexcept { _words[tag.word] |= tag.mask; }
+
+  /// @brief Interns every tag of a set.
+  static TagSet of(const std::unordered_set<std::string> &tags);
+
+  constexpr TagSet() : _words{} {}
+};
+
+/// @brief Interns a tag process-wide.
+/// @return An invalid tag if the capacity of TagSet is exhausted.
+/// @note Thread-safe.
+Tag intern_tag(std::string_view name);
+
+/// @brief The tags tested by the renderer, interned up front.
+namespace tags {
+
+constexpr Tag internal(0);
+constexpr Tag colored(1);
+constexpr Tag effect_color_a(2);
+constexpr Tag effect_color_b(3);
+constexpr Tag not_trash_prop(4);
+constexpr Tag not_prop(5);
+constexpr Tag custom_color(6);
+
+}; // namespace tags
+
+inline const std::string &category_name(const std::string &category) noexcept { return category; }
+template <typename Category> inline const std::string &category_name(const Category &category) noexcept { return category.name; }
+
+/// @brief Owns the definitions of one kind, indexed by dense IDs in the
+/// order they were registered; names are only looked up at the edges.
+/// @tparam Def Must provide set_id(def_id_t).
+/// @tparam Category Either a name, or a struct with one.
+template <typename Def, typename Category> class DefRegistry {
+private:
+  std::vector<Def*> _defs;
+  std::unordered_map<std::string, def_id_t> _ids;
+
+  std::vector<Category> _categories;
+  std::vector<std::vector<Def*>> _sorted;
+  std::unordered_map<std::string, std::vector<Def*>> _category_defs;
+
+public:
+  /// @return nullptr if the ID is out of range.
+  inline Def *get(def_id_t id) const noexcept { return id < _defs.size() ? _defs[id] : nullptr; }
+
+  /// @return no_def_id if the name was never registered.
+  inline def_id_t id_of(const std::string &name) const noexcept {
+    const auto found = _ids.find(name);
+    return found == _ids.end() ? no_def_id : found->second;
+  }
+
+  inline Def *find(const std::string &name) const noexcept { return get(id_of(name)); }
+
+  inline size_t size() const noexcept { return _defs.size(); }
+
+  /// @brief Every definition, by ID.
+  inline const std::vector<Def*> &defs() const noexcept { return _defs; }
+
+  inline const std::vector<Category> &categories() const noexcept { return _categories; }
+  inline const std::vector<std::vector<Def*>> &sorted() const noexcept { return _sorted; }
+  inline const std::unordered_map<std::string, std::vector<Def*>> &category_defs() const noexcept { return _category_defs; }
+
+  /// @brief Appends a category; definitions added afterwards belong to it.
+  void add_category(const Category &category) {
+    _categories.push_back(category);
+    _category_defs[category_name(category)] = std::vector<Def*>();
+    _sorted.push_back(std::vector<Def*>());
+  }
+
+  /// @brief Appends a definition to the latest category and takes ownership of it.
+  /// @note A later definition with the same name takes over the name.
+  /// @return The ID assigned to it.
+  def_id_t add(Def *def, const std::string &name) {
+    const auto id = static_cast<def_id_t>(_defs.size());
+
+    def->set_id(id);
+
+    _defs.push_back(def);
+    _ids[name] = id;
+    _sorted.back().push_back(def);
+    _category_defs[category_name(_categories.back())].push_back(def);
+
+    return id;
+  }
+
+  /// @brief Deletes every definition.
+  void clear() noexcept {
+    for (auto *def : _defs) delete def;
+
+    _defs.clear();
+    _ids.clear();
+    _categories.clear();
+    _sorted.clear();
+    _category_defs.clear();
+  }
+
+  DefRegistry &operator=(const DefRegistry &) = delete;
+  DefRegistry(const DefRegistry &) = delete;
+
+  DefRegistry() = default;
+  ~DefRegistry() { clear(); }
+};
+
+}; // namespace mr
@@ -20,6 +20,8 @@
 #include <MobitRenderer/state.h>
 #include <MobitRenderer/matrix.h>
 #include <MobitRenderer/definitions.h>
+#include <MobitRenderer/texture_atlas.h>
+#include <MobitRenderer/renderer/commands.h>
 
 namespace mr::renderer {
 
@@ -130,6 +132,92 @@ struct Render_MaterialCell {
     {}
 };
 
+/// @brief A unified material resolved once per render, so that
+/// drawing its cells involves no name comparisons or lookups.
+struct Render_UnifiedMaterial {
+    /// @brief Whether a cell of the render uses the material.
+    bool used;
+
+    /// @brief Whether solid cells are first covered by the
+    /// "<name>Texture" cast member.
+    bool textured;
+
+    CastMember *texture_member, *tileset_member;
+
+    /// @brief Only valid once the members are loaded.
+    Texture2D texture, tileset;
+
+    /// @brief Where the tileset starts within the tileset texture,
+    /// which is an atlas page if it was packed.
+    Vector2 tileset_origin;
+
+    /// @brief Whether the tileset is keyed (see key_white()), and so
+    /// drawn without the white remover shader.
+    bool tileset_keyed;
+
+    Render_UnifiedMaterial() :
+        used(false),
+        textured(false),
+        texture_member(nullptr),
+        tileset_member(nullptr),
+        texture({0}),
+        tileset({0}),
+        tileset_origin({0, 0}),
+        tileset_keyed(false)
+    {}
+};
+
+/// @brief For every cell of a level, which of its eight neighbours are
+/// solid or sloped cells of the same material, one bit per neighbour.
+/// @note Cells without a material have no neighbours.
+class MaterialNeighbours {
+public:
+
+    static const uint8_t left         = 0b10000000;
+    static const uint8_t top          = 0b01000000;
+    static const uint8_t right        = 0b00100000;
+    static const uint8_t bottom       = 0b00010000;
+    static const uint8_t top_left     = 0b00001000;
+    static const uint8_t top_right    = 0b00000100;
+    static const uint8_t bottom_right = 0b00000010;
+    static const uint8_t bottom_left  = 0b00000001;
+
+    /// @brief The bit of the neighbour at an offset.
+    /// @param dx, dy Between -1 and 1 each.
+    inline static uint8_t bit(int dx, int dy) noexcept {
+        static const uint8_t bits[3][3] = {
+            { top_left,    top,    top_right    },
+            { left,        0,      right        },
+            { bottom_left, bottom, bottom_right }
+        };
+
+        return bits[dy + 1][dx + 1];
+    }
+
+private:
+
+    matrix_t _width, _height, _depth;
+    std::vector<uint8_t> _masks;
+
+    inline size_t _index(matrix_t x, matrix_t y, matrix_t z) const noexcept {
+        return (static_cast<size_t>(z) * _height + y) * _width + x;
+    }
+
+public:
+
+    /// @return 0 if the cell is out of bounds.
+    inline uint8_t at(int x, int y, int z) const noexcept {
+        if (x < 0 || x >= _width || y < 0 || y >= _height || z < 0 || z >= _depth) return 0;
+        return _masks[_index(x, y, z)];
+    }
+
+    /// @brief Computes the neighbours of every cell, splitting the rows
+    /// between threads.
+    void build(const Level &level, const MaterialDex &materials);
+
+    MaterialNeighbours();
+};
+
 struct Render_ShortcutPath {
     const matrix_t x, y, z;
 };
@@ -285,6 +373,10 @@ protected:
 
     RandomGen _rand;
 
+    /// @brief Defers the draws of a layer so that each render target is
+    /// bound once per flush instead of once per draw.
+    DrawRecorder _commands;
+
     bool _initialized, _cleaned_up;
 
     bool 
@@ -350,6 +442,25 @@ protected:
 
     std::vector<std::queue<Render_ShortcutPath>> _shortcuts;
 
+    MaterialNeighbours _material_neighbours;
+
+    /// @brief Indexed by material ID.
+    std::vector<Render_UnifiedMaterial> _unified_materials;
+    bool _unified_materials_loaded;
+
+    /// @brief The tilesets of the unified materials, keyed and packed
+    /// together so that their draws can be batched without a shader.
+    TextureAtlas _unified_atlas;
+
+    /// @brief Resolves the cast members of every unified material
+    /// used by _materials_to_render.
+    /// @note Does not load textures, so it can run on the preparation thread.
+    void _plan_unified_materials();
+
+    /// @brief Loads the textures of the planned unified materials.
+    /// @attention Requires OpenGL context.
+    void _load_unified_materials();
+
     std::vector<TileDef *> _random_machines;
     
     bool _is_material(int x, int y, int z);
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <raylib.h>
+
+#include <MobitRenderer/quad.h>
+
+namespace mr::renderer {
+
+/// @brief Records textured draws per render target, and replays each
+/// target's draws with a single framebuffer bind.
+/// @note Draws to the same target keep their order, and consecutive draws
+/// sharing a shader and a texture are batched together, so the result is
+/// the same as drawing them right away. Draws to different targets may be
+/// reordered, so a recorded draw must never sample another recorded target.
+class DrawRecorder {
+public:
+
+    /// @brief The uniforms of the inverse-bilinear shader.
+    struct QuadUniforms {
+        int vertices_loc, tex_coord_loc;
+        Vector2 vertices[4];
+        float tex_coord[4];
+    };
+
+private:
+
+    enum class command_type : uint8_t { texture, darkest, keyed, quad };
+
+    struct command {
+        command_type type;
+
+        /// @brief Ignored if the shader ID is 0.
+        Shader shader;
+        int texture_loc;
+
+        Texture2D texture;
+        Rectangle source, destination;
+
+        /// @brief An index into _quads.
+        size_t quad;
+    };
+
+    struct quad_command {
+        Quad quad;
+        QuadUniforms uniforms;
+    };
+
+    struct bucket {
+        RenderTexture2D target;
+        std::vector<command> commands;
+    };
+
+    /// @brief In order of first use; emptied buckets are kept for reuse.
+    std::vector<bucket> _buckets;
+
+    /// @brief Buckets by framebuffer ID.
+    std::unordered_map<unsigned int, size_t> _bucket_indices;
+
+    std::vector<quad_command> _quads;
+
+    size_t _size;
+
+    bucket &_bucket(const RenderTexture2D &target);
+
+public:
+
+    /// @brief Records DrawTexturePro() with no origin, rotation or tint.
+    /// @param shader The shader to draw with; its texture_loc uniform is
+    /// set to the texture. A shader ID of 0 draws without one.
+    void draw(
+        const RenderTexture2D &target,
+        const Shader &shader,
+        int texture_loc,
+        const Texture2D &texture,
+        Rectangle source,
+        Rectangle destination
+    );
+
+    /// @brief Records sdraw::draw_texture_darkest().
+    void draw_darkest(
+        const RenderTexture2D &target,
+        const Texture2D &texture,
+        Rectangle source,
+        Rectangle destination
+    );
+
+    /// @brief Records DrawTexturePro() of a keyed texture (see key_white())
+    /// with BLEND_ALPHA_PREMULTIPLY and no shader.
+    /// @note Consecutive keyed draws are batched by rlgl even across
+    /// textures, as no shader uniform has to be set between them.
+    void draw_keyed(
+        const RenderTexture2D &target,
+        const Texture2D &texture,
+        Rectangle source,
+        Rectangle destination
+    );
+
+    /// @brief Records draw::draw_texture() over a quad, with the
+    /// inverse-bilinear shader's uniforms.
+    void draw_quad(
+        const RenderTexture2D &target,
+        const Shader &shader,
+        int texture_loc,
+        const Texture2D &texture,
+        const Quad &quad,
+        const QuadUniforms &uniforms
+    );
+
+    /// @return The number of draws not flushed yet.
+    inline size_t size() const noexcept { return _size; }
+
+    /// @brief Draws and forgets every recorded draw.
+    /// @attention Requires OpenGL context, and must not be
+    /// called within a texture mode.
+    void flush();
+
+    /// @brief Forgets every recorded draw without drawing it.
+    void clear() noexcept;
+
+    DrawRecorder &operator=(DrawRecorder const&) = delete;
+
+    DrawRecorder();
+    DrawRecorder(DrawRecorder const&) = delete;
+};
+
+};
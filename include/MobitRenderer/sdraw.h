@@ -27,8 +27,12 @@ void draw_texture_darkest(
 ) noexcept;
 
 /// @brief Draws an entire layer of a tile matrix (previews)
+/// @param tiles The dex the matrix' tile cells are resolved through.
+/// @param materials The dex the matrix' material cells are resolved through.
 void draw_tile_prevs_layer(
     const shaders* _shaders,
+    const TileDex *tiles,
+    const MaterialDex *materials,
     Matrix<GeoCell> const &geomtx, 
     Matrix<TileCell> const &tilemtx, 
     uint8_t layer,
@@ -3,7 +3,9 @@
 #include <cstdint>
 #include <filesystem>
 #include <memory>
+#include <ostream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_set>
 
@@ -14,6 +16,8 @@
 #include <toml++/impl/parse_error.hpp>
 #include <toml++/impl/parser.hpp>
 
+#include <MobitParser/events.h>
+#include <MobitParser/mapping.h>
 #include <MobitParser/nodes.h>
 
 #include <MobitRenderer/definitions.h>
@@ -47,17 +51,83 @@ struct ProjectSaveFileNodes {
   std::unique_ptr<mp::Node> props;
 };
 
+/// @brief Non-owning views of the lines of a memory-mapped project file.
+/// @note The views are only valid for as long as the file is.
+struct ProjectSaveFileViews {
+  std::unique_ptr<mp::mapped_file> file;
+
+  std::string_view geometry;
+  std::string_view tiles;
+  std::string_view effects;
+  std::string_view light_settings;
+  std::string_view terrain_settings;
+  std::string_view seed_and_sizes;
+  std::string_view cameras;
+  std::string_view water;
+  std::string_view props;
+};
+
+// Diagnostics
+
+/// @brief A problem found while deserializing leniently.
+struct Diagnostic {
+  /// @brief The part of the project, e.g. "geometry", "tiles" or "props".
+  std::string path;
+
+  /// @brief The matrix cell, or the list element in x;
+  /// coordinates that don't apply are -1.
+  int x, y, z;
+
+  std::string message;
+};
+
+std::ostream &operator<<(std::ostream&, const Diagnostic&);
+
+/// @brief Collects the problems found by a lenient deserialization, which
+/// substitutes defaults for malformed values instead of throwing.
+/// @note Not synchronized; concurrent stages report to their own
+/// collectors, which are appended in order afterwards.
+class Diagnostics {
+  std::vector<Diagnostic> _entries;
+
+public:
+  inline const std::vector<Diagnostic> &entries() const noexcept { return _entries; }
+  inline bool empty() const noexcept { return _entries.empty(); }
+  inline size_t size() const noexcept { return _entries.size(); }
+
+  void report(std::string path, int x, int y, int z, std::string message);
+  void report(std::string path, std::string message);
+
+  /// @brief Moves the other collector's entries after this one's.
+  void append(Diagnostics &&);
+};
+
 // Save file parsers
 
 std::unique_ptr<ProjectSaveFileLines> read_project(const std::filesystem::path &);
+
+/// @brief Maps the project file into memory and locates its lines without
+/// copying them.
+std::unique_ptr<ProjectSaveFileViews> map_project(const std::filesystem::path &);
+
 std::unique_ptr<ProjectSaveFileNodes> parse_project(const std::unique_ptr<ProjectSaveFileLines> &);
+
+/// @brief Maps and parses a project file, parsing large lines in parallel.
 std::unique_ptr<ProjectSaveFileNodes> parse_project(const std::filesystem::path &);
 
+/// @param matrices When false, the geometry and tiles lines are left 
+/// unparsed (null) so they can be streamed through mp::event_reader instead.
+/// @param parallel When true, large lines (geometry, tiles, props) are 
+/// tokenized and parsed concurrently. The result, and the error thrown on 
+/// failure, are the same either way.
+std::unique_ptr<ProjectSaveFileNodes> parse_project(const ProjectSaveFileViews &, bool matrices = true, bool parallel = false);
+
 void deser_size           (const mp::Node*, uint16_t &width, uint16_t &height);
 void deser_buffer_geos    (const mp::Node*, BufferGeos&);
 void deser_seed           (const mp::Node*, int&);
 void deser_water          (const mp::Node*, int&, bool&);
 void deser_light          (const mp::Node*, bool&);
+void deser_light_settings (const mp::Node*, int &angle, int &flatness);
 void deser_terrain_medium (const mp::Node*, bool&);
 void deser_geometry_matrix(const mp::Node*, Matrix<GeoCell>&);
 
@@ -65,13 +135,163 @@ void deser_geometry_matrix(const mp::Node*, Matrix<GeoCell>&);
 /// @note The function expects receiving the #tlMatrix node and 
 /// not the node of the entire line.
 void deser_tile_matrix    (const mp::Node*, Matrix<TileCell>&);
-void deser_cameras        (const mp::Node*, std::vector<mr::LevelCamera>&);
+/// @param diagnostics When given, malformed cameras are reported and
+/// dropped instead of failing.
+void deser_cameras        (const mp::Node*, std::vector<mr::LevelCamera>&, Diagnostics *diagnostics = nullptr);
+
+/// @brief Deserializes the geometry matrix while reading the geometry line,
+/// without building a syntax tree.
+/// @param diagnostics When given, malformed cells are reported and left
+/// as air instead of failing; only unreadable syntax still throws.
+void deser_geometry_matrix(mp::event_reader&, Matrix<GeoCell>&, Diagnostics *diagnostics = nullptr);
+
+/// @brief Deserializes a tile matrix while reading it, without building a 
+/// syntax tree.
+/// @note The reader is expected to be positioned at the value of #tlMatrix.
+/// @param diagnostics When given, malformed cells are reported and left
+/// empty instead of failing; only unreadable syntax still throws.
+void deser_tile_matrix    (mp::event_reader&, Matrix<TileCell>&, Diagnostics *diagnostics = nullptr);
+
+/// @brief Deserializes the effects line while reading it; effect matrices
+/// are quantized straight into their sparse chunks.
+/// @param width The width of the level.
+/// @param height The height of the level.
+/// @param diagnostics When given, malformed effects are reported and
+/// dropped instead of failing.
+void deser_effects(mp::event_reader&, std::vector<Effect>&, matrix_t width, matrix_t height, Diagnostics *diagnostics = nullptr);
 
 /// @note The function expects to receive the #props node and
 /// not the node of the entire line.
-void deser_props(const mp::Node*, std::vector<std::shared_ptr<Prop>>&);
+/// @param diagnostics When given, malformed props are reported and
+/// dropped instead of failing.
+void deser_props(const mp::Node*, std::vector<std::shared_ptr<Prop>>&, Diagnostics *diagnostics = nullptr);
+
+/// @brief Deserializes a level; independent stages (geometry, tiles,
+/// props, ..) run concurrently.
+/// @param cache When true, the level is loaded from its binary cache if
+/// the cache matches the project file; otherwise the project is parsed
+/// and the cache is regenerated.
+/// @param diagnostics When given, the level is deserialized leniently:
+/// malformed cells, props and cameras, as well as unreadable settings,
+/// are reported to it and replaced with defaults. A level that had any
+/// problems is not cached.
+/// @throws The failure of the earliest stage, as if run in sequence.
+/// In lenient mode, only when the project can't be read at all.
+std::unique_ptr<Level> deser_level(const std::filesystem::path&, bool cache = true, Diagnostics *diagnostics = nullptr);
+
+/// @brief Deserializes a level, then defines its tile matrix and its prop
+/// list concurrently.
+/// @note Tile and material cells are resolved later, through the dexes
+/// the level is used with (see TileDex::tile() and MaterialDex::material()).
+std::unique_ptr<Level> deser_level(
+  const std::filesystem::path&,
+  const PropDex*,
+  Diagnostics *diagnostics = nullptr
+);
 
-std::unique_ptr<Level> deser_level(const std::filesystem::path&);
+/// @brief Level information that is cheap enough to read for every
+/// project in a directory.
+struct LevelMetadata {
+  uint16_t width, height;
+  int seed;
+
+  size_t cameras;
+  size_t props;
+};
+
+/// @brief Reads a level's size, seed, camera count and prop count without
+/// deserializing it.
+/// @note The geometry and tiles lines are only scanned for their line
+/// breaks; they are never tokenized.
+LevelMetadata read_level_metadata(const std::filesystem::path&);
+
+// Save file writers
+
+/// @brief Writes a level as a project file, replacing the file only once
+/// it has been written completely.
+/// @note Lines are formatted directly into a file buffer. When a project
+/// is replaced, its light, terrain, size and water settings keep the
+/// properties that the level doesn't model. The lightmap is not written.
+/// @param tiles, props Locate tile heads and props by their 1-based
+/// (category, index) position, which the original editor and renderer
+/// look them up by. Definitions missing from them are written at
+/// point(0, 0).
+/// @throws serialization_failure if the file could not be written.
+void ser_level(
+  const Level&,
+  const std::filesystem::path&,
+  const TileDex *tiles,
+  const PropDex *props
+);
+
+// Caches
+
+/// @brief Identifies the contents of a file that a cache was built from.
+struct FileKey {
+  uint64_t size;
+  int64_t mtime;
+  uint64_t hash;
+
+  inline bool operator==(const FileKey &k) const noexcept { return size == k.size && mtime == k.mtime && hash == k.hash; }
+  inline bool operator!=(const FileKey &k) const noexcept { return !(*this == k); }
+};
+
+/// @brief Reads the size and the modification time of a file, and hashes 
+/// its contents.
+FileKey file_key(const std::filesystem::path&);
+
+/// @brief The binary cache of a project file; <name>.mrcache next to it.
+std::filesystem::path level_cache_path(const std::filesystem::path &project);
+
+/// @brief Loads a level from the binary cache of a project file.
+/// @return nullptr if there is no cache, or if it is stale, corrupt or 
+/// written by another version.
+/// @note The tile matrix and the props are left undefined, as with 
+/// deser_level().
+std::unique_ptr<Level> read_level_cache(const std::filesystem::path &project, const FileKey&);
+
+/// @brief Writes the binary cache of a level that was read from a 
+/// project file.
+/// @param key The key of the project file as it was when it was read.
+/// @throws serialization_failure if the cache could not be written.
+void write_level_cache(const Level&, const std::filesystem::path &project, const FileKey &key);
+
+/// @brief The cache of an image file's keyed copy (see key_white())
+/// within a cache directory.
+std::filesystem::path keyed_image_cache_path(const std::filesystem::path &directory, const std::filesystem::path &image);
+
+/// @brief Loads a keyed image from its cache.
+/// @param variant Tells apart keyed copies made differently from the same file.
+/// @return An image without data if there is no cache, or if it is stale
+/// or corrupt. Otherwise an R8G8B8A8 image to be unloaded with UnloadImage().
+Image read_keyed_image_cache(const std::filesystem::path &cache, const FileKey &key, uint32_t variant);
+
+/// @brief Writes the cache of a keyed R8G8B8A8 image.
+/// @throws serialization_failure if the cache could not be written.
+void write_keyed_image_cache(const Image&, const std::filesystem::path &cache, const FileKey &key, uint32_t variant);
+
+/// @brief The Init files to register definitions from, in order.
+struct DexSources {
+  std::vector<std::filesystem::path> tiles;
+  std::vector<std::filesystem::path> props;
+};
+
+/// @brief Registers tiles and props from their Init files, or rebuilds 
+/// them from a snapshot of a previous registration if none of the files 
+/// have changed since.
+/// @param snapshot The snapshot file; it is rewritten after registering 
+/// from the Init files.
+/// @return true if the dexes were rebuilt from the snapshot.
+/// @note Texture paths are resolved again when restoring, against the
+/// current Cast members and texture directories.
+/// @throws The errors of TileDex::register_from() and PropDex::register_from().
+bool register_dexes(
+  const std::filesystem::path &snapshot,
+  const DexSources&,
+  TileDex&,
+  PropDex&,
+  const CastLibs*
+);
 
 // Init line parsers
 
@@ -140,16 +360,25 @@ void deser_point(const mp::Node *node, Vector2&);
 
 void deser_tilecell(const mp::Node*, TileCell&);
 
+// Streaming deserialization utilities
+
+/// @brief Reads an integer or a float event.
+int deser_int(mp::event_reader&);
+
+/// @brief Reads a string event.
+std::string deser_string(mp::event_reader&);
+
+/// @brief Reads a 'point' global call.
+void deser_point(mp::event_reader&, int&, int&);
+
+void deser_tilecell(mp::event_reader&, TileCell&);
+
 // TODO: Maybe move this section somewhere else
 
-/// @brief Goes through a tile matrix and defines each cell that 
-/// is a tile head, body, or a material.
-/// @note This function fails silently.
-void define_tile_matrix(
-  Matrix<TileCell>&, 
-  TileDex const*, 
-  MaterialDex const*
-);
+/// @brief Goes through a tile matrix and gives each body cell the name
+/// of its head, so that it resolves to the same tile.
+/// @note This function fails silently; bodies without a head keep their name.
+void define_tile_matrix(Matrix<TileCell>&);
 
 void define_prop_list(
   std::vector<std::shared_ptr<Prop>> &props,
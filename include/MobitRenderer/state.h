@@ -209,7 +209,7 @@ public:
   ~textures();
 };
 
-enum class context_event_type { level_loaded, level_selected, goto_page };
+enum class context_event_type { level_loaded, level_selected, goto_page, save_level };
 
 struct context_event {
   context_event_type type;
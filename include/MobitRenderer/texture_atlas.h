@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <filesystem>
+
+#include <raylib.h>
+
+#include <MobitRenderer/managed.h>
+
+namespace mr {
+
+/// @brief Where an image ended up in a TextureAtlas.
+struct AtlasRegion {
+  /// @brief The page holding the image; nullptr if the image was not packed.
+  const Texture2D *texture;
+
+  /// @brief The image's rectangle within the page.
+  Rectangle rect;
+
+  inline bool is_packed() const noexcept { return texture != nullptr; }
+
+  /// @brief Maps a rectangle of the original image onto the page.
+  inline Rectangle map(Rectangle source) const noexcept {
+    return Rectangle{ source.x + rect.x, source.y + rect.y, source.width, source.height };
+  }
+};
+
+/// @brief Packs image files into a few large textures (pages), so that
+/// draws from different images can share one texture and be batched.
+/// @note Pixels are copied in R8G8B8A8, with no padding, so a draw only
+/// looks the same as with its own texture if its source rectangle stays
+/// within the image.
+class TextureAtlas {
+public:
+  typedef size_t handle_t;
+
+private:
+  struct entry {
+    std::filesystem::path path;
+    int page;
+    Rectangle rect;
+  };
+
+  int _page_size;
+  bool _keyed;
+
+  std::vector<entry> _entries;
+  std::vector<texture> _pages;
+
+public:
+  /// @brief Queues an image file to be packed by the next build().
+  handle_t add(const std::filesystem::path &path);
+
+  /// @brief Loads the queued images and packs them into pages.
+  /// @note Images that are missing, or larger than a page, are not packed.
+  /// @attention Requires OpenGL context.
+  void build();
+
+  /// @return An unpacked region if the handle was never added or built.
+  AtlasRegion region(handle_t handle) const noexcept;
+
+  inline size_t page_count() const noexcept { return _pages.size(); }
+  inline bool is_keyed() const noexcept { return _keyed; }
+
+  /// @brief Forgets every image and unloads the pages.
+  /// @attention Requires OpenGL context if any page was built.
+  void clear();
+
+  TextureAtlas &operator=(const TextureAtlas &) = delete;
+
+  /// @param keyed Whether images are keyed with key_white() as they are loaded.
+  explicit TextureAtlas(int page_size = 2048, bool keyed = false);
+  TextureAtlas(const TextureAtlas &) = delete;
+};
+
+}; // namespace mr
@@ -0,0 +1,156 @@
+// Compares the stream tokenizer (owning tokens, numbers converted from
+// strings afterwards) with the buffer tokenizer (views of a mapped file,
+// numbers converted while scanning).
+//
+// Usage: mobitparser_bench_tokenize <project file or directory>...
+// Directories are searched recursively for .txt files, e.g. Data/Levels.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <MobitParser/mapping.h>
+#include <MobitParser/tokens.h>
+
+using clock_type = std::chrono::steady_clock;
+
+static constexpr int rounds = 5;
+
+struct result {
+  double seconds;
+  size_t tokens;
+  size_t numbers;
+
+  // Keeps the conversions from being optimized away.
+  long long checksum;
+};
+
+static result run_stream(const std::filesystem::path &path) {
+  result r{0, 0, 0, 0};
+  auto start = clock_type::now();
+
+  std::ifstream file(path, std::ios::binary);
+  std::vector<mp::token> tokens;
+
+  while (file.peek() != std::ifstream::traits_type::eof()) {
+    mp::tokenize_line(file, tokens);
+    r.tokens += tokens.size();
+
+    for (const auto &token : tokens) {
+      if (token.type == mp::token_type::integer) {
+        r.checksum += std::stoi(token.value);
+        r.numbers++;
+      } else if (token.type == mp::token_type::floating) {
+        r.checksum += static_cast<long long>(std::stof(token.value));
+        r.numbers++;
+      }
+    }
+  }
+
+  r.seconds = std::chrono::duration<double>(clock_type::now() - start).count();
+  return r;
+}
+
+static result run_buffer(const std::filesystem::path &path) {
+  result r{0, 0, 0, 0};
+  auto start = clock_type::now();
+
+  mp::mapped_file file(path);
+
+  const char *cursor = file.begin();
+  const char *end = file.end();
+
+  std::vector<mp::token_view> tokens;
+
+  while (cursor != end) {
+    mp::tokenize_line(cursor, end, tokens);
+    r.tokens += tokens.size();
+
+    for (const auto &token : tokens) {
+      if (token.type == mp::token_type::integer) {
+        r.checksum += token.integer;
+        r.numbers++;
+      } else if (token.type == mp::token_type::floating) {
+        r.checksum += static_cast<long long>(token.floating);
+        r.numbers++;
+      }
+    }
+  }
+
+  r.seconds = std::chrono::duration<double>(clock_type::now() - start).count();
+  return r;
+}
+
+template <typename Run>
+static result best_of(Run run, const std::filesystem::path &path) {
+  result best = run(path);
+
+  for (int i = 1; i < rounds; i++) {
+    result r = run(path);
+    if (r.seconds < best.seconds)
+      best = r;
+  }
+
+  return best;
+}
+
+static void collect(const std::filesystem::path &path,
+                    std::vector<std::filesystem::path> &files) {
+  if (!std::filesystem::is_directory(path)) {
+    files.push_back(path);
+    return;
+  }
+
+  for (const auto &entry :
+       std::filesystem::recursive_directory_iterator(path)) {
+    if (entry.is_regular_file() && entry.path().extension() == ".txt")
+      files.push_back(entry.path());
+  }
+}
+
+int main(int argc, char **argv) {
+  std::vector<std::filesystem::path> files;
+
+  for (int i = 1; i < argc; i++)
+    collect(argv[i], files);
+
+  if (files.empty()) {
+    std::fprintf(stderr, "usage: %s <project file or directory>...\n",
+                 argv[0]);
+    return 1;
+  }
+
+  std::sort(files.begin(), files.end());
+
+  double stream_total = 0, buffer_total = 0;
+
+  std::printf("%-40s %10s %10s %12s %12s %8s\n", "file", "tokens", "numbers",
+              "stream (ms)", "buffer (ms)", "speedup");
+
+  for (const auto &file : files) {
+    result stream = best_of(run_stream, file);
+    result buffer = best_of(run_buffer, file);
+
+    if (stream.tokens != buffer.tokens || stream.checksum != buffer.checksum)
+      std::fprintf(stderr, "warning: %s: the tokenizers disagree\n",
+                   file.string().c_str());
+
+    stream_total += stream.seconds;
+    buffer_total += buffer.seconds;
+
+    std::printf("%-40s %10zu %10zu %12.3f %12.3f %7.2fx\n",
+                file.filename().string().c_str(), buffer.tokens,
+                buffer.numbers, stream.seconds * 1000, buffer.seconds * 1000,
+                stream.seconds / buffer.seconds);
+  }
+
+  std::printf("%-40s %10s %10s %12.3f %12.3f %7.2fx\n", "total", "", "",
+              stream_total * 1000, buffer_total * 1000,
+              stream_total / buffer_total);
+
+  return 0;
+}
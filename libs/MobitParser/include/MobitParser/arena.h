@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace mp {
+
+/// @brief A monotonic memory region for syntax trees.
+/// @note The whole region is released at once, and the destructors of the
+/// objects placed in it are never run. Only objects that own no resources
+/// may live in it, such as mp::Node subclasses, whose strings and children
+/// are themselves in the arena.
+class arena {
+private:
+  struct block {
+    block *next;
+    size_t capacity;
+  };
+
+  block *head_;
+  char *cursor_;
+  char *limit_;
+
+  size_t block_size_;
+
+  void grow(size_t min_size);
+
+public:
+  /// @brief Allocates uninitialized memory that lives as long as the arena.
+  inline void *allocate(size_t size,
+                        size_t alignment = alignof(std::max_align_t)) {
+    size_t padding = static_cast<size_t>(
+        -reinterpret_cast<uintptr_t>(cursor_) & (alignment - 1));
+
+    if (cursor_ == nullptr ||
+        size + padding > static_cast<size_t>(limit_ - cursor_)) {
+      grow(size + alignment);
+      padding = static_cast<size_t>(-reinterpret_cast<uintptr_t>(cursor_) &
+                                    (alignment - 1));
+    }
+
+    void *memory = cursor_ + padding;
+    cursor_ += padding + size;
+
+    return memory;
+  }
+
+  template <typename T, typename... Args> inline T *make(Args &&...args) {
+    return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+  }
+
+  /// @brief Copies a range of trivially copyable objects into the arena.
+  template <typename T> inline T *copy(const T *source, size_t count) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "only trivially copyable objects can be copied into an arena");
+
+    if (count == 0)
+      return nullptr;
+
+    T *destination = static_cast<T *>(allocate(sizeof(T) * count, alignof(T)));
+    std::memcpy(destination, source, sizeof(T) * count);
+
+    return destination;
+  }
+
+  /// @brief Copies a string into the arena.
+  inline std::string_view copy(std::string_view str) {
+    return std::string_view(copy(str.data(), str.size()), str.size());
+  }
+
+  /// @brief Releases everything allocated so far, keeping the most recent
+  /// block around for reuse.
+  void reset() noexcept;
+
+  arena &operator=(const arena &) = delete;
+  arena &operator=(arena &&) = delete;
+
+  arena(const arena &) = delete;
+  arena(arena &&) = delete;
+
+  /// @param block_size The size of the first block; later blocks double in
+  /// size.
+  explicit arena(size_t block_size = 16 * 1024);
+  ~arena();
+};
+}; // namespace mp
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+#include <MobitParser/tokens.h>
+
+namespace mp {
+enum class event_type : uint8_t {
+  begin_list, // [
+  end_list,   // ]
+
+  property, // #key:
+
+  begin_call, // point(
+  end_call,   // )
+
+  integer,  // 0, -1
+  floating, // 0.0, -1.5
+  string,   // "Hello World"
+  symbol,   // #symbol
+  void_val, // void
+
+  end_of_line
+};
+
+/// @brief A single event produced by mp::event_reader.
+/// @note value refers to the source buffer: the key of a property, the name
+/// of a call, the contents of a string or a symbol, or the text of a number.
+struct event {
+  event_type type;
+  std::string_view value;
+
+  int integer;
+  float floating;
+
+  /// @brief Case-insensitive comparison against the value, for matching
+  /// property keys without lowercasing them first.
+  bool is(std::string_view) const noexcept;
+};
+
+std::ostream &operator<<(std::ostream &, event_type);
+
+/// @brief A pull parser that turns a Lingo data line into a flat stream of
+/// events without building a syntax tree.
+/// @note Only literal data is supported (lists, property lists, global calls,
+/// numbers, strings and symbols); lines containing operator expressions
+/// must go through mp::parse() instead.
+class event_reader {
+private:
+  const char *cursor_;
+  const char *end_;
+
+  token_view pending_;
+  bool has_pending_;
+  bool pending_end_;
+
+  event peeked_;
+  bool has_peeked_;
+
+  bool next_token(token_view &);
+  event read();
+
+public:
+  /// @brief The position in the buffer after the last consumed line break.
+  inline const char *cursor() const noexcept { return cursor_; }
+
+  /// @brief Returns the next event without consuming it.
+  const event &peek();
+
+  /// @brief Consumes the next event.
+  event next();
+
+  /// @brief Consumes the next event.
+  /// @throws mp::parse_failure if the event is not of the given type.
+  event expect(event_type);
+
+  /// @throws mp::parse_failure if the next event is not an integer.
+  int next_int();
+
+  /// @throws mp::parse_failure if the next event is not a string.
+  std::string_view next_string();
+
+  /// @brief Consumes the next value; a list or a call is skipped entirely.
+  void skip();
+
+  /// @brief Skips values until the property with the given key is found
+  /// within the current property list.
+  /// @return false if the property list ended before the key was found.
+  bool seek_property(std::string_view key);
+
+  event_reader(const char *begin, const char *end);
+  explicit event_reader(std::string_view);
+};
+
+/// @brief Pushes every event of the current line to the handler.
+/// @param handler Is called as handler(const mp::event &).
+template <typename Handler>
+void read_events(event_reader &reader, Handler &&handler) {
+  for (;;) {
+    event e = reader.next();
+
+    if (e.type == event_type::end_of_line)
+      return;
+
+    handler(e);
+  }
+}
+}; // namespace mp
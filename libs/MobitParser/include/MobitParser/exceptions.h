@@ -21,4 +21,13 @@ namespace mp {
         const char *what() const noexcept override;
         explicit parse_failure(const std::string&);
     };
+
+    class mapping_failure : public std::exception {
+    private:
+        std::string msg_;
+
+    public:
+        const char *what() const noexcept override;
+        explicit mapping_failure(const std::string&);
+    };
 };
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+
+namespace mp {
+
+/// @brief A read-only memory mapping of an entire file.
+/// @note The mapped bytes are only valid for the lifetime of the object;
+/// any mp::token_view produced from it must not outlive it.
+class mapped_file {
+private:
+  const char *data_;
+  size_t size_;
+
+#ifdef _WIN32
+  void *file_;
+  void *mapping_;
+#else
+  int fd_;
+#endif
+
+  void close() noexcept;
+
+public:
+  inline const char *data() const noexcept { return data_; }
+  inline size_t size() const noexcept { return size_; }
+
+  inline const char *begin() const noexcept { return data_; }
+  inline const char *end() const noexcept { return data_ + size_; }
+
+  inline std::string_view view() const noexcept {
+    return std::string_view(data_, size_);
+  }
+
+  mapped_file &operator=(const mapped_file &) = delete;
+  mapped_file &operator=(mapped_file &&) noexcept;
+
+  mapped_file(const mapped_file &) = delete;
+  mapped_file(mapped_file &&) noexcept;
+
+  /// @brief Maps the file into memory.
+  /// @throws mp::mapping_failure if the file could not be opened or mapped.
+  explicit mapped_file(const std::filesystem::path &);
+  ~mapped_file();
+};
+}; // namespace mp
@@ -1,11 +1,15 @@
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <cstddef>
 #include <memory>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
 
+#include <MobitParser/arena.h>
+#include <MobitParser/symbols.h>
 #include <MobitParser/tokens.h>
 
 namespace mp {
@@ -32,15 +36,148 @@ enum class unary_operation : uint8_t {
 /// TODO: implement this
 inline int operator_precedence(token_type) { return 0; }
 
+enum class node_kind : uint8_t {
+  void_val,    // Void
+  integer,     // Int
+  floating,    // Float
+  string,      // String
+  symbol,      // Symbol
+  identifier,  // Iden
+  binary_op,   // BinOp
+  unary_op,    // UnOp
+  list,        // List
+  props,       // Props
+  global_call  // GCall
+};
+
+class Void;
+class Int;
+class Float;
+class String;
+class Symbol;
+class Iden;
+class BinOp;
+class UnOp;
+class List;
+class Props;
+class GCall;
+
 class Node {
 public:
+  const node_kind kind;
+
+  // Unchecked accessors; the kind must be checked beforehand.
+
+  inline const Int *as_int() const noexcept;
+  inline const Float *as_float() const noexcept;
+  inline const String *as_string() const noexcept;
+  inline const Symbol *as_symbol() const noexcept;
+  inline const Iden *as_iden() const noexcept;
+  inline const BinOp *as_binop() const noexcept;
+  inline const UnOp *as_unop() const noexcept;
+  inline const List *as_list() const noexcept;
+  inline const Props *as_props() const noexcept;
+  inline const GCall *as_gcall() const noexcept;
+
   virtual ~Node() = default;
+
+protected:
+  Node(node_kind kind_) : kind(kind_) {}
+};
+
+/// @brief A non-owning, contiguous range of nodes.
+class node_span {
+private:
+  Node *const *data_;
+  size_t size_;
+
+public:
+  using iterator = Node *const *;
+
+  inline size_t size() const noexcept { return size_; }
+  inline bool empty() const noexcept { return size_ == 0; }
+
+  inline Node *operator[](size_t index) const noexcept { return data_[index]; }
+
+  inline iterator begin() const noexcept { return data_; }
+  inline iterator end() const noexcept { return data_ + size_; }
+
+  node_span() noexcept : data_(nullptr), size_(0) {}
+  node_span(Node *const *data, size_t size) noexcept
+      : data_(data), size_(size) {}
+};
+
+/// @brief A property list entry; named after std::pair so that lookups read
+/// like the std::unordered_map they replaced.
+struct property {
+  symbol first;
+  Node *second;
 };
 
-class Void : public Node {};
+/// @brief A non-owning, contiguous range of property list entries, sorted
+/// by symbol.
+class property_span {
+private:
+  const property *data_;
+  size_t size_;
+
+public:
+  using iterator = const property *;
+
+  inline size_t size() const noexcept { return size_; }
+  inline bool empty() const noexcept { return size_ == 0; }
+
+  inline iterator begin() const noexcept { return data_; }
+  inline iterator end() const noexcept { return data_ + size_; }
+
+  /// @return end() if the key was not found.
+  inline iterator find(symbol key) const noexcept {
+    // Property lists rarely hold more than a handful of entries.
+    if (size_ <= 8) {
+      for (auto *entry = begin(); entry != end(); entry++) {
+        if (entry->first >= key)
+          return entry->first == key ? entry : end();
+      }
+
+      return end();
+    }
+
+    auto *entry = std::lower_bound(
+        begin(), end(), key,
+        [](const property &p, symbol k) { return p.first < k; });
+
+    return entry != end() && entry->first == key ? entry : end();
+  }
+
+  /// @brief Looks up a key by name; prefer the mp::keys overload.
+  /// @return end() if the key was not found.
+  iterator find(std::string_view key) const noexcept;
+
+  /// @throws std::out_of_range if the key was not found.
+  Node *at(symbol key) const;
+
+  /// @throws std::out_of_range if the key was not found.
+  Node *at(std::string_view key) const;
+
+  property_span() noexcept : data_(nullptr), size_(0) {}
+  property_span(const property *data, size_t size) noexcept
+      : data_(data), size_(size) {}
+};
+
+// All nodes live in an mp::arena, hence every member is trivially
+// destructible and strings refer to copies made in the arena.
+
+class Void : public Node {
+public:
+  static constexpr node_kind kind_tag = node_kind::void_val;
+
+  Void();
+};
 
 class Int : public Node {
 public:
+  static constexpr node_kind kind_tag = node_kind::integer;
+
   const int number;
 
   Int(int);
@@ -48,6 +185,8 @@ public:
 
 class Float : public Node {
 public:
+  static constexpr node_kind kind_tag = node_kind::floating;
+
   const float number;
 
   Float(float);
@@ -55,69 +194,127 @@ public:
 
 class String : public Node {
 public:
-  const std::string str;
+  static constexpr node_kind kind_tag = node_kind::string;
 
-  String(std::string);
-  String(std::string &&);
+  const std::string_view str;
+
+  String(std::string_view);
 };
 
 class Symbol : public Node {
 public:
-  const std::string str;
+  static constexpr node_kind kind_tag = node_kind::symbol;
+
+  const std::string_view str;
 
-  Symbol(std::string);
-  Symbol(std::string &&);
+  Symbol(std::string_view);
 };
 
 class Iden : public Node {
 public:
-  const std::string identifier;
+  static constexpr node_kind kind_tag = node_kind::identifier;
+
+  const std::string_view identifier;
 
   Iden() = delete;
-  Iden(std::string &&);
+  Iden(std::string_view);
 };
 
 class BinOp : public Node {
 public:
+  static constexpr node_kind kind_tag = node_kind::binary_op;
+
   const binary_operation op;
-  const std::unique_ptr<Node> left, right;
+  Node *const left, *const right;
 
-  BinOp(binary_operation op_, std::unique_ptr<Node> &&left_,
-        std::unique_ptr<Node> &&right_);
+  BinOp(binary_operation op_, Node *left_, Node *right_);
 };
 
 class UnOp : public Node {
 public:
+  static constexpr node_kind kind_tag = node_kind::unary_op;
+
   const unary_operation op;
-  const std::unique_ptr<Node> operand;
+  Node *const operand;
 
-  UnOp(unary_operation op_, std::unique_ptr<Node> &&operand_);
+  UnOp(unary_operation op_, Node *operand_);
 };
 
 class List : public Node {
 public:
-  const std::vector<std::unique_ptr<Node>> elements;
+  static constexpr node_kind kind_tag = node_kind::list;
+
+  const node_span elements;
 
   List();
-  List(std::vector<std::unique_ptr<Node>> &&);
+  List(node_span);
 };
 
 class Props : public Node {
 public:
-  const std::unordered_map<std::string, std::unique_ptr<Node>> map;
+  static constexpr node_kind kind_tag = node_kind::props;
+
+  /// @note Keys are lowercased.
+  const property_span map;
 
   Props();
-  Props(std::unordered_map<std::string, std::unique_ptr<Node>> &&);
+  Props(property_span);
 };
 
 class GCall : public Node {
 public:
-  const std::string name;
-  const std::vector<std::unique_ptr<Node>> args;
+  static constexpr node_kind kind_tag = node_kind::global_call;
+
+  const std::string_view name;
+  const node_span args;
 
-  GCall(std::string &&, std::vector<std::unique_ptr<Node>> &&);
+  GCall(std::string_view, node_span);
 };
 
+inline const Int *Node::as_int() const noexcept {
+  return static_cast<const Int *>(this);
+}
+inline const Float *Node::as_float() const noexcept {
+  return static_cast<const Float *>(this);
+}
+inline const String *Node::as_string() const noexcept {
+  return static_cast<const String *>(this);
+}
+inline const Symbol *Node::as_symbol() const noexcept {
+  return static_cast<const Symbol *>(this);
+}
+inline const Iden *Node::as_iden() const noexcept {
+  return static_cast<const Iden *>(this);
+}
+inline const BinOp *Node::as_binop() const noexcept {
+  return static_cast<const BinOp *>(this);
+}
+inline const UnOp *Node::as_unop() const noexcept {
+  return static_cast<const UnOp *>(this);
+}
+inline const List *Node::as_list() const noexcept {
+  return static_cast<const List *>(this);
+}
+inline const Props *Node::as_props() const noexcept {
+  return static_cast<const Props *>(this);
+}
+inline const GCall *Node::as_gcall() const noexcept {
+  return static_cast<const GCall *>(this);
+}
+
+/// @brief A checked cast by node kind; a drop-in for dynamic_cast.
+/// @return nullptr if the node is null or of a different kind.
+template <typename T> inline const T *node_cast(const Node *node) noexcept {
+  return node != nullptr && node->kind == T::kind_tag
+             ? static_cast<const T *>(node)
+             : nullptr;
+}
+
+template <typename T> inline T *node_cast(Node *node) noexcept {
+  return node != nullptr && node->kind == T::kind_tag ? static_cast<T *>(node)
+                                                      : nullptr;
+}
+
 inline std::ostream &operator<<(std::ostream &stream, unary_operation op) {
   switch (op) {
   case unary_operation::logical_negation:
@@ -171,9 +368,29 @@ std::ostream &operator<<(std::ostream &, const Node *);
 /// @param str The expression string.
 /// @param flat_tree pre-evaluates some expression such as unary operations to
 /// numbers and global calls.
+/// @note The tree is allocated in its own mp::arena, which is released
+/// along with the root node.
 std::unique_ptr<Node> parse(const std::string &str, bool flat_tree = true);
 
 /// @brief Constructs an abstact syntax tree from a node vector.
 std::unique_ptr<Node> parse(const std::vector<token> &tokens,
                             bool flat_tree = true);
+
+/// @brief Constructs an abstact syntax tree from non-owning tokens.
+/// @note The resulting tree owns copies of all strings, so it may outlive
+/// the buffer the tokens refer to.
+std::unique_ptr<Node> parse(const std::vector<token_view> &tokens,
+                            bool flat_tree = true);
+
+/// @brief Constructs an abstract syntax tree in the given arena.
+/// @return The root node, which lives until the arena is reset or destroyed;
+/// it must not be deleted.
+Node *parse(const std::string &str, arena &, bool flat_tree = true);
+
+/// @brief Constructs an abstract syntax tree in the given arena.
+Node *parse(const std::vector<token> &tokens, arena &, bool flat_tree = true);
+
+/// @brief Constructs an abstract syntax tree in the given arena.
+Node *parse(const std::vector<token_view> &tokens, arena &,
+            bool flat_tree = true);
 }; // namespace mp
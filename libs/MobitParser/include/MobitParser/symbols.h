@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace mp {
+
+/// @brief An interned, lowercased property list key.
+/// @note Two keys are equal if and only if their symbols are equal, so
+/// property lookups compare integers instead of strings.
+using symbol = uint32_t;
+
+namespace keys {
+
+/// @brief The keys looked up by the deserializers. These have fixed IDs and
+/// are resolved through a perfect hash, without locking.
+/// @note Keep sorted and in sync with the name table in symbols.cpp.
+enum : symbol {
+  applycolor,
+  bevel,
+  bftiles,
+  block,
+  cameras,
+  color,
+  colorize,
+  colortreatment,
+  contourexp,
+  customdepth,
+  data,
+  defaultmaterial,
+  defaultterrain,
+  depth,
+  depthaffecthilites,
+  extratiles,
+  floor,
+  highlightborder,
+  light,
+  nm,
+  point,
+  props,
+  pxlsize,
+  quads,
+  random,
+  release,
+  renderorder,
+  rendertime,
+  repeatl,
+  rnd,
+  round,
+  seed,
+  selfshade,
+  settings,
+  shadowborder,
+  size,
+  slope,
+  smoothshading,
+  specs,
+  specs2,
+  specs3,
+  sz,
+  tags,
+  texture,
+  thickness,
+  tileseed,
+  tlmatrix,
+  tp,
+  var,
+  vars,
+  waterinfront,
+  waterlevel,
+
+  well_known_count
+};
+}; // namespace keys
+
+/// @brief Returns the symbol of a key, interning it if it has not been seen
+/// before. The comparison is case-insensitive.
+/// @note Thread-safe.
+symbol intern(std::string_view key);
+
+/// @brief Finds the symbol of a key without interning it.
+/// @return false if the key was never interned.
+bool lookup(std::string_view key, symbol &);
+
+/// @brief Returns the lowercased name of a symbol, or an empty view if the
+/// symbol does not exist.
+std::string_view symbol_name(symbol);
+}; // namespace mp
@@ -4,6 +4,7 @@
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace mp {
@@ -76,10 +77,37 @@ struct token {
   token(token_type, const std::string &&);
 };
 
+/// @brief A non-owning token that refers to a slice of the source buffer.
+/// @note Punctuation and operators point at their characters in the
+/// source, so producing them never allocates.
+struct token_view {
+  token_type type;
+  std::string_view value;
+
+  /// Numbers are converted while tokenizing; both fields hold the value
+  /// of an integer or a floating token.
+  int integer;
+  float floating;
+};
+
 std::ostream &operator<<(std::ostream &, const token &);
+std::ostream &operator<<(std::ostream &, const token_view &);
 
 std::vector<token> tokenize(std::ifstream &);
 std::vector<token> tokenize_line(std::ifstream &);
 bool tokenize_line(std::ifstream &, std::vector<token> &);
 std::vector<token> tokenize(const std::string &);
+
+/// @brief Tokenizes a single line from an in-memory buffer (e.g. an
+/// mp::mapped_file) without copying any of it.
+/// @param cursor Is advanced past the line and its line break ('\r', '\n'
+/// or "\r\n").
+/// @return false if the line has no tokens.
+bool tokenize_line(const char *&cursor, const char *end,
+                   std::vector<token_view> &);
+
+/// @brief Reads the next token of the current line from an in-memory buffer.
+/// @return false when the line (or the buffer) ends; the line break is
+/// consumed.
+bool next_token(const char *&cursor, const char *end, token_view &);
 }; // namespace mp
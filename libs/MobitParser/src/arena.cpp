@@ -0,0 +1,63 @@
+#include <algorithm>
+#include <cstddef>
+#include <new>
+
+#include <MobitParser/arena.h>
+
+namespace mp {
+
+// Blocks stop doubling past this size.
+static constexpr size_t max_block_size = 4 * 1024 * 1024;
+
+// The block header is padded so that the data that follows it is
+// maximally aligned.
+static constexpr size_t block_header(size_t header_size) {
+  return (header_size + alignof(std::max_align_t) - 1) &
+         ~(alignof(std::max_align_t) - 1);
+}
+
+arena::arena(size_t block_size)
+    : head_(nullptr), cursor_(nullptr), limit_(nullptr),
+      block_size_(std::max<size_t>(block_size, 256)) {}
+
+arena::~arena() {
+  while (head_ != nullptr) {
+    block *next = head_->next;
+    ::operator delete(head_);
+    head_ = next;
+  }
+}
+
+void arena::grow(size_t min_size) {
+  size_t capacity = std::max(block_size_, min_size);
+
+  auto *new_block =
+      static_cast<block *>(::operator new(block_header(sizeof(block)) + capacity));
+
+  new_block->next = head_;
+  new_block->capacity = capacity;
+
+  head_ = new_block;
+  cursor_ = reinterpret_cast<char *>(new_block) + block_header(sizeof(block));
+  limit_ = cursor_ + capacity;
+
+  block_size_ = std::min(block_size_ * 2, max_block_size);
+}
+
+void arena::reset() noexcept {
+  if (head_ == nullptr)
+    return;
+
+  block *current = head_->next;
+  while (current != nullptr) {
+    block *next = current->next;
+    ::operator delete(current);
+    current = next;
+  }
+
+  head_->next = nullptr;
+
+  cursor_ = reinterpret_cast<char *>(head_) + block_header(sizeof(block));
+  limit_ = cursor_ + head_->capacity;
+}
+}; // namespace mp
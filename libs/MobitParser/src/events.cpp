@@ -0,0 +1,272 @@
+#include <cctype>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include <MobitParser/events.h>
+#include <MobitParser/exceptions.h>
+#include <MobitParser/tokens.h>
+
+namespace mp {
+
+bool event::is(std::string_view key) const noexcept {
+  if (value.size() != key.size())
+    return false;
+
+  for (size_t i = 0; i < key.size(); i++) {
+    if (tolower(static_cast<unsigned char>(value[i])) !=
+        tolower(static_cast<unsigned char>(key[i])))
+      return false;
+  }
+
+  return true;
+}
+
+std::ostream &operator<<(std::ostream &stream, event_type type) {
+  switch (type) {
+  case event_type::begin_list:
+    stream << "'['";
+    break;
+  case event_type::end_list:
+    stream << "']'";
+    break;
+  case event_type::property:
+    stream << "property";
+    break;
+  case event_type::begin_call:
+    stream << "call";
+    break;
+  case event_type::end_call:
+    stream << "')'";
+    break;
+  case event_type::integer:
+    stream << "integer";
+    break;
+  case event_type::floating:
+    stream << "float";
+    break;
+  case event_type::string:
+    stream << "string";
+    break;
+  case event_type::symbol:
+    stream << "symbol";
+    break;
+  case event_type::void_val:
+    stream << "void";
+    break;
+  case event_type::end_of_line:
+    stream << "end of line";
+    break;
+  }
+
+  return stream;
+}
+
+event_reader::event_reader(const char *begin, const char *end)
+    : cursor_(begin), end_(end), pending_{}, has_pending_(false),
+      pending_end_(false), peeked_{}, has_peeked_(false) {}
+
+event_reader::event_reader(std::string_view str)
+    : event_reader(str.data(), str.data() + str.size()) {}
+
+bool event_reader::next_token(token_view &token) {
+  if (has_pending_) {
+    has_pending_ = false;
+    token = pending_;
+    return true;
+  }
+
+  if (pending_end_) {
+    pending_end_ = false;
+    return false;
+  }
+
+  return mp::next_token(cursor_, end_, token);
+}
+
+event event_reader::read() {
+  token_view token;
+
+  for (;;) {
+    if (!next_token(token))
+      return event{event_type::end_of_line, {}, 0, 0};
+
+    switch (token.type) {
+    // Separators carry no data; a property list's shape is
+    // already given by its property events.
+    case token_type::comma:
+    case token_type::colon:
+      continue;
+
+    case token_type::open_bracket:
+      return event{event_type::begin_list, token.value, 0, 0};
+    case token_type::close_bracket:
+      return event{event_type::end_list, token.value, 0, 0};
+    case token_type::close_paren:
+      return event{event_type::end_call, token.value, 0, 0};
+
+    case token_type::string:
+      return event{event_type::string, token.value, 0, 0};
+
+    case token_type::void_val:
+      return event{event_type::void_val, token.value, 0, 0};
+
+    case token_type::symbol: {
+      token_view after;
+
+      if (next_token(after)) {
+        if (after.type == token_type::colon)
+          return event{event_type::property, token.value, 0, 0};
+
+        pending_ = after;
+        has_pending_ = true;
+      } else {
+        pending_end_ = true;
+      }
+
+      return event{event_type::symbol, token.value, 0, 0};
+    }
+
+    case token_type::identifier: {
+      token_view after;
+
+      if (!next_token(after) || after.type != token_type::open_paren)
+        throw parse_failure("unexpected identifier '" +
+                            std::string(token.value) + "'");
+
+      return event{event_type::begin_call, token.value, 0, 0};
+    }
+
+    // Numbers were already converted by the tokenizer.
+    case token_type::integer:
+      return event{event_type::integer, token.value, token.integer,
+                   token.floating};
+
+    case token_type::floating:
+      return event{event_type::floating, token.value, token.integer,
+                   token.floating};
+
+    // Signed numbers
+    case token_type::add:
+    case token_type::subtract: {
+      bool negative = token.type == token_type::subtract;
+      token_view number_token;
+
+      if (!next_token(number_token) ||
+          (number_token.type != token_type::integer &&
+           number_token.type != token_type::floating))
+        throw parse_failure("expected a number after '" +
+                            std::string(token.value) + "'");
+
+      std::string_view text(token.value.data(),
+                            static_cast<size_t>(number_token.value.data() +
+                                                number_token.value.size() -
+                                                token.value.data()));
+
+      if (number_token.type == token_type::integer) {
+        int number = negative ? -number_token.integer : number_token.integer;
+
+        return event{event_type::integer, text, number,
+                     static_cast<float>(number)};
+      }
+
+      float number = negative ? -number_token.floating : number_token.floating;
+
+      return event{event_type::floating, text, static_cast<int>(number),
+                   number};
+    }
+
+    default:
+      throw parse_failure("unexpected token '" + std::string(token.value) +
+                          "'");
+    }
+  }
+}
+
+const event &event_reader::peek() {
+  if (!has_peeked_) {
+    peeked_ = read();
+    has_peeked_ = true;
+  }
+
+  return peeked_;
+}
+
+event event_reader::next() {
+  if (has_peeked_) {
+    has_peeked_ = false;
+    return peeked_;
+  }
+
+  return read();
+}
+
+event event_reader::expect(event_type type) {
+  event e = next();
+
+  if (e.type != type) {
+    std::stringstream ss;
+    ss << "expected " << type << " but got " << e.type;
+    throw parse_failure(ss.str());
+  }
+
+  return e;
+}
+
+int event_reader::next_int() { return expect(event_type::integer).integer; }
+
+std::string_view event_reader::next_string() {
+  return expect(event_type::string).value;
+}
+
+void event_reader::skip() {
+  int depth = 0;
+
+  do {
+    event e = next();
+
+    switch (e.type) {
+    case event_type::begin_list:
+    case event_type::begin_call:
+      depth++;
+      break;
+
+    case event_type::end_list:
+    case event_type::end_call:
+      if (--depth < 0)
+        throw parse_failure("unexpected closing bracket");
+      break;
+
+    case event_type::end_of_line:
+      throw parse_failure("unexpected end of line");
+
+    default:
+      break;
+    }
+  } while (depth > 0);
+}
+
+bool event_reader::seek_property(std::string_view key) {
+  for (;;) {
+    const event &e = peek();
+
+    if (e.type == event_type::end_list)
+      return false;
+
+    if (e.type != event_type::property) {
+      std::stringstream ss;
+      ss << "expected property but got " << e.type;
+      throw parse_failure(ss.str());
+    }
+
+    bool found = e.is(key);
+    next();
+
+    if (found)
+      return true;
+
+    skip();
+  }
+}
+}; // namespace mp
@@ -9,4 +9,7 @@ const char *double_decimal_point::what() const noexcept { return msg_.c_str(); }
 
 parse_failure::parse_failure(const std::string &msg) : msg_(msg) {}
 const char *parse_failure::what() const noexcept { return msg_.c_str(); }
+
+mapping_failure::mapping_failure(const std::string &msg) : msg_(msg) {}
+const char *mapping_failure::what() const noexcept { return msg_.c_str(); }
 }; // namespace mp
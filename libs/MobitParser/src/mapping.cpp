@@ -0,0 +1,173 @@
+#include <filesystem>
+#include <string>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <MobitParser/exceptions.h>
+#include <MobitParser/mapping.h>
+
+namespace mp {
+
+// Empty files cannot be mapped, so they all point here instead.
+static const char empty_mapping[1] = {'\0'};
+
+#ifdef _WIN32
+
+mapped_file::mapped_file(const std::filesystem::path &path)
+    : data_(empty_mapping), size_(0), file_(INVALID_HANDLE_VALUE),
+      mapping_(nullptr) {
+  file_ = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                      OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+  if (file_ == INVALID_HANDLE_VALUE)
+    throw mapping_failure("could not open file '" + path.string() + "'");
+
+  LARGE_INTEGER file_size;
+  if (!GetFileSizeEx(file_, &file_size)) {
+    close();
+    throw mapping_failure("could not retrieve the size of '" + path.string() +
+                          "'");
+  }
+
+  if (file_size.QuadPart == 0)
+    return;
+
+  mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (mapping_ == nullptr) {
+    close();
+    throw mapping_failure("could not map file '" + path.string() + "'");
+  }
+
+  const void *view = MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0);
+  if (view == nullptr) {
+    close();
+    throw mapping_failure("could not map file '" + path.string() + "'");
+  }
+
+  data_ = static_cast<const char *>(view);
+  size_ = static_cast<size_t>(file_size.QuadPart);
+}
+
+void mapped_file::close() noexcept {
+  if (data_ != empty_mapping)
+    UnmapViewOfFile(data_);
+  if (mapping_ != nullptr)
+    CloseHandle(mapping_);
+  if (file_ != INVALID_HANDLE_VALUE)
+    CloseHandle(file_);
+
+  data_ = empty_mapping;
+  size_ = 0;
+  mapping_ = nullptr;
+  file_ = INVALID_HANDLE_VALUE;
+}
+
+mapped_file::mapped_file(mapped_file &&other) noexcept
+    : data_(other.data_), size_(other.size_), file_(other.file_),
+      mapping_(other.mapping_) {
+  other.data_ = empty_mapping;
+  other.size_ = 0;
+  other.file_ = INVALID_HANDLE_VALUE;
+  other.mapping_ = nullptr;
+}
+
+mapped_file &mapped_file::operator=(mapped_file &&other) noexcept {
+  if (this == &other)
+    return *this;
+
+  close();
+
+  data_ = other.data_;
+  size_ = other.size_;
+  file_ = other.file_;
+  mapping_ = other.mapping_;
+
+  other.data_ = empty_mapping;
+  other.size_ = 0;
+  other.file_ = INVALID_HANDLE_VALUE;
+  other.mapping_ = nullptr;
+
+  return *this;
+}
+
+#else
+
+mapped_file::mapped_file(const std::filesystem::path &path)
+    : data_(empty_mapping), size_(0), fd_(-1) {
+  fd_ = ::open(path.c_str(), O_RDONLY);
+
+  if (fd_ == -1)
+    throw mapping_failure("could not open file '" + path.string() + "'");
+
+  struct stat info;
+  if (fstat(fd_, &info) == -1) {
+    close();
+    throw mapping_failure("could not retrieve the size of '" + path.string() +
+                          "'");
+  }
+
+  if (info.st_size == 0)
+    return;
+
+  void *view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ,
+                    MAP_PRIVATE, fd_, 0);
+
+  if (view == MAP_FAILED) {
+    close();
+    throw mapping_failure("could not map file '" + path.string() + "'");
+  }
+
+  // The tokenizer walks the file front to back exactly once.
+  madvise(view, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+
+  data_ = static_cast<const char *>(view);
+  size_ = static_cast<size_t>(info.st_size);
+}
+
+void mapped_file::close() noexcept {
+  if (data_ != empty_mapping)
+    munmap(const_cast<char *>(data_), size_);
+  if (fd_ != -1)
+    ::close(fd_);
+
+  data_ = empty_mapping;
+  size_ = 0;
+  fd_ = -1;
+}
+
+mapped_file::mapped_file(mapped_file &&other) noexcept
+    : data_(other.data_), size_(other.size_), fd_(other.fd_) {
+  other.data_ = empty_mapping;
+  other.size_ = 0;
+  other.fd_ = -1;
+}
+
+mapped_file &mapped_file::operator=(mapped_file &&other) noexcept {
+  if (this == &other)
+    return *this;
+
+  close();
+
+  data_ = other.data_;
+  size_ = other.size_;
+  fd_ = other.fd_;
+
+  other.data_ = empty_mapping;
+  other.size_ = 0;
+  other.fd_ = -1;
+
+  return *this;
+}
+
+#endif
+
+mapped_file::~mapped_file() { close(); }
+}; // namespace mp
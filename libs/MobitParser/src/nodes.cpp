@@ -1,10 +1,12 @@
 #include <algorithm>
 #include <cctype>
+#include <charconv>
 #include <iostream>
 #include <memory>
 #include <numeric>
+#include <stdexcept>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
 
 #ifdef __linux__
@@ -16,74 +18,121 @@
 #include <MobitParser/tokens.h>
 
 namespace mp {
-Int::Int(int number) : number(number) {}
-Float::Float(float number) : number(number) {}
-String::String(std::string &&str_) : str(std::move(str_)) {}
-String::String(std::string str_) : str(str_) {}
-Symbol::Symbol(std::string &&str_) : str(std::move(str_)) {}
-Symbol::Symbol(std::string str_) : str(str_) {}
-Iden::Iden(std::string &&iden) : identifier(std::move(iden)) {}
-BinOp::BinOp(binary_operation op_, std::unique_ptr<Node> &&left_,
-             std::unique_ptr<Node> &&right_)
-    : op(op_), left(std::move(left_)), right(std::move(right_)) {}
-UnOp::UnOp(unary_operation op_, std::unique_ptr<Node> &&operand_)
-    : op(op_), operand(std::move(operand_)) {}
-List::List() {}
-List::List(std::vector<std::unique_ptr<Node>> &&elements_)
-    : elements(std::move(elements_)) {}
-Props::Props() {}
-Props::Props(std::unordered_map<std::string, std::unique_ptr<Node>> &&map_)
-    : map(std::move(map_)) {}
-GCall::GCall(std::string &&name_, std::vector<std::unique_ptr<Node>> &&args_)
-    : name(std::move(name_)), args(std::move(args_)) {}
+Void::Void() : Node(kind_tag) {}
+Int::Int(int number) : Node(kind_tag), number(number) {}
+Float::Float(float number) : Node(kind_tag), number(number) {}
+String::String(std::string_view str_) : Node(kind_tag), str(str_) {}
+Symbol::Symbol(std::string_view str_) : Node(kind_tag), str(str_) {}
+Iden::Iden(std::string_view iden) : Node(kind_tag), identifier(iden) {}
+BinOp::BinOp(binary_operation op_, Node *left_, Node *right_)
+    : Node(kind_tag), op(op_), left(left_), right(right_) {}
+UnOp::UnOp(unary_operation op_, Node *operand_)
+    : Node(kind_tag), op(op_), operand(operand_) {}
+List::List() : Node(kind_tag) {}
+List::List(node_span elements_) : Node(kind_tag), elements(elements_) {}
+Props::Props() : Node(kind_tag) {}
+Props::Props(property_span map_) : Node(kind_tag), map(map_) {}
+GCall::GCall(std::string_view name_, node_span args_)
+    : Node(kind_tag), name(name_), args(args_) {}
+
+property_span::iterator property_span::find(std::string_view key) const noexcept {
+  symbol id;
+
+  if (!lookup(key, id))
+    return end();
+
+  return find(id);
+}
+
+Node *property_span::at(symbol key) const {
+  auto entry = find(key);
+
+  if (entry == end())
+    throw std::out_of_range("property '" + std::string(symbol_name(key)) +
+                            "' not found");
+
+  return entry->second;
+}
+
+Node *property_span::at(std::string_view key) const {
+  auto entry = find(key);
+
+  if (entry == end())
+    throw std::out_of_range("property '" + std::string(key) + "' not found");
+
+  return entry->second;
+}
 
 std::ostream &operator<<(std::ostream &stream, const Node *node) {
-  if (const auto *integer = dynamic_cast<const Int *>(node)) {
-    stream << integer->number;
-  } else if (const auto *floating = dynamic_cast<const Float *>(node)) {
-    stream << floating->number;
-  } else if (const auto *string = dynamic_cast<const String *>(node)) {
-    stream << '"' << string->str << '"';
-  } else if (const auto *symbol = dynamic_cast<const Symbol *>(node)) {
-    stream << '#' << symbol->str;
-  } else if (const auto *iden = dynamic_cast<const Iden *>(node)) {
-    stream << iden->identifier;
-  } else if (const auto *bin_op = dynamic_cast<const BinOp *>(node)) {
-    stream << bin_op->left.get() << ' ' << bin_op->op << ' '
-           << bin_op->right.get();
-  } else if (const auto *un_op = dynamic_cast<const UnOp *>(node)) {
-    stream << un_op->op << un_op->operand.get();
-  } else if (const auto *list = dynamic_cast<const List *>(node)) {
+  if (node == nullptr)
+    return stream;
+
+  switch (node->kind) {
+  case node_kind::integer:
+    stream << node->as_int()->number;
+    break;
+  case node_kind::floating:
+    stream << node->as_float()->number;
+    break;
+  case node_kind::string:
+    stream << '"' << node->as_string()->str << '"';
+    break;
+  case node_kind::symbol:
+    stream << '#' << node->as_symbol()->str;
+    break;
+  case node_kind::identifier:
+    stream << node->as_iden()->identifier;
+    break;
+  case node_kind::binary_op: {
+    const auto *bin_op = node->as_binop();
+    stream << bin_op->left << ' ' << bin_op->op << ' ' << bin_op->right;
+  } break;
+  case node_kind::unary_op: {
+    const auto *un_op = node->as_unop();
+    stream << un_op->op << un_op->operand;
+  } break;
+  case node_kind::list: {
+    const auto *list = node->as_list();
+
     stream << '[';
 
     for (int i = 0; i < list->elements.size(); i++) {
-      stream << list->elements[i].get();
+      stream << list->elements[i];
 
       if (i != list->elements.size() - 1)
         stream << ", ";
     }
 
     stream << ']';
-  } else if (const auto *props = dynamic_cast<const Props *>(node)) {
+  } break;
+  case node_kind::props: {
+    const auto *props = node->as_props();
+
     stream << '[';
 
     for (auto i = props->map.begin(); i != props->map.end(); i++) {
-      stream << '#' << i->first << ": " << i->second.get();
+      stream << '#' << symbol_name(i->first) << ": " << i->second;
       stream << ",";
     }
 
     stream << ']';
-  } else if (const auto *gcall = dynamic_cast<const GCall *>(node)) {
+  } break;
+  case node_kind::global_call: {
+    const auto *gcall = node->as_gcall();
+
     stream << gcall->name << '(';
 
     for (int i = 0; i < gcall->args.size(); i++) {
-      stream << gcall->args[i].get();
+      stream << gcall->args[i];
 
       if (i != gcall->args.size() - 1)
         stream << ", ";
     }
 
     stream << ')';
+  } break;
+  case node_kind::void_val:
+    break;
   }
 
   return stream;
@@ -159,7 +208,7 @@ constexpr int operator_precedence(operators op) {
   return 0;
 }
 
-bool is_iden_const(const std::string &name) {
+bool is_iden_const(std::string_view name) {
   if (name == "RETURN") return true;
   if (name == "ENTER") return true;
   if (name == "SPACE") return true;
@@ -170,7 +219,7 @@ bool is_iden_const(const std::string &name) {
   return false;
 }
 
-const char *eval_const_iden(const std::string &name) {
+const char *eval_const_iden(std::string_view name) {
   if (name == "RETURN") return "\n";
   if (name == "ENTER") return "\n";
   if (name == "SPACE") return " ";
@@ -180,10 +229,79 @@ const char *eval_const_iden(const std::string &name) {
   return "";
 }
 
-std::unique_ptr<Node> parse_helper(std::vector<token>::const_iterator &cursor,
-                                   std::vector<token>::const_iterator end,
-                                   int precedence, bool flat_tree) {
-  std::unique_ptr<Node> expr = nullptr;
+struct parser {
+  arena &region;
+  const bool flat_tree;
+
+  // Scratch stacks: the elements of every list being parsed are collected
+  // here, then copied into the arena as one span once the list is closed.
+  std::vector<Node *> elements;
+  std::vector<property> properties;
+
+  node_span take_elements(size_t mark) {
+    node_span span(region.copy(elements.data() + mark, elements.size() - mark),
+                   elements.size() - mark);
+    elements.resize(mark);
+    return span;
+  }
+
+  property_span take_properties(size_t mark) {
+    std::sort(properties.begin() + mark, properties.end(),
+              [](const property &a, const property &b) {
+                return a.first < b.first;
+              });
+
+    property_span span(
+        region.copy(properties.data() + mark, properties.size() - mark),
+        properties.size() - mark);
+    properties.resize(mark);
+    return span;
+  }
+
+  parser(arena &region_, bool flat_tree_)
+      : region(region_), flat_tree(flat_tree_) {}
+};
+
+// Buffer tokens carry their converted value; owning tokens are
+// converted from their text.
+
+static inline int integer_value(const token_view &token) {
+  return token.integer;
+}
+
+static inline float floating_value(const token_view &token) {
+  return token.floating;
+}
+
+static int integer_value(const token &token) {
+  int number = 0;
+  const char *begin = token.value.data();
+
+  if (std::from_chars(begin, begin + token.value.size(), number).ec !=
+      std::errc())
+    throw parse_failure("invalid integer '" + token.value + "'");
+
+  return number;
+}
+
+static float floating_value(const token &token) {
+  float number = 0;
+  const char *begin = token.value.data();
+
+  if (std::from_chars(begin, begin + token.value.size(), number).ec !=
+      std::errc())
+    throw parse_failure("invalid floating number '" + token.value + "'");
+
+  return number;
+}
+
+/// Works over both owning (mp::token) and non-owning (mp::token_view)
+/// token vectors.
+template <typename TokenIter>
+Node *parse_helper(TokenIter &cursor, TokenIter end, int precedence,
+                   parser &state) {
+  const bool flat_tree = state.flat_tree;
+  Node *expr = nullptr;
 
   switch (cursor->type) {
     // Unary operators
@@ -197,18 +315,18 @@ std::unique_ptr<Node> parse_helper(std::vector<token>::const_iterator &cursor,
     int req_precedence = operator_precedence(operators::math_affirmation);
 
     auto operand_expr =
-        parse_helper(cursor, end, req_precedence + 1, flat_tree);
+        parse_helper(cursor, end, req_precedence + 1, state);
 
     if (flat_tree) {
 
-      if (auto *integer = dynamic_cast<Int *>(operand_expr.get())) {
-        expr = std::make_unique<Int>(integer->number);
-      } else if (auto *floating = dynamic_cast<Float *>(operand_expr.get())) {
-        expr = std::make_unique<Float>(floating->number);
+      if (auto *integer = node_cast<Int>(operand_expr)) {
+        expr = state.region.make<Int>(integer->number);
+      } else if (auto *floating = node_cast<Float>(operand_expr)) {
+        expr = state.region.make<Float>(floating->number);
       }
 
     } else {
-      expr = std::make_unique<UnOp>(op, std::move(operand_expr));
+      expr = state.region.make<UnOp>(op, operand_expr);
     }
 
   } break;
@@ -222,19 +340,19 @@ std::unique_ptr<Node> parse_helper(std::vector<token>::const_iterator &cursor,
     int req_precedence = operator_precedence(operators::math_negation);
 
     auto operand_expr =
-        parse_helper(cursor, end, req_precedence + 1, flat_tree);
+        parse_helper(cursor, end, req_precedence + 1, state);
 
     // pre-evaluate the unary operation for negative numbers
     if (flat_tree) {
 
-      if (auto *integer = dynamic_cast<Int *>(operand_expr.get())) {
-        expr = std::make_unique<Int>(-1 * integer->number);
-      } else if (auto *floating = dynamic_cast<Float *>(operand_expr.get())) {
-        expr = std::make_unique<Float>(-1 * floating->number);
+      if (auto *integer = node_cast<Int>(operand_expr)) {
+        expr = state.region.make<Int>(-1 * integer->number);
+      } else if (auto *floating = node_cast<Float>(operand_expr)) {
+        expr = state.region.make<Float>(-1 * floating->number);
       }
 
     } else {
-      expr = std::make_unique<UnOp>(op, std::move(operand_expr));
+      expr = state.region.make<UnOp>(op, operand_expr);
     }
 
   } break;
@@ -248,48 +366,44 @@ std::unique_ptr<Node> parse_helper(std::vector<token>::const_iterator &cursor,
     int req_precedence = operator_precedence(operators::logic_negation);
 
     auto operand_expr =
-        parse_helper(cursor, end, req_precedence + 1, flat_tree);
+        parse_helper(cursor, end, req_precedence + 1, state);
 
-    expr = std::make_unique<UnOp>(op, std::move(operand_expr));
+    expr = state.region.make<UnOp>(op, operand_expr);
   };
 
   case token_type::integer: {
-    int integer = std::stoi(cursor->value);
-
-    expr = std::make_unique<Int>(integer);
+    expr = state.region.make<Int>(integer_value(*cursor));
   } break;
 
   case token_type::floating: {
-    float floating = std::stof(cursor->value);
-
-    expr = std::make_unique<Float>(floating);
+    expr = state.region.make<Float>(floating_value(*cursor));
   } break;
 
   case token_type::string: {
-    expr = std::make_unique<String>(cursor->value);
+    expr = state.region.make<String>(
+        state.region.copy(std::string_view(cursor->value)));
   } break;
 
   case token_type::symbol: {
-    expr = std::make_unique<Symbol>(cursor->value);
+    expr = state.region.make<Symbol>(
+        state.region.copy(std::string_view(cursor->value)));
   } break;
 
   case token_type::identifier: {
 
-    std::string iden = cursor->value;
+    std::string_view iden = state.region.copy(std::string_view(cursor->value));
 
     // pre-evaluate global calls
     if (flat_tree) {
 
       auto peek = cursor + 1;
       if (peek != end && peek->type == token_type::open_paren) {
-        std::vector<std::unique_ptr<Node>> args;
+        const size_t mark = state.elements.size();
 
         while (peek != end) {
           peek++;
 
-          auto arg_expr = parse_helper(peek, end, precedence, flat_tree);
-
-          args.push_back(std::move(arg_expr));
+          state.elements.push_back(parse_helper(peek, end, precedence, state));
 
           if (++peek == end)
             throw parse_failure("global call expression ended prematurely "
@@ -304,9 +418,9 @@ std::unique_ptr<Node> parse_helper(std::vector<token>::const_iterator &cursor,
 
         cursor = peek;
 
-        expr = std::make_unique<GCall>(std::move(iden), std::move(args));
+        expr = state.region.make<GCall>(iden, state.take_elements(mark));
       } else {
-        expr = std::make_unique<Iden>(std::move(iden));
+        expr = state.region.make<Iden>(iden);
       }
     }
   } break;
@@ -323,7 +437,7 @@ std::unique_ptr<Node> parse_helper(std::vector<token>::const_iterator &cursor,
     if (peek->type == token_type::close_bracket) {
       cursor++;
 
-      expr = std::make_unique<List>();
+      expr = state.region.make<List>();
     }
     // empty property list
     else if (peek->type == token_type::colon) {
@@ -336,10 +450,10 @@ std::unique_ptr<Node> parse_helper(std::vector<token>::const_iterator &cursor,
 
       cursor += 2;
 
-      expr = std::make_unique<Props>();
+      expr = state.region.make<Props>();
     } else {
-      std::vector<std::unique_ptr<Node>> list;
-      std::unordered_map<std::string, std::unique_ptr<Node>> map;
+      const size_t element_mark = state.elements.size();
+      const size_t property_mark = state.properties.size();
 
       bool is_props = peek->type == token_type::symbol;
 
@@ -347,9 +461,7 @@ std::unique_ptr<Node> parse_helper(std::vector<token>::const_iterator &cursor,
 
       while (peek != end) {
         if (is_props) {
-          std::string key = peek->value;
-
-          std::transform(key.begin(), key.end(), key.begin(), ::tolower);
+          symbol key = intern(std::string_view(peek->value));
 
           if (++peek == end)
             throw parse_failure("property list expression ended prematurely "
@@ -363,9 +475,20 @@ std::unique_ptr<Node> parse_helper(std::vector<token>::const_iterator &cursor,
             throw parse_failure("property list expression ended prematurely "
                                 "(expected an expression)");
 
-          auto value_expr = parse_helper(peek, end, precedence, flat_tree);
+          Node *value_expr = parse_helper(peek, end, precedence, state);
+
+          // Later duplicates replace earlier ones.
+          bool replaced = false;
+          for (size_t i = property_mark; i < state.properties.size(); i++) {
+            if (state.properties[i].first == key) {
+              state.properties[i].second = value_expr;
+              replaced = true;
+              break;
+            }
+          }
 
-          map.insert_or_assign(std::move(key), std::move(value_expr));
+          if (!replaced)
+            state.properties.push_back(property{key, value_expr});
 
           if (++peek == end)
             throw parse_failure(
@@ -379,9 +502,7 @@ std::unique_ptr<Node> parse_helper(std::vector<token>::const_iterator &cursor,
                 "invalid property list expression (expected a comma)");
         } else {
 
-          auto element_expr = parse_helper(peek, end, precedence, flat_tree);
-
-          list.push_back(std::move(element_expr));
+          state.elements.push_back(parse_helper(peek, end, precedence, state));
 
           if (++peek == end)
             throw parse_failure(
@@ -399,9 +520,9 @@ std::unique_ptr<Node> parse_helper(std::vector<token>::const_iterator &cursor,
       }
 
       if (is_props) {
-        expr = std::make_unique<Props>(std::move(map));
+        expr = state.region.make<Props>(state.take_properties(property_mark));
       } else {
-        expr = std::make_unique<List>(std::move(list));
+        expr = state.region.make<List>(state.take_elements(element_mark));
       }
 
       cursor = peek;
@@ -411,8 +532,8 @@ std::unique_ptr<Node> parse_helper(std::vector<token>::const_iterator &cursor,
   }
 
   if (expr != nullptr && flat_tree) {
-    String *str = dynamic_cast<String*>(expr.get());
-    Iden *iden = dynamic_cast<Iden*>(expr.get());
+    String *str = node_cast<String>(expr);
+    Iden *iden = node_cast<Iden>(expr);
 
     if (str != nullptr || iden != nullptr) {
       std::string ss(str != nullptr ? str->str : eval_const_iden(iden->identifier));
@@ -440,7 +561,7 @@ std::unique_ptr<Node> parse_helper(std::vector<token>::const_iterator &cursor,
         else break;
       }
 
-      expr = std::make_unique<String>(ss);
+      expr = state.region.make<String>(state.region.copy(std::string_view(ss)));
     }
   }
 
@@ -448,31 +569,108 @@ std::unique_ptr<Node> parse_helper(std::vector<token>::const_iterator &cursor,
   return expr;
 }
 
-std::unique_ptr<Node> parse(const std::string &str, bool flat_tree) {
+/// The root of a tree returned by the arena-less parse() overloads; it owns
+/// the arena that the rest of the tree lives in.
+template <typename T> class tree_root final : public T {
+private:
+  std::unique_ptr<arena> region_;
+
+public:
+  tree_root(const T &node, std::unique_ptr<arena> &&region)
+      : T(node), region_(std::move(region)) {}
+};
+
+template <typename T>
+static std::unique_ptr<Node> make_root(Node *root, std::unique_ptr<arena> &region) {
+  return std::make_unique<tree_root<T>>(*static_cast<T *>(root),
+                                        std::move(region));
+}
+
+static std::unique_ptr<Node> own_tree(Node *root,
+                                      std::unique_ptr<arena> &&region) {
+  if (root == nullptr)
+    return nullptr;
+
+  switch (root->kind) {
+  case node_kind::list:
+    return make_root<List>(root, region);
+  case node_kind::props:
+    return make_root<Props>(root, region);
+  case node_kind::integer:
+    return make_root<Int>(root, region);
+  case node_kind::floating:
+    return make_root<Float>(root, region);
+  case node_kind::string:
+    return make_root<String>(root, region);
+  case node_kind::symbol:
+    return make_root<Symbol>(root, region);
+  case node_kind::global_call:
+    return make_root<GCall>(root, region);
+  case node_kind::identifier:
+    return make_root<Iden>(root, region);
+  case node_kind::binary_op:
+    return make_root<BinOp>(root, region);
+  case node_kind::unary_op:
+    return make_root<UnOp>(root, region);
+  case node_kind::void_val:
+    break;
+  }
+
+  return make_root<Void>(root, region);
+}
+
+/// A first block large enough to hold most trees at once.
+static size_t estimate_arena_size(size_t tokens) { return tokens * 16; }
+
+Node *parse(const std::string &str, arena &region, bool flat_tree) {
   if (str.empty())
     return nullptr;
 
-  const auto tokens = tokenize(str);
+  return parse(tokenize(str), region, flat_tree);
+}
+Node *parse(const std::vector<token> &tokens, arena &region, bool flat_tree) {
+  if (tokens.empty())
+    return nullptr;
+
+  parser state(region, flat_tree);
+  auto cursor = tokens.begin();
 
+  return parse_helper(cursor, tokens.end(), 0, state);
+}
+Node *parse(const std::vector<token_view> &tokens, arena &region,
+            bool flat_tree) {
   if (tokens.empty())
     return nullptr;
 
+  parser state(region, flat_tree);
   auto cursor = tokens.begin();
-  auto end = tokens.end();
 
-  auto expr = parse_helper(cursor, tokens.end(), 0, flat_tree);
+  return parse_helper(cursor, tokens.end(), 0, state);
+}
 
-  return expr;
+std::unique_ptr<Node> parse(const std::string &str, bool flat_tree) {
+  if (str.empty())
+    return nullptr;
+
+  return parse(tokenize(str), flat_tree);
 }
 std::unique_ptr<Node> parse(const std::vector<token> &tokens, bool flat_tree) {
   if (tokens.empty())
     return nullptr;
 
-  auto cursor = tokens.begin();
-  auto end = tokens.end();
+  auto region = std::make_unique<arena>(estimate_arena_size(tokens.size()));
+  Node *root = parse(tokens, *region, flat_tree);
 
-  auto expr = parse_helper(cursor, tokens.end(), 0, flat_tree);
+  return own_tree(root, std::move(region));
+}
+std::unique_ptr<Node> parse(const std::vector<token_view> &tokens,
+                            bool flat_tree) {
+  if (tokens.empty())
+    return nullptr;
 
-  return expr;
+  auto region = std::make_unique<arena>(estimate_arena_size(tokens.size()));
+  Node *root = parse(tokens, *region, flat_tree);
+
+  return own_tree(root, std::move(region));
 }
 }; // namespace mp
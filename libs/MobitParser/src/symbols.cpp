@@ -0,0 +1,193 @@
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <MobitParser/symbols.h>
+
+namespace mp {
+
+static constexpr std::string_view well_known_names[] = {
+    "applycolor",      "bevel",          "bftiles",
+    "block",           "cameras",        "color",
+    "colorize",        "colortreatment", "contourexp",
+    "customdepth",     "data",           "defaultmaterial",
+    "defaultterrain",  "depth",          "depthaffecthilites",
+    "extratiles",      "floor",          "highlightborder",
+    "light",           "nm",             "point",
+    "props",           "pxlsize",        "quads",
+    "random",          "release",        "renderorder",
+    "rendertime",      "repeatl",        "rnd",
+    "round",           "seed",           "selfshade",
+    "settings",        "shadowborder",   "size",
+    "slope",           "smoothshading",  "specs",
+    "specs2",          "specs3",         "sz",
+    "tags",            "texture",        "thickness",
+    "tileseed",        "tlmatrix",       "tp",
+    "var",             "vars",           "waterinfront",
+    "waterlevel",
+};
+
+static_assert(sizeof(well_known_names) / sizeof(*well_known_names) ==
+                  keys::well_known_count,
+              "the well-known key names are out of sync with mp::keys");
+
+static constexpr char lower(char c) {
+  return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+// Case-insensitive FNV-1a. The seed was searched for so that the top byte
+// of the hash is unique for every well-known key.
+static constexpr uint32_t hash_seed = 2166136716u;
+
+static constexpr uint8_t slot_of(std::string_view key) {
+  uint32_t hash = hash_seed;
+
+  for (char c : key)
+    hash = (hash ^ static_cast<unsigned char>(lower(c))) * 16777619u;
+
+  return static_cast<uint8_t>(hash >> 24);
+}
+
+static constexpr uint8_t empty_slot = 0xFF;
+
+struct perfect_hash_table {
+  uint8_t slots[256];
+};
+
+static constexpr perfect_hash_table make_table() {
+  perfect_hash_table table{};
+
+  for (auto &slot : table.slots)
+    slot = empty_slot;
+
+  for (symbol id = 0; id < keys::well_known_count; id++)
+    table.slots[slot_of(well_known_names[id])] = static_cast<uint8_t>(id);
+
+  return table;
+}
+
+static constexpr perfect_hash_table well_known_table = make_table();
+
+static constexpr bool is_perfect() {
+  for (symbol id = 0; id < keys::well_known_count; id++) {
+    if (well_known_table.slots[slot_of(well_known_names[id])] != id)
+      return false;
+  }
+
+  return true;
+}
+
+static_assert(is_perfect(), "well-known keys collide; search for another seed");
+
+static bool equals_lowercase(std::string_view key, std::string_view name) {
+  if (key.size() != name.size())
+    return false;
+
+  for (size_t i = 0; i < key.size(); i++) {
+    if (lower(key[i]) != name[i])
+      return false;
+  }
+
+  return true;
+}
+
+static bool find_well_known(std::string_view key, symbol &id) {
+  uint8_t slot = well_known_table.slots[slot_of(key)];
+
+  if (slot == empty_slot || !equals_lowercase(key, well_known_names[slot]))
+    return false;
+
+  id = slot;
+  return true;
+}
+
+// Keys outside of mp::keys are interned at runtime; the names are kept in
+// a deque so that the views handed out stay valid.
+struct symbol_table {
+  std::shared_mutex mutex;
+  std::deque<std::string> names;
+  std::unordered_map<std::string_view, symbol> ids;
+};
+
+static symbol_table &dynamic_symbols() {
+  static symbol_table table;
+  return table;
+}
+
+static std::string lowercase(std::string_view key) {
+  std::string lowered(key);
+
+  for (auto &c : lowered)
+    c = lower(c);
+
+  return lowered;
+}
+
+symbol intern(std::string_view key) {
+  symbol id;
+
+  if (find_well_known(key, id))
+    return id;
+
+  std::string lowered = lowercase(key);
+  auto &table = dynamic_symbols();
+
+  {
+    std::shared_lock<std::shared_mutex> lock(table.mutex);
+
+    auto found = table.ids.find(lowered);
+    if (found != table.ids.end())
+      return found->second;
+  }
+
+  std::unique_lock<std::shared_mutex> lock(table.mutex);
+
+  // Another thread may have interned it in the meantime.
+  auto found = table.ids.find(lowered);
+  if (found != table.ids.end())
+    return found->second;
+
+  id = keys::well_known_count + static_cast<symbol>(table.names.size());
+
+  table.names.push_back(std::move(lowered));
+  table.ids.emplace(table.names.back(), id);
+
+  return id;
+}
+
+bool lookup(std::string_view key, symbol &id) {
+  if (find_well_known(key, id))
+    return true;
+
+  std::string lowered = lowercase(key);
+  auto &table = dynamic_symbols();
+
+  std::shared_lock<std::shared_mutex> lock(table.mutex);
+
+  auto found = table.ids.find(lowered);
+  if (found == table.ids.end())
+    return false;
+
+  id = found->second;
+  return true;
+}
+
+std::string_view symbol_name(symbol id) {
+  if (id < keys::well_known_count)
+    return well_known_names[id];
+
+  auto &table = dynamic_symbols();
+
+  std::shared_lock<std::shared_mutex> lock(table.mutex);
+
+  size_t index = id - keys::well_known_count;
+  if (index >= table.names.size())
+    return {};
+
+  return table.names[index];
+}
+}; // namespace mp
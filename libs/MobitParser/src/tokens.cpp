@@ -1,12 +1,22 @@
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 #include <MobitParser/exceptions.h>
 #include <MobitParser/tokens.h>
 
 namespace mp {
-std::ostream &operator<<(std::ostream &stream, const token &token) {
+template <typename Token>
+static std::ostream &print_token(std::ostream &stream, const Token &token) {
   switch (token.type) {
   case token_type::open_bracket:
     stream << '[';
@@ -95,6 +105,14 @@ std::ostream &operator<<(std::ostream &stream, const token &token) {
   return stream;
 }
 
+std::ostream &operator<<(std::ostream &stream, const token &token) {
+  return print_token(stream, token);
+}
+
+std::ostream &operator<<(std::ostream &stream, const token_view &token) {
+  return print_token(stream, token);
+}
+
 token::token(token_type type, const std::string &&value)
     : type(type), value(value) {}
 
@@ -1099,4 +1117,273 @@ std::vector<token> tokenize(const std::string &str) {
 
   return tokens;
 };
+
+static inline bool is_alnum(char c) {
+  return isalnum(static_cast<unsigned char>(c));
+}
+
+static inline bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+#if defined(_MSC_VER) ||                                                       \
+    (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define MP_SWAR_DIGITS 1
+#endif
+
+#ifdef MP_SWAR_DIGITS
+/// Counts the leading ASCII digits of the next eight bytes, all at once.
+static inline unsigned leading_digits(const char *cursor) {
+  uint64_t word;
+  std::memcpy(&word, cursor, sizeof(word));
+
+  // A byte is a digit if its high nibble is 3, and still is after adding 6
+  // (that is, its low nibble is at most 9). Carries only leak past the
+  // first non-digit byte, which is the only one that matters.
+  uint64_t classes = (word & 0xF0F0F0F0F0F0F0F0ull) |
+                     (((word + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4);
+
+  // Zero bytes are digits; set the high bit of every other byte.
+  uint64_t others = classes ^ 0x3333333333333333ull;
+  uint64_t mask = (((others & 0x7F7F7F7F7F7F7F7Full) + 0x7F7F7F7F7F7F7F7Full) |
+                   others) &
+                  0x8080808080808080ull;
+
+  if (mask == 0)
+    return 8;
+
+#ifdef _MSC_VER
+  unsigned long index;
+  _BitScanForward64(&index, mask);
+  return static_cast<unsigned>(index) / 8;
+#else
+  return static_cast<unsigned>(__builtin_ctzll(mask)) / 8;
+#endif
+}
+#endif
+
+static inline const char *skip_digits(const char *cursor, const char *end) {
+#ifdef MP_SWAR_DIGITS
+  while (end - cursor >= 8) {
+    unsigned digits = leading_digits(cursor);
+    cursor += digits;
+
+    if (digits < 8)
+      return cursor;
+  }
+#endif
+
+  while (cursor != end && is_digit(*cursor))
+    cursor++;
+
+  return cursor;
+}
+
+static inline token_type keyword_or_identifier(std::string_view word) {
+  switch (word.size()) {
+  case 2:
+    if (word == "or")
+      return token_type::or_;
+    break;
+  case 3:
+    if (word == "not")
+      return token_type::negate;
+    if (word == "and")
+      return token_type::and_;
+    if (word == "mod")
+      return token_type::mod;
+    break;
+  case 4:
+    if (word == "void")
+      return token_type::void_val;
+    break;
+  }
+
+  return token_type::identifier;
+}
+
+bool next_token(const char *&cursor, const char *end, token_view &token) {
+  while (cursor != end) {
+    const char *start = cursor;
+    char c = *cursor++;
+
+    switch (c) {
+    case '\r':
+      if (cursor != end && *cursor == '\n')
+        cursor++;
+      return false;
+    case '\n':
+      return false;
+
+    case ' ':
+    case '\t': {
+    } break;
+
+    case '[':
+      token = {token_type::open_bracket, {start, 1}};
+      return true;
+    case ']':
+      token = {token_type::close_bracket, {start, 1}};
+      return true;
+
+    case '(':
+      token = {token_type::open_paren, {start, 1}};
+      return true;
+    case ')':
+      token = {token_type::close_paren, {start, 1}};
+      return true;
+
+    case ',':
+      token = {token_type::comma, {start, 1}};
+      return true;
+    case ':':
+      token = {token_type::colon, {start, 1}};
+      return true;
+
+    case '#': {
+      while (cursor != end && is_alnum(*cursor))
+        cursor++;
+
+      token = {token_type::symbol,
+               {start + 1, static_cast<size_t>(cursor - start - 1)}};
+    }
+      return true;
+
+    case '"': {
+      const char *closing = static_cast<const char *>(
+          memchr(cursor, '"', static_cast<size_t>(end - cursor)));
+      if (closing == nullptr)
+        closing = end;
+
+      token = {token_type::string,
+               {cursor, static_cast<size_t>(closing - cursor)}};
+
+      cursor = closing == end ? end : closing + 1;
+    }
+      return true;
+
+    case '>': {
+      if (cursor != end && *cursor == '=') {
+        cursor++;
+        token = {token_type::greater_or_eq, {start, 2}};
+      } else {
+        token = {token_type::greater, {start, 1}};
+      }
+    }
+      return true;
+
+    case '<': {
+      if (cursor != end && *cursor == '=') {
+        cursor++;
+        token = {token_type::smaller_or_eq, {start, 2}};
+      } else if (cursor != end && *cursor == '>') {
+        cursor++;
+        token = {token_type::inequal, {start, 2}};
+      } else {
+        token = {token_type::smaller, {start, 1}};
+      }
+    }
+      return true;
+
+    case '=':
+      token = {token_type::equal, {start, 1}};
+      return true;
+
+    case '&': {
+      if (cursor != end && *cursor == '&') {
+        cursor++;
+        token = {token_type::space_concat, {start, 2}};
+      } else {
+        token = {token_type::concat, {start, 1}};
+      }
+    }
+      return true;
+
+    case '-':
+      token = {token_type::subtract, {start, 1}};
+      return true;
+    case '+':
+      token = {token_type::add, {start, 1}};
+      return true;
+    case '*':
+      token = {token_type::multiply, {start, 1}};
+      return true;
+    case '/':
+      token = {token_type::divide, {start, 1}};
+      return true;
+
+    case '0':
+    case '1':
+    case '2':
+    case '3':
+    case '4':
+    case '5':
+    case '6':
+    case '7':
+    case '8':
+    case '9': {
+      // Most numbers in a level file are a single digit.
+      if (cursor == end || (!is_digit(*cursor) && *cursor != '.')) {
+        int number = c - '0';
+        token = {token_type::integer, {start, 1}, number,
+                 static_cast<float>(number)};
+        return true;
+      }
+
+      cursor = skip_digits(cursor, end);
+
+      // Numbers are converted right away, straight from the buffer.
+      if (cursor != end && *cursor == '.') {
+        cursor = skip_digits(cursor + 1, end);
+
+        if (cursor != end && *cursor == '.')
+          throw double_decimal_point(
+              "floating number cannot have more than one decimal point");
+
+        float number = 0;
+        std::from_chars(start, cursor, number);
+
+        token = {token_type::floating,
+                 {start, static_cast<size_t>(cursor - start)},
+                 static_cast<int>(number),
+                 number};
+      } else {
+        int number = 0;
+
+        if (std::from_chars(start, cursor, number).ec != std::errc())
+          throw parse_failure("invalid integer '" +
+                              std::string(start, cursor) + "'");
+
+        token = {token_type::integer,
+                 {start, static_cast<size_t>(cursor - start)},
+                 number,
+                 static_cast<float>(number)};
+      }
+    }
+      return true;
+
+    // identifier or keyword
+    default: {
+      while (cursor != end && is_alnum(*cursor))
+        cursor++;
+
+      std::string_view word(start, static_cast<size_t>(cursor - start));
+
+      token = {keyword_or_identifier(word), word};
+    }
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool tokenize_line(const char *&cursor, const char *end,
+                   std::vector<token_view> &tokens) {
+  tokens.clear();
+
+  token_view token;
+  while (next_token(cursor, end, token))
+    tokens.push_back(token);
+
+  return !tokens.empty();
+}
 }; // namespace mp
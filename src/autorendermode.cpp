@@ -263,13 +263,12 @@ int auto_render_window(int argc, char *argv[]) {
   castlibs->register_all();
   castlibs->load_all_members();
 
-  logger->info("loading tiles");
+  mr::serde::DexSources dex_sources;
+
+  dex_sources.tiles.push_back(directories->get_tiles() / "Init.txt");
+  dex_sources.tiles.push_back(directories->get_cast() / "Drought_393439_Drought Needed Init.txt");
+  dex_sources.props.push_back(directories->get_props() / "Init.txt");
 
-  auto *tiledex = new mr::TileDex();
-  tiledex->register_from(directories->get_tiles() / "Init.txt", castlibs);
-  tiledex->register_from(directories->get_cast() /
-                             "Drought_393439_Drought Needed Init.txt",
-                         castlibs);
   for (auto &tpath : add_tiles) {
     if (!std::filesystem::exists(tpath) ||
         std::filesystem::is_directory(tpath)) {
@@ -279,13 +278,9 @@ int auto_render_window(int argc, char *argv[]) {
       return -10;
     }
 
-    tiledex->register_from(tpath, castlibs);
+    dex_sources.tiles.push_back(tpath);
   }
 
-  logger->info("loading props");
-
-  auto *propdex = new mr::PropDex();
-  propdex->register_from(directories->get_props() / "Init.txt", castlibs);
   for (auto &ppath : add_props) {
     if (!std::filesystem::exists(ppath) ||
         std::filesystem::is_directory(ppath)) {
@@ -295,8 +290,19 @@ int auto_render_window(int argc, char *argv[]) {
       return -11;
     }
 
-    tiledex->register_from(ppath, castlibs);
+    dex_sources.props.push_back(ppath);
   }
+
+  logger->info("loading tiles and props");
+
+  auto *tiledex = new mr::TileDex();
+  auto *propdex = new mr::PropDex();
+
+  if (mr::serde::register_dexes(directories->get_data() / "dex.mrcache",
+                                dex_sources, *tiledex, *propdex, castlibs)) {
+    logger->info("restored tiles and props from snapshot");
+  }
+
   propdex->register_tiles(tiledex);
 
   logger->info("loading materials");
@@ -328,11 +334,8 @@ int auto_render_window(int argc, char *argv[]) {
   std::unique_ptr<mr::Level> level = nullptr;
 
   try {
-    level = mr::serde::deser_level(project_path);
+    level = mr::serde::deser_level(project_path, propdex);
 
-    mr::serde::define_tile_matrix(level->get_tile_matrix(), tiledex,
-                                  materialdex);
-    mr::serde::define_prop_list(level->props, propdex);
     level->set_path(project_path);
 
   } catch (std::exception &e) {
@@ -73,6 +73,7 @@ std::shared_ptr<Config> Config::from_file(const std::filesystem::path &p) {
     config.load_per_frame         = general["load_per_frame"].value_or(20);
     config.list_wrap              = general["list_wrap"].value_or(true);
     config.strict_deserialization = general["strict_deserialization"].value_or(false);
+    config.cache_keyed_textures   = general["cache_keyed_textures"].value_or(false);
 
     auto general_config = GenericPageConfig();
 
@@ -247,6 +248,7 @@ Config::Config() :
   load_per_frame(100),
   list_wrap(true),
   strict_deserialization(true),
+  cache_keyed_textures(false),
 
   tiles_prerender(SpritePrerender()),
   props_prerender(SpritePrerender()),
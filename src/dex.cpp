@@ -7,8 +7,17 @@
 #include <exception>
 #include <filesystem>
 #include <iostream>
-
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <future>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
+
+#include <MobitParser/arena.h>
 #include <MobitParser/exceptions.h>
+#include <MobitParser/mapping.h>
 #include <MobitParser/tokens.h>
 #include <MobitParser/nodes.h>
 
@@ -24,198 +33,371 @@ using std::filesystem::exists;
 
 namespace mr {
 
-TileDef *TileDex::tile(const std::string &name) const noexcept {
-    auto tile_ptr = _tiles.find(name);
-    if (tile_ptr == _tiles.end()) return nullptr;
-    return tile_ptr->second;
+// Init registration
+//
+// Init files are registered in three phases: every file is split into its
+// category and definition lines, the lines are parsed and deserialized on
+// worker threads, and the results are merged in file and line order, so the
+// dex ends up exactly as if the lines were registered one at a time.
+
+namespace {
+
+/// @brief An Init file, kept mapped while its lines are deserialized.
+struct init_file {
+    path file;
+    mp::mapped_file mapping;
+
+    /// @brief The files next to the Init file by lowercase filename,
+    /// so that resolving a texture doesn't scan the directory again.
+    std::unordered_map<std::string, path> files;
+};
+
+/// @brief A category or definition line, and what it deserialized to.
+template <typename Init>
+struct init_entry {
+    const init_file *file;
+    int line;
+    bool is_category;
+    std::string_view text;
+
+    typename Init::category_type category;
+    std::unique_ptr<typename Init::def_type> def;
+
+    /// @brief Set if the line failed to parse or deserialize.
+    std::exception_ptr error;
+
+    /// @brief Set if an internal texture was not found; only raised
+    /// once the definition is known not to be a skipped duplicate.
+    std::exception_ptr texture_error;
+};
+
+struct tile_init {
+    using category_type = TileDefCategory;
+    using def_type = TileDef;
+
+    static constexpr const char *kind = "tile";
+
+    static TileDefCategory deser_category(const mp::Node *node) { return serde::deser_tiledef_category(node); }
+    static TileDef *deser_def(const mp::Node *node) { return serde::deser_tiledef(node); }
+
+    static const std::string &name(const TileDef &def) { return def.get_name(); }
+    static const TagSet &tags(const TileDef &def) { return def.get_tag_set(); }
+
+    static bool registered(const TileDex &dex, const std::string &name) { return dex.tile(name) != nullptr; }
+};
+
+struct prop_init {
+    using category_type = PropDefCategory;
+    using def_type = PropDef;
+
+    static constexpr const char *kind = "prop";
+
+    static PropDefCategory deser_category(const mp::Node *node) { return serde::deser_propdef_category(node); }
+    static PropDef *deser_def(const mp::Node *node) { return serde::deser_propdef(node); }
+
+    static const std::string &name(const PropDef &def) { return def.name; }
+    static const TagSet &tags(const PropDef &def) { return def.tag_set; }
+
+    static bool registered(const PropDex &dex, const std::string &name) { return dex.prop(name) != nullptr; }
+};
+
+std::string to_lower(std::string str) {
+    std::transform(str.begin(), str.end(), str.begin(), [](unsigned char c) { return std::tolower(c); });
+    return str;
 }
-const std::unordered_map<std::string, TileDef*> &TileDex::tiles() const noexcept { return _tiles; }
-const std::vector<TileDefCategory> &TileDex::categories() const noexcept { return _categories; }
-const std::vector<std::vector<TileDef*>> &TileDex::sorted_tiles() const noexcept { return _sorted_tiles; }
-const std::unordered_map<std::string, std::vector<TileDef*>> &TileDex::category_tiles() const noexcept { return _category_tiles; }
 
-void TileDex::register_from(path const&file, CastLibs const*libs) {
+template <typename Init>
+init_file open_init_file(const path &file) {
     if (!exists(file)) throw dex_error(std::string("file does not exist: "+file.string()));
 
-    path init_dir = file.parent_path();
-
-    std::ifstream init(file);
-    if (!init.is_open()) {
-        std::string msg("failed to open tile init file '");
-        msg.append(file.string());
-        msg.append("'");
+    return init_file{ file, mp::mapped_file(file), list_init_directory(file.parent_path()) };
+}
 
-        throw std::runtime_error(msg.c_str());
-    }
+/// @brief Phase one: splits an Init file into its category and definition
+/// lines, skipping blank lines and comments.
+template <typename Init>
+void split_init_file(const init_file &file, std::vector<init_entry<Init>> &entries) {
+    const char *cursor = file.mapping.begin();
+    const char *end = file.mapping.end();
 
-    int counter = 0;
-    TileDefCategory current_category = {"", Color{0}};
+    int line = 0;
     bool category_parsed = false;
 
-    while (init.peek() && init.peek() != EOF) {
-        counter++;
+    while (cursor != end) {
+        line++;
+
+        const char *start = cursor;
+        while (cursor != end && *cursor != '\n' && *cursor != '\r') cursor++;
 
-        while (init.peek() == '\n') init.get();
+        std::string_view text(start, cursor - start);
 
-        // category
-        if (init.peek() == '-') {
-            init.get();
+        if (cursor != end && *cursor++ == '\r' && cursor != end && *cursor == '\n') cursor++;
 
+        if (text.find_first_not_of(" \t") == std::string_view::npos) continue;
+
+        bool is_category = text.front() == '-';
+
+        if (is_category) {
             // Skip comments
-            if (init.peek() == '-') {
-                while (init.get() != '\n') {}
-                continue;
-            }
+            if (text.size() > 1 && text[1] == '-') continue;
+
+            text.remove_prefix(1);
+            category_parsed = true;
+        }
+        else if (!category_parsed) {
+            throw std::runtime_error(std::string("failed to parse ")+Init::kind+" init: must begin with a category");
+        }
+
+        auto &entry = entries.emplace_back();
+
+        entry.file = &file;
+        entry.line = line;
+        entry.is_category = is_category;
+        entry.text = text;
+    }
+}
+
+/// @brief Phase two: parses and deserializes a line, and resolves the
+/// definition's texture path.
+/// @note Never throws; failures are stored in the entry.
+template <typename Init>
+void deser_init_entry(
+    init_entry<Init> &entry,
+    mp::arena &nodes,
+    std::vector<mp::token_view> &tokens,
+    const CastLibs *libs
+) {
+    auto failure = [&](const char *stage, const char *reason) {
+        std::ostringstream msg;
+        msg 
+            << "failed to " << stage << ' ' << Init::kind
+            << (entry.is_category ? " init category" : " init")
+            << " at line " << entry.line
+            << " of '" << entry.file->file.string() << "': "
+            << reason;
+
+        return msg.str();
+    };
+
+    try {
+        const char *cursor = entry.text.data();
+        mp::tokenize_line(cursor, cursor + entry.text.size(), tokens);
+
+        nodes.reset();
+        auto *node = mp::parse(tokens, nodes);
+
+        if (entry.is_category) {
+            entry.category = Init::deser_category(node);
+            return;
+        }
+
+        entry.def.reset(Init::deser_def(node));
+    }
+    catch (mp::parse_failure &pe) {
+        // Definitions that fail to parse have always been reported as
+        // deserialization failures.
+        auto msg = failure("parse", pe.what());
+
+        entry.error = entry.is_category
+            ? std::make_exception_ptr(std::runtime_error(msg))
+            : std::make_exception_ptr(deserialization_failure(msg));
+        return;
+    }
+    catch (deserialization_failure &e) {
+        entry.error = std::make_exception_ptr(std::runtime_error(failure("deserialize", e.what())));
+        return;
+    }
+    catch (...) {
+        entry.error = std::current_exception();
+        return;
+    }
+
+    // Unsupported prop types deserialize to nothing.
+    if (!entry.def) return;
+
+    auto &def = *entry.def;
+    const auto &name = Init::name(def);
+
+    try {
+        if (Init::tags(def).has(tags::internal)) {
+            if (libs == nullptr) 
+                throw dex_error(
+                    std::string(Init::kind)+" '"+name+"' resource is internal but CastLibs* argument was nullptr"
+                );
 
             try {
-                auto tokens = mp::tokenize_line(init);
-                auto category_node = mp::parse(tokens);
-                auto category = mr::serde::deser_tiledef_category(category_node.get());
-            
-                _categories.push_back(category);
-                _category_tiles[category.name] = std::vector<TileDef*>();
-                _sorted_tiles.push_back(std::vector<TileDef*>());
-
-                current_category = category;
-                category_parsed = true;
-            } 
-            catch (mp::parse_failure &pe) {
-                std::ostringstream msg;
-                msg 
-                    << "failed to parse tile init category at line "
-                    << counter
-                    << ": "
-                    << pe.what();
-                
-                init.close();
-
-                throw std::runtime_error(msg.str());
-            } 
-            catch (deserialization_failure &e) {
-                std::ostringstream msg;
-                msg 
-                    << "failed to deserialize tile init category at line "
-                    << counter
-                    << ": "
-                    << e.what();
-                
-                init.close();
-
-                throw std::runtime_error(msg.str());
+                auto *member = libs->member_or_throw(name);
+                def.set_texture_path(member->get_texture_path());
+            } catch (std::runtime_error &e) {
+                throw dex_error(
+                    std::string(Init::kind)+" '"+name+"' internal resouce was not found"
+                );
             }
         }
-        // tile
         else {
-            if (!category_parsed) {
-                init.close();
-                throw std::runtime_error("failed to parse tile init: must begin with a category");
-            }
-        
-            std::vector<mp::token> tokens;
-            if (!mp::tokenize_line(init, tokens)) break;
+            def.set_texture_path(resolve_init_texture(entry.file->file.parent_path(), entry.file->files, name));
+        }
+    }
+    catch (...) {
+        entry.texture_error = std::current_exception();
+    }
+}
 
-            try {
-                auto def_node = mp::parse(tokens);
-                auto tiledef = mr::serde::deser_tiledef(def_node.get());
+template <typename Init>
+void deser_init_entries(std::vector<init_entry<Init>> &entries, const CastLibs *libs) {
+    // Lines are handed out in small batches, since a line
+    // may take anywhere from a few to thousands of tokens.
+    constexpr size_t batch = 32;
 
-                if (_tiles.find(tiledef->get_name()) != _tiles.end()) {
+    std::atomic<size_t> next{0};
 
-                    #ifdef IS_DEBUG_BUILD
-                    std::cout << "Warning: skipped duplicate tile definition \"" << tiledef->get_name() << '"' << std::endl;
-                    #endif
-                    
-                    continue;
+    auto work = [&]() {
+        mp::arena nodes;
+        std::vector<mp::token_view> tokens;
 
-                    // init.close();
-                    // std::ostringstream msg;
-                    // msg 
-                    //     << "duplicate tile definition at line " 
-                    //     << counter 
-                    //     << " '" 
-                    //     << tiledef->get_name() 
-                    //     << "'";
-                    // throw dex_error(msg.str());
-                }
+        for (size_t begin; (begin = next.fetch_add(batch)) < entries.size();) {
+            size_t end = std::min(begin + batch, entries.size());
 
-                auto &tags = tiledef->get_tags();
-
-                if (tags.find("INTERNAL") != tags.end()) {
-                    if (libs == nullptr) 
-                        throw dex_error(
-                            std::string("tile '"+tiledef->get_name()+"' resource is internal but CastLibs* argument was nullptr")
-                        );
-                
-                    try {
-                        auto *member = libs->member_or_throw(tiledef->get_name());
-                        tiledef->set_texture_path(member->get_texture_path());
-                    } catch (std::runtime_error &e) {
-                        throw dex_error(
-                            std::string("tile '"+tiledef->get_name()+"' internal resouce was not found")
-                        );
-                    }
-                } 
-                else {
-                    #if defined(__linux__) || defined(__APPLE__)
-                    auto texture_path = init_dir / (tiledef->get_name() + ".png");
-                    mr::utils::find_file_case_insensitive(texture_path);
-                    tiledef->set_texture_path(texture_path);
-                    #else
-                    tiledef->set_texture_path(init_dir / (tiledef->get_name() + ".png"));
-                    #endif
-                }
+            for (size_t i = begin; i < end; i++) 
+                deser_init_entry<Init>(entries[i], nodes, tokens, libs);
+        }
+    };
 
-                tiledef->set_category(current_category.name);
-                tiledef->set_color(current_category.color);
+    size_t workers = std::min<size_t>(
+        std::max(1u, std::thread::hardware_concurrency()),
+        (entries.size() + batch - 1) / batch
+    );
 
-                _tiles[tiledef->get_name()] = tiledef;
-                _sorted_tiles[_categories.size() - 1].push_back(tiledef);
-                _category_tiles[current_category.name].push_back(tiledef);
-            }
-            catch (mp::parse_failure &pe) {
-                std::ostringstream msg;
-                msg 
-                    << "failed to parse tile init at line "
-                    << counter
-                    << ": "
-                    << pe.what();
-                
-                init.close();
-
-                throw deserialization_failure(msg.str());
-            }
-            catch (deserialization_failure &e) {
-                std::ostringstream msg;
-                msg 
-                    << "failed to deserialize tile init at line "
-                    << counter
-                    << ": "
-                    << e.what();
-                
-                init.close();
-
-                throw std::runtime_error(msg.str());
-            }
+    std::vector<std::future<void>> helpers;
+    for (size_t i = 1; i < workers; i++) helpers.push_back(std::async(std::launch::async, work));
+
+    work();
+
+    for (auto &helper : helpers) helper.get();
+}
+
+/// @brief Registers Init files into a dex.
+/// @note The failure thrown is the one a line by line
+/// registration would have run into first.
+template <typename Init, typename Dex>
+void register_init_files(Dex &dex, const std::vector<path> &files, const CastLibs *libs) {
+    std::vector<init_file> inits;
+    inits.reserve(files.size());
+
+    for (const auto &file : files) {
+        try {
+            inits.push_back(open_init_file<Init>(file));
+        } catch (mp::mapping_failure &) {
+            throw std::runtime_error(std::string("failed to open ")+Init::kind+" init file '"+file.string()+"'");
         }
     }
 
-    init.close();
+    std::vector<init_entry<Init>> entries;
+    for (const auto &init : inits) split_init_file<Init>(init, entries);
+
+    deser_init_entries<Init>(entries, libs);
+
+    for (auto &entry : entries) {
+        if (entry.error) std::rethrow_exception(entry.error);
+
+        if (entry.is_category) {
+            dex.add_category(entry.category);
+            continue;
+        }
+
+        if (!entry.def) continue;
+
+        if (Init::registered(dex, Init::name(*entry.def))) {
+
+            #ifdef IS_DEBUG_BUILD
+            std::cout << "Warning: skipped duplicate " << Init::kind << " definition \"" << Init::name(*entry.def) << '"' << std::endl;
+            #endif
+
+            continue;
+        }
+
+        if (entry.texture_error) std::rethrow_exception(entry.texture_error);
+
+        dex.add(entry.def.release());
+    }
+}
+
+/// @brief Indexes a tile or a material by its interned name, so that
+/// cells resolve to it; a later definition takes over the name.
+template <typename Def>
+void index_name(std::vector<Def*> &named, Def *def) {
+    const auto name = intern_tile_name(def->get_name());
+
+    if (name >= named.size()) named.resize(static_cast<size_t>(name) + 1, nullptr);
+    named[name] = def;
+}
+
+}; // namespace
+
+std::unordered_map<std::string, path> list_init_directory(path const &directory) {
+    std::unordered_map<std::string, path> files;
+
+    #if defined(__linux__) || defined(__APPLE__)
+    for (const auto &entry : std::filesystem::directory_iterator(directory)) {
+        if (entry.is_regular_file()) files[to_lower(entry.path().filename().string())] = entry.path();
+    }
+    #endif
+
+    return files;
+}
+
+path resolve_init_texture(
+    path const &directory,
+    std::unordered_map<std::string, path> const &files,
+    std::string const &name
+) {
+    auto texture_path = directory / (name + ".png");
+
+    auto texture = files.find(to_lower(texture_path.filename().string()));
+    if (texture != files.end()) texture_path = texture->second;
+
+    return texture_path;
+}
+
+TileDef *TileDex::tile(const std::string &name) const noexcept { return _tiles.find(name); }
+const std::vector<TileDef*> &TileDex::tiles() const noexcept { return _tiles.defs(); }
+const std::vector<TileDefCategory> &TileDex::categories() const noexcept { return _tiles.categories(); }
+const std::vector<std::vector<TileDef*>> &TileDex::sorted_tiles() const noexcept { return _tiles.sorted(); }
+const std::unordered_map<std::string, std::vector<TileDef*>> &TileDex::category_tiles() const noexcept { return _tiles.category_defs(); }
+
+void TileDex::register_from(path const&file, CastLibs const*libs) {
+    register_from(std::vector<path>{ file }, libs);
+}
+
+void TileDex::register_from(std::vector<path> const&files, CastLibs const*libs) {
+    register_init_files<tile_init>(*this, files, libs);
+}
+
+void TileDex::add_category(const TileDefCategory &category) {
+    _tiles.add_category(category);
+}
+
+void TileDex::add(TileDef *tiledef) {
+    const auto &category = _tiles.categories().back();
+
+    tiledef->set_category(category.name);
+    tiledef->set_color(category.color);
+
+    _tiles.add(tiledef, tiledef->get_name());
+    index_name(_named, tiledef);
 }
 
 void TileDex::unload_textures() {
-    for (auto pair : _tiles) pair.second->unload_texture();
+    for (auto *def : _tiles.defs()) def->unload_texture();
 }
 
 void TileDex::unload_all() {
-    for (auto def : _tiles) delete def.second;
-
     _tiles.clear();
-    _categories.clear();
-    _sorted_tiles.clear();
-    _category_tiles.clear();
+    _named.clear();
 }
 
 
-TileDex::TileDex() : _tiles({}), _category_tiles({}) {}
+TileDex::TileDex() {}
 
 TileDex::~TileDex() {
     unload_all();
@@ -224,8 +406,7 @@ TileDex::~TileDex() {
 // Material dex
 
 void MaterialDex::unload_textures() {
-    for (auto &pair : _materials) {
-        MaterialDef *m = pair.second;
+    for (auto *m : _materials.defs()) {
         if (m->get_type() != MaterialRenderType::custom_unified) continue;
 
         CustomMaterialDef *cm = dynamic_cast<CustomMaterialDef *>(m);
@@ -295,248 +476,65 @@ void MaterialDex::load_internals() {
         new MaterialDef("Dune Sand",            "Community Materials", Color{255, 255, 100, 255}, MaterialRenderType::tiles),
     };
 
-    _categories.reserve(3);
-    _sorted_materials.reserve(3);
+    _materials.add_category("Materials");
+    for (auto *def : materials) _add(def);
 
-    _categories.push_back("Materials");
-    std::vector<MaterialDef*> mats_vec;
-    mats_vec.reserve(22);
-    for (auto *def : materials) {
-        _materials[def->get_name()] = def;
-        mats_vec.push_back(def);
-    }
-    _sorted_materials.push_back(mats_vec);
-    _category_materials["Materials"] = mats_vec;
-
-    _categories.push_back("Drought Materials");
-    std::vector<MaterialDef*> drought_vec;
-    drought_vec.reserve(17);
-    for (auto *def : drought_materials) {
-        _materials[def->get_name()] = def;
-        drought_vec.push_back(def);
-    }
-    _sorted_materials.push_back(drought_vec);
-    _category_materials["Drought Materials"] = drought_vec;
-
-    _categories.push_back("Community Materials");
-    std::vector<MaterialDef*> community_vec;
-    community_vec.reserve(10);
-    for (auto *def : community_materials) {
-        _materials[def->get_name()] = def;
-        community_vec.push_back(def);
-    }
-    _sorted_materials.push_back(community_vec);
-    _category_materials["Community Materials"] = community_vec;
-}
+    _materials.add_category("Drought Materials");
+    for (auto *def : drought_materials) _add(def);
 
-MaterialDex::~MaterialDex() {
-    for (auto &pair : _materials) delete pair.second;
+    _materials.add_category("Community Materials");
+    for (auto *def : community_materials) _add(def);
 }
 
-MaterialDex::MaterialDex() {}
-
-PropDef *PropDex::prop(const std::string &name) const noexcept {
-    auto prop_iter = _props.find(name);
-    if (prop_iter == _props.end()) return nullptr;
-    return prop_iter->second;
+void MaterialDex::_add(MaterialDef *def) {
+    _materials.add(def, def->get_name());
+    index_name(_named, def);
 }
 
-const std::unordered_map<std::string, PropDef*> &PropDex::props() const noexcept {
-    return _props;
-}
+MaterialDex::~MaterialDex() {}
 
-const std::vector<PropDefCategory> &PropDex::categories() const noexcept {
-    return _categories;
-}
-
-const std::vector<std::vector<PropDef*>> &PropDex::sorted_props() const noexcept {
-    return _sorted_props;
-}
+MaterialDex::MaterialDex() {}
 
-const std::unordered_map<std::string, std::vector<PropDef*>> &PropDex::category_props() const noexcept {
-    return _category_props;
-}
+PropDef *PropDex::prop(const std::string &name) const noexcept { return _props.find(name); }
+const std::vector<PropDef*> &PropDex::props() const noexcept { return _props.defs(); }
+const std::vector<PropDefCategory> &PropDex::categories() const noexcept { return _props.categories(); }
+const std::vector<std::vector<PropDef*>> &PropDex::sorted_props() const noexcept { return _props.sorted(); }
+const std::unordered_map<std::string, std::vector<PropDef*>> &PropDex::category_props() const noexcept { return _props.category_defs(); }
 
 TileDef *PropDex::tile(const std::string &name) const noexcept {
-    auto iter = _tiles.find(name);
-    if (iter == _tiles.end()) return nullptr;
-    return iter->second;
+    if (_tile_dex == nullptr) return nullptr;
+
+    auto *tile = _tile_dex->tile(name);
+    return tile != nullptr && is_tile_prop(tile->get_id()) ? tile : nullptr;
 }
-const std::unordered_map<std::string, TileDef*> &PropDex::tiles() const noexcept { return _tiles; }
 const std::vector<TileDefCategory> &PropDex::tile_categories() const noexcept { return _tile_categories; }
 const std::vector<std::vector<TileDef*>> &PropDex::sorted_tiles() const noexcept { return _sorted_tiles; }
-const std::unordered_map<std::string, std::vector<TileDef*>> &PropDex::category_tiles() const noexcept { return _category_tiles; }
 
 void PropDex::register_from(std::filesystem::path const &file, CastLibs const *libs) {
-    if (!exists(file)) throw dex_error(std::string("file does not exist: "+file.string()));
-
-    path init_dir = file.parent_path();
-
-    std::ifstream init(file);
-    if (!init.is_open()) {
-        std::string msg("failed to open tile init file '");
-        msg.append(file.string());
-        msg.append("'");
-
-        throw std::runtime_error(msg.c_str());
-    }
-
-    int counter = 0;
-    PropDefCategory current_category = {"", Color{0}};
-    bool category_parsed = false;
-
-
-    while (init.peek() && init.peek() != EOF) {
-        counter++;
-
-        while (init.peek() == '\n') { counter++; init.get();}
-
-        // category
-        if (init.peek() == '-') {
-            init.get();
-
-            // Skip comments
-            if (init.peek() == '-') {
-                while (init.get() != '\n') {}
-                continue;
-            }
-
-            try {
-                auto tokens = mp::tokenize_line(init);
-                auto category_node = mp::parse(tokens);
-                auto category = mr::serde::deser_propdef_category(category_node.get());
-            
-                _categories.push_back(category);
-                _category_props[category.name] = std::vector<PropDef*>();
-                _sorted_props.push_back(std::vector<PropDef*>());
-
-                current_category = category;
-                category_parsed = true;
-            } 
-            catch (mp::parse_failure &pe) {
-                std::ostringstream msg;
-                msg 
-                    << "failed to parse prop init category at line "
-                    << counter
-                    << ": "
-                    << pe.what();
-                
-                init.close();
-
-                throw std::runtime_error(msg.str());
-            } 
-            catch (deserialization_failure &e) {
-                std::ostringstream msg;
-                msg 
-                    << "failed to deserialize prop init category at line "
-                    << counter
-                    << ": "
-                    << e.what();
-                
-                init.close();
-
-                throw std::runtime_error(msg.str());
-            }
-        }
-        // prop
-        else {
-            if (!category_parsed) {
-                init.close();
-                throw std::runtime_error("failed to parse prop init: must begin with a category");
-            }
-        
-            std::vector<mp::token> tokens;
-            if (!mp::tokenize_line(init, tokens)) break;
-
-            try {
-                auto def_node = mp::parse(tokens);
-                auto propdef = mr::serde::deser_propdef(def_node.get());
-
-                if (_props.find(propdef->name) != _props.end()) {
-                    
-                    #ifdef IS_DEBUG_BUILD
-                    std::cout << "Warning: skipped duplicate prop definition \"" << propdef->name << '"' << std::endl;
-                    #endif
+    register_from(std::vector<path>{ file }, libs);
+}
 
-                    continue;
+void PropDex::register_from(std::vector<path> const &files, CastLibs const *libs) {
+    register_init_files<prop_init>(*this, files, libs);
+}
 
-                    // init.close();
-                    // std::ostringstream msg;
-                    // msg 
-                    //     << "duplicate tile definition at line " 
-                    //     << counter 
-                    //     << " '" 
-                    //     << tiledef->get_name() 
-                    //     << "'";
-                    // throw dex_error(msg.str());
-                }
+void PropDex::add_category(const PropDefCategory &category) {
+    _props.add_category(category);
+}
 
-                auto &tags = propdef->tags;
-
-                if (tags.find("INTERNAL") != tags.end()) {
-                    if (libs == nullptr) 
-                        throw dex_error(
-                            std::string("prop '"+propdef->name+"' resource is internal but CastLibs* argument was nullptr")
-                        );
-                
-                    try {
-                        auto *member = libs->member_or_throw(propdef->name);
-                        propdef->set_texture_path(member->get_texture_path());
-                    } catch (std::runtime_error &e) {
-                        throw dex_error(
-                            std::string("prop '"+propdef->name+"' internal resouce was not found")
-                        );
-                    }
-                } 
-                else {
-
-                    #if defined(__linux__) || defined(__APPLE__)
-                    auto texture_path = init_dir / (propdef->name + ".png");
-                    mr::utils::find_file_case_insensitive(texture_path);
-                    propdef->set_texture_path(texture_path);
-                    #else
-                    propdef->set_texture_path(init_dir / (propdef->name + ".png"));
-                    #endif
-                }
+void PropDex::add(PropDef *propdef) {
+    const auto &category = _props.categories().back();
 
-                propdef->set_category(current_category.name);
-                propdef->set_color(current_category.color);
+    propdef->set_category(category.name);
+    propdef->set_color(category.color);
 
-                _props[propdef->name] = propdef;
-                _sorted_props[_categories.size() - 1].push_back(propdef);
-                _category_props[current_category.name].push_back(propdef);
-            }
-            catch (mp::parse_failure &pe) {
-                std::ostringstream msg;
-                msg 
-                    << "failed to parse prop init at line "
-                    << counter
-                    << ": "
-                    << pe.what();
-                
-                init.close();
-
-                throw deserialization_failure(msg.str());
-            }
-            catch (deserialization_failure &e) {
-                std::ostringstream msg;
-                msg 
-                    << "failed to deserialize prop init at line "
-                    << counter
-                    << ": "
-                    << e.what();
-                
-                init.close();
-
-                throw std::runtime_error(msg.str());
-            }
-        }
-    }
-
-    init.close();
+    _props.add(propdef, propdef->name);
 }
 
 void PropDex::register_tiles(const TileDex *dex) {
+    _tile_dex = dex;
+    _tile_props.assign(dex->tiles().size(), false);
+
     for (size_t c = 0; c < dex->categories().size(); c++) {
         const auto &category = dex->categories()[c];
         const auto &tiles = dex->sorted_tiles()[c];
@@ -546,8 +544,7 @@ void PropDex::register_tiles(const TileDex *dex) {
         for (size_t t = 0; t < tiles.size(); t++) {
             auto *tile = tiles[t];
 
-            const auto prop_iter = _props.find(tile->get_name());
-            if (prop_iter != _props.end()) 
+            if (_props.find(tile->get_name()) != nullptr) 
             {
                 #ifdef IS_DEBUG_BUILD
                 std::cout 
@@ -560,13 +557,8 @@ void PropDex::register_tiles(const TileDex *dex) {
                 continue;
             }
 
-            const auto &tags = tile->get_tags();
-
-            auto not_trash_flag = tags.find("notTrashProp");
-            auto not_prop_flag = tags.find("notProp");
-
-            if (tile->get_type() == TileDefType::voxel_struct && not_prop_flag == tags.end() && not_prop_flag == tags.end()) {
-                if (_tiles.find(tile->get_name()) != _tiles.end())
+            if (tile->get_type() == TileDefType::voxel_struct && !tile->has_tag(tags::not_prop)) {
+                if (this->tile(tile->get_name()) != nullptr)
                 {
                     #ifdef IS_DEBUG_BUILD
                     std::cout << "Warning: skipped duplicate tile-as-prop definition \"" << tile->get_name() << '"' << std::endl;
@@ -575,39 +567,32 @@ void PropDex::register_tiles(const TileDex *dex) {
                     continue;
                 }
 
-                _tiles[tile->get_name()] = tile;
+                _tile_props[tile->get_id()] = true;
                 tiles_as_props.push_back(tile);
             }
         }
 
         if (!tiles_as_props.empty()) {
             _tile_categories.push_back(category);
-            _category_tiles[category.name] = tiles_as_props;
             _sorted_tiles.push_back(tiles_as_props);
         }
     }
-
-    
 }
 
 void PropDex::unload_textures() {
-    for (auto &pair : _props) pair.second->unload_texture();
+    for (auto *def : _props.defs()) def->unload_texture();
 }
 
 void PropDex::unload_all() {
-    for (auto &pair : _props) delete pair.second;
-
     _props.clear();
-    _categories.clear();
-    _sorted_props.clear();
-    _category_props.clear();
-    _tiles.clear();
+
+    _tile_dex = nullptr;
+    _tile_props.clear();
     _tile_categories.clear();
     _sorted_tiles.clear();
-    _category_tiles.clear();
 }
 
-PropDex::PropDex() {}
+PropDex::PropDex() : _tile_dex(nullptr) {}
 PropDex::~PropDex() {
     unload_all();
 }
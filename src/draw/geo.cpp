@@ -490,13 +490,10 @@ void draw_geo_layer(
   if (layer > 2) return;
   if (color.a == 0) return;
 
-  for (uint16_t x = 0; x < matrix.get_width(); x++) {
-    for (uint16_t y = 0; y < matrix.get_height(); y++) {
-      auto cell1 = matrix.get_copy(x, y, layer);
-
-      draw_mtx_geo_type(cell1, x, y, scale, color);
-    }
-  }
+  // Cells don't overlap, so they're drawn in storage order.
+  matrix.view().for_each(layer, [&](matrix_t x, matrix_t y, const GeoCell &cell) {
+    draw_mtx_geo_type(cell, x, y, scale, color);
+  });
 }
 
 void draw_geo_layer(
@@ -509,13 +506,7 @@ void draw_geo_layer(
   if (layer > 2) return;
   if (color.a == 0) return;
 
-  for (uint16_t x = 0; x < matrix->get_width(); x++) {
-    for (uint16_t y = 0; y < matrix->get_height(); y++) {
-      auto cell1 = matrix->get_copy(x, y, layer);
-
-      draw_mtx_geo_type(cell1, x, y, scale, color);
-    }
-  }
+  draw_geo_layer(*matrix, layer, color, scale);
 }
 
 void draw_geo_and_poles_layer(
@@ -527,18 +518,15 @@ void draw_geo_and_poles_layer(
   if (layer > 2) return;
   if (color.a == 0) return;
 
-  for (uint16_t x = 0; x < matrix.get_width(); x++) {
-    for (uint16_t y = 0; y < matrix.get_height(); y++) {
-      auto cell1 = matrix.get_copy(x, y, layer);
-
-      draw_mtx_geo_type(cell1, x, y, scale, color);
-      draw_mtx_geo_poles(cell1, x, y, scale, color);
-    }
-  }
+  matrix.view().for_each(layer, [&](matrix_t x, matrix_t y, const GeoCell &cell) {
+    draw_mtx_geo_type(cell, x, y, scale, color);
+    draw_mtx_geo_poles(cell, x, y, scale, color);
+  });
 }
 
 void draw_geo_features_layer(
   Matrix<GeoCell> const& matrix, 
+  GeoFeaturePlanes const &planes,
   const GE_Textures &atlas,
   uint8_t layer,
   Color color, 
@@ -547,17 +535,29 @@ void draw_geo_features_layer(
   if (layer > 2) return;
   if (color.a == 0) return;
 
-  for (uint16_t x = 0; x < matrix.get_width(); x++) {
-    for (uint16_t y = 0; y < matrix.get_height(); y++) {
-      auto cell1 = matrix.get_copy(x, y, 0);
-
-      draw_mtx_geo_features(cell1, x, y, 20, BLACK, atlas);
-    }
-  }
+  // The features drawn by draw_mtx_geo_features().
+  static const GeoFeature drawn = 
+    GeoFeature::shortcut_path |
+    GeoFeature::bathive |
+    GeoFeature::forbid_fly_chains |
+    GeoFeature::worm_grass |
+    GeoFeature::place_rock |
+    GeoFeature::place_spear |
+    GeoFeature::waterfall |
+    GeoFeature::room_entrance |
+    GeoFeature::garbage_worm_hole |
+    GeoFeature::scavenger_hole |
+    GeoFeature::dragon_den |
+    GeoFeature::wack_a_mole_hole;
+
+  planes.for_each(drawn, layer, [&](matrix_t x, matrix_t y) {
+    draw_mtx_geo_features(matrix.get_copy(x, y, layer), x, y, scale, color, atlas);
+  });
 }
 
 void draw_geo_cracked(
   Matrix<GeoCell> const &matrix, 
+  GeoFeaturePlanes const &planes,
   GE_Textures &atlas, 
   uint8_t layer, 
   Color color, 
@@ -568,183 +568,179 @@ void draw_geo_cracked(
   static const uint8_t cright  =  8;
   static const uint8_t cbottom = 16;
 
-  for (matrix_t x = 0; x < matrix.get_width(); x++) {
-    for (matrix_t y = 0; y < matrix.get_height(); y++) {
-      const auto &cell = matrix.get_const(x, y, layer);
-      
-      if (!cell.has_feature(GeoFeature::cracked_terrain)) continue;
-      if (cell.is_air()) continue;
+  if (layer > 2) return;
 
-      const auto *left = matrix.get_const_ptr(x - 1, y, layer);
-      const auto *top = matrix.get_const_ptr(x, y - 1, layer);
-      const auto *right = matrix.get_const_ptr(x + 1, y, layer);
-      const auto *bottom = matrix.get_const_ptr(x, y + 1, layer);
-      
-      // 00000000 none
-      // 00000001 left
-      // 00000010 top
-      // 00000100 right
-      // 00001000 bottom
-      uint8_t conn = 0;
-
-      if (left != nullptr && left->is_air()) conn |= cleft;
-      if (top != nullptr && top->is_air()) conn |= ctop;
-      if (right != nullptr && right->is_air()) conn |= cright;
-      if (bottom != nullptr && bottom->is_air()) conn |= cbottom;
-
-      if (left != nullptr   && left->is_solid() && left->has_feature(GeoFeature::cracked_terrain))     conn |= cleft;
-      if (top != nullptr    && top->is_solid() && top->has_feature(GeoFeature::cracked_terrain))       conn |= ctop;
-      if (right != nullptr  && right->is_solid() && right->has_feature(GeoFeature::cracked_terrain))   conn |= cright;
-      if (bottom != nullptr && bottom->is_solid() && bottom->has_feature(GeoFeature::cracked_terrain)) conn |= cbottom;
-
-      auto iter = atlas.cracked_map().find(conn);
-      if (iter == atlas.cracked_map().end()) continue;
-
-      auto *texture = iter->second;
-
-      if (texture != nullptr) DrawTexturePro(
-        *texture,
-        Rectangle { 
-          0, 
-          0, 
-          static_cast<float>(texture->width), 
-          static_cast<float>(texture->height) 
-        },
-        Rectangle {
-          x * scale,
-          y * scale,
-          scale,
-          scale
-        },
-        Vector2 {0, 0},
-        0,
-        color
-      );
-    }
-  }
+  planes.for_each(GeoFeature::cracked_terrain, layer, [&](matrix_t x, matrix_t y) {
+    const auto &cell = matrix.get_const(x, y, layer);
+    
+    if (cell.is_air()) return;
+
+    const auto *left = matrix.get_const_ptr(x - 1, y, layer);
+    const auto *top = matrix.get_const_ptr(x, y - 1, layer);
+    const auto *right = matrix.get_const_ptr(x + 1, y, layer);
+    const auto *bottom = matrix.get_const_ptr(x, y + 1, layer);
+    
+    // 00000000 none
+    // 00000001 left
+    // 00000010 top
+    // 00000100 right
+    // 00001000 bottom
+    uint8_t conn = 0;
+
+    if (left != nullptr && left->is_air()) conn |= cleft;
+    if (top != nullptr && top->is_air()) conn |= ctop;
+    if (right != nullptr && right->is_air()) conn |= cright;
+    if (bottom != nullptr && bottom->is_air()) conn |= cbottom;
+
+    if (left != nullptr   && left->is_solid() && planes.test(GeoFeature::cracked_terrain, x - 1, y, layer))   conn |= cleft;
+    if (top != nullptr    && top->is_solid() && planes.test(GeoFeature::cracked_terrain, x, y - 1, layer))    conn |= ctop;
+    if (right != nullptr  && right->is_solid() && planes.test(GeoFeature::cracked_terrain, x + 1, y, layer))  conn |= cright;
+    if (bottom != nullptr && bottom->is_solid() && planes.test(GeoFeature::cracked_terrain, x, y + 1, layer)) conn |= cbottom;
+
+    auto iter = atlas.cracked_map().find(conn);
+    if (iter == atlas.cracked_map().end()) return;
+
+    auto *texture = iter->second;
+
+    if (texture != nullptr) DrawTexturePro(
+      *texture,
+      Rectangle { 
+        0, 
+        0, 
+        static_cast<float>(texture->width), 
+        static_cast<float>(texture->height) 
+      },
+      Rectangle {
+        x * scale,
+        y * scale,
+        scale,
+        scale
+      },
+      Vector2 {0, 0},
+      0,
+      color
+    );
+  });
 }
 
-void draw_geo_entrances(Matrix<GeoCell> const &matrix, GE_Textures &atlas, Color color, float scale) {
-  uint8_t holes, dots;
-  size_t connx, conny;
+void draw_geo_entrances(Matrix<GeoCell> const &matrix, GeoFeaturePlanes const &planes, GE_Textures &atlas, Color color, float scale) {
   const auto &loose_texture = atlas.entry_loose();
 
-  for (size_t x = 0; x < matrix.get_width(); x++) {
-    for (size_t y = 0; y < matrix.get_height(); y++) {
-      const auto &cell = matrix.get_const(x, y, 0);
+  planes.for_each(GeoFeature::shortcut_entrance, 0, [&](matrix_t x, matrix_t y) {
+    uint8_t holes, dots;
+    int connx, conny;
 
-      if (!cell.has_feature(GeoFeature::shortcut_entrance)) continue;
-    
-      // Cell must only have the entrance feature.
-      if (cell.features != GeoFeature::shortcut_entrance) goto disconnected;
-      // Cell ID must be 7.
-      if (cell.type != GeoType::shortcut_entrance) goto disconnected;
-
-      // Cell must only have one opening and connect to one path.
-      holes = dots = connx = conny = 0;
-      for (int xx = -1; xx < 2; xx++) {
-        for (int yy = -1; yy < 2; yy++) {
-
-          // Ignore the middle cell.
-          if (xx == 0 && yy == 0) continue;
-
-          // The cell must not be out of bounds.
-          const auto *neighbor = matrix.get_const_ptr(x + xx, y + yy, 0);
-          if (neighbor == nullptr) goto disconnected;
-        
-          // The cell must have exactly one hole.
-          if (neighbor->type != GeoType::solid && ++holes > 1) goto disconnected;
-
-          if ( 
-              neighbor->has_feature(GeoFeature::shortcut_path) ||
-              neighbor->has_feature(GeoFeature::dragon_den) ||
-              neighbor->has_feature(GeoFeature::scavenger_hole) ||
-              neighbor->has_feature(GeoFeature::room_entrance) ||
-              neighbor->has_feature(GeoFeature::wack_a_mole_hole)
+    const auto &cell = matrix.get_const(x, y, 0);
+
+    // Cell must only have the entrance feature.
+    if (cell.features != GeoFeature::shortcut_entrance) goto disconnected;
+    // Cell ID must be 7.
+    if (cell.type != GeoType::shortcut_entrance) goto disconnected;
+
+    // Cell must only have one opening and connect to one path.
+    holes = dots = connx = conny = 0;
+    for (int xx = -1; xx < 2; xx++) {
+      for (int yy = -1; yy < 2; yy++) {
+
+        // Ignore the middle cell.
+        if (xx == 0 && yy == 0) continue;
+
+        // The cell must not be out of bounds.
+        const auto *neighbor = matrix.get_const_ptr(x + xx, y + yy, 0);
+        if (neighbor == nullptr) goto disconnected;
+      
+        // The cell must have exactly one hole.
+        if (neighbor->type != GeoType::solid && ++holes > 1) goto disconnected;
+
+        if ( 
+            neighbor->has_feature(GeoFeature::shortcut_path) ||
+            neighbor->has_feature(GeoFeature::dragon_den) ||
+            neighbor->has_feature(GeoFeature::scavenger_hole) ||
+            neighbor->has_feature(GeoFeature::room_entrance) ||
+            neighbor->has_feature(GeoFeature::wack_a_mole_hole)
+        ) {
+          if (
+            ( 
+              (xx ==  0 && yy == -1) || 
+              (xx == -1 && yy ==  0) ||
+              (xx ==  1 && yy ==  0) ||
+              (xx ==  0 && yy ==  1)
+            )
           ) {
-            if (
-              ( 
-                (xx ==  0 && yy == -1) || 
-                (xx == -1 && yy ==  0) ||
-                (xx ==  1 && yy ==  0) ||
-                (xx ==  0 && yy ==  1)
-              )
-            ) {
-              if (++dots > 1) goto disconnected;
-            
-              // Track the direction of the connection.
-              connx = xx;
-              conny = yy;            
-            } else goto disconnected;
-          }
+            if (++dots > 1) goto disconnected;
+          
+            // Track the direction of the connection.
+            connx = xx;
+            conny = yy;            
+          } else goto disconnected;
         }
       }
+    }
 
-      if (holes <= 0) goto disconnected;
-
-      if (dots == 1) {
-
-        // Success
-        if (connx ==  0 && conny == -1) { // top
-          const auto &texture = atlas.entry_top();
-          DrawTexturePro(
-            texture,
-            Rectangle{0, 0, static_cast<float>(loose_texture.width), static_cast<float>(loose_texture.height)},
-            Rectangle{x * scale, y * scale, scale, scale},
-            Vector2{0, 0},
-            0,
-            color
-          );
-        } else if (connx == -1 && conny ==  0) { // left
-          const auto &texture = atlas.entry_left();
-          DrawTexturePro(
-            texture,
-            Rectangle{0, 0, static_cast<float>(loose_texture.width), static_cast<float>(loose_texture.height)},
-            Rectangle{x * scale, y * scale, scale, scale},
-            Vector2{0, 0},
-            0,
-            color
-          );
-        } else if (connx ==  1 && conny ==  0) { // right
-          const auto &texture = atlas.entry_right();
-          DrawTexturePro(
-            texture,
-            Rectangle{0, 0, static_cast<float>(loose_texture.width), static_cast<float>(loose_texture.height)},
-            Rectangle{x * scale, y * scale, scale, scale},
-            Vector2{0, 0},
-            0,
-            color
-          );
-        } else if (connx ==  0 && conny ==  1) { // bottom
-          const auto &texture = atlas.entry_bottom();
-          DrawTexturePro(
-            texture,
-            Rectangle{0, 0, static_cast<float>(loose_texture.width), static_cast<float>(loose_texture.height)},
-            Rectangle{x * scale, y * scale, scale, scale},
-            Vector2{0, 0},
-            0,
-            color
-          );
-        } else goto disconnected;
-
-        continue;
-      }
+    if (holes <= 0) goto disconnected;
+
+    if (dots == 1) {
 
-      disconnected:
-      {
+      // Success
+      if (connx ==  0 && conny == -1) { // top
+        const auto &texture = atlas.entry_top();
+        DrawTexturePro(
+          texture,
+          Rectangle{0, 0, static_cast<float>(loose_texture.width), static_cast<float>(loose_texture.height)},
+          Rectangle{x * scale, y * scale, scale, scale},
+          Vector2{0, 0},
+          0,
+          color
+        );
+      } else if (connx == -1 && conny ==  0) { // left
+        const auto &texture = atlas.entry_left();
         DrawTexturePro(
-          loose_texture,
+          texture,
           Rectangle{0, 0, static_cast<float>(loose_texture.width), static_cast<float>(loose_texture.height)},
           Rectangle{x * scale, y * scale, scale, scale},
           Vector2{0, 0},
           0,
           color
         );
+      } else if (connx ==  1 && conny ==  0) { // right
+        const auto &texture = atlas.entry_right();
+        DrawTexturePro(
+          texture,
+          Rectangle{0, 0, static_cast<float>(loose_texture.width), static_cast<float>(loose_texture.height)},
+          Rectangle{x * scale, y * scale, scale, scale},
+          Vector2{0, 0},
+          0,
+          color
+        );
+      } else if (connx ==  0 && conny ==  1) { // bottom
+        const auto &texture = atlas.entry_bottom();
+        DrawTexturePro(
+          texture,
+          Rectangle{0, 0, static_cast<float>(loose_texture.width), static_cast<float>(loose_texture.height)},
+          Rectangle{x * scale, y * scale, scale, scale},
+          Vector2{0, 0},
+          0,
+          color
+        );
+      } else goto disconnected;
 
-        continue;
-      }
+      return;
     }
-  }
+
+    disconnected:
+    {
+      DrawTexturePro(
+        loose_texture,
+        Rectangle{0, 0, static_cast<float>(loose_texture.width), static_cast<float>(loose_texture.height)},
+        Rectangle{x * scale, y * scale, scale, scale},
+        Vector2{0, 0},
+        0,
+        color
+      );
+
+      return;
+    }
+  });
 }
 
 };
@@ -0,0 +1,120 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include <MobitRenderer/matrix.h>
+
+namespace mr {
+
+bool EffectMatrix::is_in_bounds(int x, int y) const noexcept {
+  return x >= 0 && x < width && y >= 0 && y < height;
+}
+
+uint8_t EffectMatrix::get(matrix_t x, matrix_t y) const noexcept {
+  if (!is_in_bounds(x, y)) return 0;
+
+  const auto &chunk = chunks[chunk_index(x, y)];
+  return chunk == nullptr ? 0 : chunk[cell_index(x, y)];
+}
+
+void EffectMatrix::set(matrix_t x, matrix_t y, uint8_t amount) {
+  if (!is_in_bounds(x, y))
+    throw std::out_of_range("matrix index is out of bounds");
+
+  auto &chunk = chunks[chunk_index(x, y)];
+
+  // Erasing never allocates.
+  if (chunk == nullptr) {
+    if (amount == 0) return;
+    chunk = std::make_unique<uint8_t[]>(chunk_area);
+  }
+
+  chunk[cell_index(x, y)] = std::min(amount, max_amount);
+}
+
+const uint8_t *EffectMatrix::get_chunk(size_t index) const noexcept {
+  return index < chunks.size() ? chunks[index].get() : nullptr;
+}
+
+uint8_t *EffectMatrix::get_or_allocate_chunk(size_t index) {
+  auto &chunk = chunks.at(index);
+  if (chunk == nullptr) chunk = std::make_unique<uint8_t[]>(chunk_area);
+  return chunk.get();
+}
+
+size_t EffectMatrix::allocated_chunks() const noexcept {
+  return static_cast<size_t>(std::count_if(chunks.begin(), chunks.end(), [](const auto &chunk) {
+    return chunk != nullptr;
+  }));
+}
+
+void EffectMatrix::shrink() noexcept {
+  for (auto &chunk : chunks) {
+    if (chunk == nullptr) continue;
+
+    const uint8_t *begin = chunk.get();
+    if (std::all_of(begin, begin + chunk_area, [](uint8_t amount) { return amount == 0; }))
+      chunk.reset();
+  }
+}
+
+void EffectMatrix::clear() noexcept {
+  for (auto &chunk : chunks) chunk.reset();
+}
+
+void EffectMatrix::resize(int16_t left, int16_t top, int16_t right, int16_t bottom) {
+  if (left == 0 && top == 0 && right == 0 && bottom == 0)
+    return;
+
+  const int new_width = width + left + right;
+  const int new_height = height + top + bottom;
+
+  if (new_width <= 0 || new_height <= 0)
+    return;
+
+  EffectMatrix resized(static_cast<matrix_t>(new_width), static_cast<matrix_t>(new_height));
+
+  for (size_t c = 0; c < chunks.size(); c++) {
+    const uint8_t *chunk = chunks[c].get();
+    if (chunk == nullptr) continue;
+
+    const int chunk_x = static_cast<int>(c % columns) * chunk_size;
+    const int chunk_y = static_cast<int>(c / columns) * chunk_size;
+
+    for (int i = 0; i < static_cast<int>(chunk_area); i++) {
+      if (chunk[i] == 0) continue;
+
+      const int new_x = chunk_x + i % chunk_size + left;
+      const int new_y = chunk_y + i / chunk_size + top;
+
+      if (resized.is_in_bounds(new_x, new_y))
+        resized.set(static_cast<matrix_t>(new_x), static_cast<matrix_t>(new_y), chunk[i]);
+    }
+  }
+
+  *this = std::move(resized);
+}
+
+uint8_t EffectMatrix::quantize(float amount) noexcept {
+  // Also rejects NaN.
+  if (!(amount > 0)) return 0;
+  if (amount >= max_amount) return max_amount;
+
+  return static_cast<uint8_t>(std::lround(amount));
+}
+
+EffectMatrix::EffectMatrix(matrix_t width, matrix_t height)
+  : width(width), height(height),
+    columns((width + chunk_size - 1) / chunk_size),
+    rows((height + chunk_size - 1) / chunk_size) {
+  if (width == 0 || height == 0)
+    throw std::invalid_argument("matrix dimensions cannot be zero");
+
+  chunks.resize(static_cast<size_t>(columns) * rows);
+}
+
+}; // namespace mr
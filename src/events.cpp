@@ -4,10 +4,12 @@
 
 #include <any>
 #include <cstdint>
+#include <exception>
 #include <iostream>
 
 #include <MobitRenderer/events.h>
 #include <MobitRenderer/pages.h>
+#include <MobitRenderer/serialization.h>
 #include <MobitRenderer/state.h>
 
 namespace mr {
@@ -30,4 +32,23 @@ void handle_goto_page(context *ctx, pages::pager *pager,
   pager->select(page);
 }
 
+void handle_save_level(context *ctx, pages::pager *pager, const std::any &payload) {
+  auto *level = ctx->get_selected_level();
+  if (level == nullptr) return;
+
+  const auto &path = level->get_path();
+
+  if (path.empty()) {
+    ctx->logger->warn("level '{}' has no project file to save to", level->get_name());
+    return;
+  }
+
+  try {
+    serde::ser_level(*level, path, ctx->_tiledex, ctx->_propdex);
+    ctx->logger->info("saved level '{}' to {}", level->get_name(), path.string());
+  } catch (const std::exception &e) {
+    ctx->logger->error("failed to save level '{}': {}", level->get_name(), e.what());
+  }
+}
+
 }; // namespace mr
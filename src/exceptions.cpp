@@ -20,6 +20,12 @@ const char *deserialization_failure::what() const noexcept {
   return msg_.c_str();
 }
 
+serialization_failure::serialization_failure(const std::string &msg)
+    : msg_(msg) {}
+const char *serialization_failure::what() const noexcept {
+  return msg_.c_str();
+}
+
 dex_error::dex_error(const std::string &msg) : msg_(msg) {}
 const char *dex_error::what() const noexcept { return msg_.c_str(); }
 
@@ -4,6 +4,7 @@
 #include <exception>
 #include <filesystem>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -14,6 +15,7 @@
 #include <MobitRenderer/imwin.h>
 #include <MobitRenderer/state.h>
 #include <MobitRenderer/io.h>
+#include <MobitRenderer/serialization.h>
 
 namespace mr {
 
@@ -82,6 +84,32 @@ void ProjectExplorer::go_to(const std::filesystem::path &dir) {
   entry_paths = paths;
   entry_names = names;
   entry_is_dir = is_dir;
+
+  entry_metadata.assign(paths.size(), std::nullopt);
+  entry_metadata_read.assign(paths.size(), false);
+}
+
+const serde::LevelMetadata *ProjectExplorer::get_metadata(size_t entry) noexcept {
+  if (entry >= entry_paths.size() || entry_is_dir[entry]) return nullptr;
+
+  if (!entry_metadata_read[entry]) {
+    entry_metadata_read[entry] = true;
+
+    try {
+      entry_metadata[entry] = serde::read_level_metadata(entry_paths[entry]);
+    } catch (const std::exception &e) {
+      entry_metadata[entry] = std::nullopt;
+    }
+  }
+
+  return entry_metadata[entry].has_value() ? &*entry_metadata[entry] : nullptr;
+}
+
+static void draw_metadata(const serde::LevelMetadata &metadata) {
+  ImGui::Text("Size: %d x %d", metadata.width, metadata.height);
+  ImGui::Text("Seed: %d", metadata.seed);
+  ImGui::Text("Cameras: %zu", metadata.cameras);
+  ImGui::Text("Props: %zu", metadata.props);
 }
 
 ProjectExplorer::dialogmode ProjectExplorer::get_dialog_mode() const noexcept {
@@ -267,6 +295,17 @@ bool ProjectExplorer::draw() noexcept {
               ImGui::Selectable(name.c_str(), n == selected_entry, 0,
                                 ImVec2(ImGui::GetContentRegionAvail().x, 20));
 
+          if (ImGui::IsItemHovered() && !entry_is_dir[n]) {
+            hovered_entry = n;
+
+            const auto *metadata = get_metadata(n);
+            if (metadata != nullptr) {
+              ImGui::BeginTooltip();
+              draw_metadata(*metadata);
+              ImGui::EndTooltip();
+            }
+          }
+
           if (is_clicked) {
             if (n == selected_entry) {
               if (entry_is_dir[n])
@@ -283,6 +322,10 @@ bool ProjectExplorer::draw() noexcept {
       }
 
       ImGui::TableSetColumnIndex(1);
+
+      const auto *selected_metadata = get_metadata(selected_entry);
+      if (selected_metadata != nullptr) draw_metadata(*selected_metadata);
+
       if (preview_rt.id != 0) {
         rlImGuiImageRenderTextureFit(&preview_rt, false);
       }
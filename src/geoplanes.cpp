@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#if defined(_MSC_VER)
+  #include <intrin.h>
+#endif
+
+#include <MobitRenderer/matrix.h>
+
+namespace mr {
+
+static inline uint8_t popcount(uint64_t bits) noexcept {
+#if defined(_MSC_VER)
+  return static_cast<uint8_t>(__popcnt64(bits));
+#else
+  return static_cast<uint8_t>(__builtin_popcountll(bits));
+#endif
+}
+
+uint8_t GeoFeaturePlanes::lowest_bit(uint64_t bits) noexcept {
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward64(&index, bits);
+  return static_cast<uint8_t>(index);
+#else
+  return static_cast<uint8_t>(__builtin_ctzll(bits));
+#endif
+}
+
+uint8_t GeoFeaturePlanes::feature_index(GeoFeature feature) noexcept {
+  const auto flag = static_cast<uint16_t>(feature);
+  return flag == 0 ? feature_count : lowest_bit(flag);
+}
+
+bool GeoFeaturePlanes::test(GeoFeature feature, int x, int y, int z) const noexcept {
+  if (x < 0 || x >= width || y < 0 || y >= height || z < 0 || z >= layers) return false;
+  if (words.empty()) return false;
+
+  const auto p = feature_index(feature);
+  if (p >= feature_count) return false;
+
+  const uint64_t word = words[row_index(p, y, z) + x / word_bits];
+  return (word >> (x % word_bits)) & 1;
+}
+
+size_t GeoFeaturePlanes::count(GeoFeature feature, matrix_t z) const noexcept {
+  if (z >= layers || words.empty()) return 0;
+
+  const auto p = feature_index(feature);
+  if (p >= feature_count) return 0;
+
+  // A plane is contiguous.
+  const uint64_t *begin = &words[row_index(p, 0, z)];
+  const uint64_t *end = begin + height * row_words;
+
+  size_t total = 0;
+  for (const uint64_t *word = begin; word < end; word++) total += popcount(*word);
+
+  return total;
+}
+
+bool GeoFeaturePlanes::any(GeoFeature features, matrix_t z) const noexcept {
+  if (z >= layers || words.empty()) return false;
+
+  for (uint8_t p = 0; p < feature_count; p++) {
+    if (!(static_cast<uint16_t>(features) & (1u << p))) continue;
+
+    const auto begin = words.begin() + row_index(p, 0, z);
+    const auto end = begin + height * row_words;
+
+    if (std::any_of(begin, end, [](uint64_t word) { return word != 0; })) return true;
+  }
+
+  return false;
+}
+
+void GeoFeaturePlanes::rebuild(const Matrix<GeoCell> &matrix) {
+  width = matrix.get_width();
+  height = matrix.get_height();
+  row_words = (width + word_bits - 1) / word_bits;
+
+  words.assign(static_cast<size_t>(layers) * feature_count * height * row_words, 0);
+
+  const matrix_t depth = std::min(matrix.get_depth(), layers);
+
+  for (matrix_t z = 0; z < depth; z++) {
+    matrix.view().for_each(z, [&](matrix_t x, matrix_t y, const GeoCell &cell) {
+      const size_t word = x / word_bits;
+      const uint64_t bit = uint64_t(1) << (x % word_bits);
+
+      for (auto flags = static_cast<uint16_t>(cell.features); flags != 0; flags &= flags - 1) {
+        words[row_index(lowest_bit(flags), y, z) + word] |= bit;
+      }
+    });
+  }
+}
+
+void GeoFeaturePlanes::update(const Matrix<GeoCell> &matrix, int x, int y, int z, int w, int h, int d) noexcept {
+  if (words.empty()) return;
+  if (matrix.get_width() != width || matrix.get_height() != height) return;
+
+  const int x0 = std::max(x, 0), x1 = std::min(x + w, static_cast<int>(width));
+  const int y0 = std::max(y, 0), y1 = std::min(y + h, static_cast<int>(height));
+  const int z0 = std::max(z, 0), z1 = std::min({z + d, static_cast<int>(layers), static_cast<int>(matrix.get_depth())});
+
+  for (int cz = z0; cz < z1; cz++) {
+    for (int cy = y0; cy < y1; cy++) {
+      for (int cx = x0; cx < x1; cx++) {
+        const auto flags = static_cast<uint16_t>(matrix.get_const(cx, cy, cz).features);
+
+        const size_t word = cx / word_bits;
+        const uint64_t bit = uint64_t(1) << (cx % word_bits);
+
+        for (uint8_t p = 0; p < feature_count; p++) {
+          auto &target = words[row_index(p, cy, cz) + word];
+
+          if (flags & (1u << p)) target |= bit;
+          else target &= ~bit;
+        }
+      }
+    }
+  }
+}
+
+GeoFeaturePlanes::GeoFeaturePlanes() : width(0), height(0), row_words(0) {}
+
+}; // namespace mr
@@ -0,0 +1,97 @@
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <mutex>
+#include <system_error>
+
+#include <raylib.h>
+
+#include <MobitRenderer/keying.h>
+#include <MobitRenderer/serialization.h>
+
+namespace mr {
+
+static std::mutex keyed_cache_mutex;
+static std::filesystem::path keyed_cache_directory;
+
+void key_white(Image &image) {
+  if (image.data == nullptr) return;
+
+  ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+  auto *pixels = static_cast<uint8_t *>(image.data);
+  const size_t count = static_cast<size_t>(image.width) * image.height;
+
+  for (size_t i = 0; i < count; i++) {
+    auto *p = pixels + i * 4;
+    const unsigned int a = p[3];
+
+    if (a == 255) {
+      if (p[0] == 255 && p[1] == 255 && p[2] == 255) p[0] = p[1] = p[2] = p[3] = 0;
+      continue;
+    }
+
+    p[0] = static_cast<uint8_t>((p[0] * a + 127) / 255);
+    p[1] = static_cast<uint8_t>((p[1] * a + 127) / 255);
+    p[2] = static_cast<uint8_t>((p[2] * a + 127) / 255);
+  }
+}
+
+void set_keyed_image_cache(const std::filesystem::path &directory) {
+  std::lock_guard<std::mutex> lock(keyed_cache_mutex);
+  keyed_cache_directory = directory;
+}
+
+Image load_keyed_image(const std::filesystem::path &path, int skip_rows) {
+  const Image none = { nullptr, 0, 0, 0, 0 };
+
+  std::filesystem::path directory;
+  {
+    std::lock_guard<std::mutex> lock(keyed_cache_mutex);
+    directory = keyed_cache_directory;
+  }
+
+  std::filesystem::path cache;
+  serde::FileKey key{0, 0, 0};
+  const auto variant = static_cast<uint32_t>(skip_rows);
+
+  if (!directory.empty()) {
+    try {
+      key = serde::file_key(path);
+      cache = serde::keyed_image_cache_path(directory, path);
+
+      auto cached = serde::read_keyed_image_cache(cache, key, variant);
+      if (cached.data != nullptr) return cached;
+    } catch (const std::exception &) {
+      cache.clear();
+    }
+  }
+
+  auto image = LoadImage(path.string().c_str());
+  if (image.data == nullptr) return none;
+
+  if (skip_rows > 0) {
+    if (skip_rows >= image.height) {
+      UnloadImage(image);
+      return none;
+    }
+
+    ImageCrop(&image, Rectangle{0, (float)skip_rows, (float)image.width, (float)(image.height - skip_rows)});
+  }
+
+  key_white(image);
+
+  // The cache is only an optimization; failing to write it is not an error.
+  if (!cache.empty()) {
+    try {
+      std::error_code ec;
+      std::filesystem::create_directories(directory, ec);
+
+      serde::write_keyed_image_cache(image, cache, key, variant);
+    } catch (const std::exception &) {}
+  }
+
+  return image;
+}
+
+}; // namespace mr
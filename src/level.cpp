@@ -3,12 +3,14 @@
 #include <string>
 #include <filesystem>
 #include <exception>
+#include <stdexcept>
 
 #ifdef IS_DEBUG_BUILD
 #include <iostream>
 #endif
 
 #include <raylib.h>
+#include <raymath.h>
 
 #include <MobitRenderer/level.h>
 #include <MobitRenderer/matrix.h>
@@ -245,38 +247,116 @@ const std::vector<Effect> &Level::get_const_effects() const {
   return effects;
 }
 
+const GeoFeaturePlanes &Level::get_feature_planes() const {
+  if (feature_planes_stale) {
+    feature_planes.rebuild(geo_matrix);
+    feature_planes_stale = false;
+  }
+
+  return feature_planes;
+}
+
+void Level::geo_changed(int x, int y, int z, int width, int height, int depth) noexcept {
+  // A stale set is rebuilt whole anyway.
+  if (feature_planes_stale) return;
+
+  feature_planes.update(geo_matrix, x, y, z, width, height, depth);
+}
+
+void Level::geo_changed() noexcept { feature_planes_stale = true; }
+
 void Level::resize(int16_t left, int16_t top, int16_t right,
                       int16_t bottom) {
   if (left == 0 && top == 0 && right == 0 && bottom == 0)
     return;
-  if (-left == width || -right == width || -top == height || -bottom == height)
-    return;
 
-  // Update size
+  const int new_width = width + left + right;
+  const int new_height = height + top + bottom;
 
-  width = width + left + right;
-  height = height + top + bottom;
-  
-  pxwidth = width * 20;
-  pxheight = height * 20;
+  // Checked up front so that nothing is resized if any of it would fail.
+  if (new_width <= 0 || new_height <= 0)
+    throw std::invalid_argument("level dimensions cannot be zero");
+
+  if (new_width > UINT16_MAX || new_height > UINT16_MAX)
+    throw std::invalid_argument("level dimensions are too large");
 
   // Resize matrices
 
   geo_matrix.resize(left, top, right, bottom);
   tile_matrix.resize(left, top, right, bottom);
 
+  geo_changed();
+
   for (auto &effect : effects) {
     effect.matrix.resize(left, top, right, bottom);
   }
 
+  // Tile bodies refer to their heads by position.
+
+  auto tiles = tile_matrix.view();
+
+  for (matrix_t z = 0; z < tile_matrix.get_depth(); z++) {
+    tiles.for_each(z, [&](matrix_t, matrix_t, TileCell &cell) {
+      if (cell.type != TileType::body) return;
+
+      const int head_x = cell.head_pos_x + left;
+      const int head_y = cell.head_pos_y + top;
+
+      if (tile_matrix.is_in_bounds(head_x, head_y, cell.head_pos_z)) {
+        cell.head_pos_x = static_cast<uint16_t>(head_x);
+        cell.head_pos_y = static_cast<uint16_t>(head_y);
+      } else {
+        cell = TileCell();
+      }
+    });
+  }
+
+  // Update size
+
+  width = static_cast<levelsize>(new_width);
+  height = static_cast<levelsize>(new_height);
+  
+  pxwidth = width * 20;
+  pxheight = height * 20;
+
+  // Props and cameras
+
+  const Vector2 offset{ left * 20.0f, top * 20.0f };
+
+  // Rope segments are kept in the saved (16 px) units.
+  const Vector2 legacy_offset{ 
+    static_cast<float>(left * MATRIX_UNIT_LEGACY), 
+    static_cast<float>(top * MATRIX_UNIT_LEGACY) 
+  };
+
+  for (auto &prop : props) {
+    prop->quad += offset;
+
+    for (auto &segment : prop->settings.segments) 
+      segment = Vector2Add(segment, legacy_offset);
+  }
+
+  for (auto &camera : cameras) {
+    camera.set_position(Vector2Add(camera.get_position(), offset));
+  }
+
   // Resize lightmap
 
   if (lightmap.id != 0) {
-    RenderTexture2D new_lightmap = LoadRenderTexture(width, height);
+    RenderTexture2D new_lightmap = LoadRenderTexture(
+      lightmap.texture.width + (left + right) * 20, 
+      lightmap.texture.height + (top + bottom) * 20
+    );
 
     BeginTextureMode(new_lightmap);
-    ClearBackground(BLACK);
-    DrawTexture(lightmap.texture, 0, 0, WHITE);
+    ClearBackground(WHITE);
+    // Render textures are stored upside down.
+    DrawTextureRec(
+      lightmap.texture, 
+      Rectangle{ 0, 0, static_cast<float>(lightmap.texture.width), -static_cast<float>(lightmap.texture.height) },
+      offset,
+      WHITE
+    );
     EndTextureMode();
 
     UnloadRenderTexture(lightmap);
@@ -285,9 +365,13 @@ void Level::resize(int16_t left, int16_t top, int16_t right,
   }
 }
 
+Effect::Effect(matrix_t width, matrix_t height)
+    : type("nn"), cross_screen(false), repeats(0), affect_open_areas(0),
+      matrix(width, height) {}
+
 Level::Level(uint16_t width, uint16_t height)
     : width(width), height(height), pxwidth(width * 20), pxheight(height * 20), geo_matrix(width, height),
-      tile_matrix(width, height), water(-1), front_water(false), light(true),
+      tile_matrix(width, height), feature_planes_stale(true), water(-1), front_water(false), light(true),
       terrain(true), lightmap(RenderTexture2D{0}), light_angle(180), light_flatness(1) {}
 
 Level::Level(uint16_t width, uint16_t height,
@@ -300,7 +384,7 @@ Level::Level(uint16_t width, uint16_t height,
                 int8_t water, bool light, bool terrain, bool front_water)
     : width(width), height(height), pxwidth(width * 20), pxheight(height * 20), water(water), front_water(front_water),
       light(light), terrain(terrain), tile_matrix(std::move(tile_matrix)),
-      geo_matrix(std::move(geo_matrix)), lightmap(RenderTexture2D{0}), light_angle(180), light_flatness(1) {}
+      geo_matrix(std::move(geo_matrix)), feature_planes_stale(true), lightmap(RenderTexture2D{0}), light_angle(180), light_flatness(1) {}
 
 Level::~Level() {
   unload_lightmap();
@@ -94,32 +94,17 @@ int main(int argc, char *argv[]) {
   castlibs->load_all_members();
   ctx->_castlibs = castlibs;
 
-  logger->info("loading tiles");
+  // Init files are registered in this order; tiles first, so that
+  // they can be registered as props afterwards.
+  mr::serde::DexSources dex_sources;
 
-  auto *tiledex = new mr::TileDex();
-  tiledex->register_from(directories->get_tiles() / "Init.txt", castlibs);
-  tiledex->register_from(directories->get_cast() /
-                             "Drought_393439_Drought Needed Init.txt",
-                         castlibs);
-  ctx->_tiledex = tiledex;
-
-  logger->info("loading props");
-  auto *propdex = new mr::PropDex();
-  propdex->register_from(directories->get_props() / "Init.txt", castlibs);
-  // propdex->register_from(directories->get_props() / "trees.txt", castlibs);
-  propdex->register_tiles(tiledex);
-  ctx->_propdex = propdex;
-
-  logger->info("loading materials");
-
-  auto *materialdex = new mr::MaterialDex();
-  materialdex->load_internals();
-  ctx->_materialdex = materialdex;
+  dex_sources.tiles.push_back(directories->get_tiles() / "Init.txt");
+  dex_sources.tiles.push_back(directories->get_cast() / "Drought_393439_Drought Needed Init.txt");
+  dex_sources.props.push_back(directories->get_props() / "Init.txt");
+  // dex_sources.props.push_back(directories->get_props() / "trees.txt");
 
 #ifdef FEATURE_DATAPACKS
   if (directories->is_datapacks_found()) { // Data packs
-    logger->info("loading data packs");
-
     for (auto &entry :
          std::filesystem::directory_iterator(directories->get_tilepacks())) {
       if (!entry.is_directory())
@@ -130,8 +115,8 @@ int main(int argc, char *argv[]) {
       if (!std::filesystem::exists(init_path))
         continue;
 
-      logger->info("loading tile pack init {}", init_path.string().c_str());
-      tiledex->register_from(init_path, castlibs);
+      logger->info("found tile pack init {}", init_path.string().c_str());
+      dex_sources.tiles.push_back(init_path);
     }
 
     for (auto &entry :
@@ -144,12 +129,33 @@ int main(int argc, char *argv[]) {
       if (!std::filesystem::exists(init_path))
         continue;
 
-      logger->info("loading prop pack init {}", init_path.string().c_str());
-      tiledex->register_from(init_path, castlibs);
+      logger->info("found prop pack init {}", init_path.string().c_str());
+      dex_sources.props.push_back(init_path);
     }
   }
 #endif
 
+  logger->info("loading tiles and props");
+
+  auto *tiledex = new mr::TileDex();
+  auto *propdex = new mr::PropDex();
+
+  if (mr::serde::register_dexes(directories->get_data() / "dex.mrcache",
+                                dex_sources, *tiledex, *propdex, castlibs)) {
+    logger->info("restored tiles and props from snapshot");
+  }
+
+  propdex->register_tiles(tiledex);
+
+  ctx->_tiledex = tiledex;
+  ctx->_propdex = propdex;
+
+  logger->info("loading materials");
+
+  auto *materialdex = new mr::MaterialDex();
+  materialdex->load_internals();
+  ctx->_materialdex = materialdex;
+
   logger->info("initializing window");
 
   SetTargetFPS(40);
@@ -209,6 +215,7 @@ int main(int argc, char *argv[]) {
   handlers[mr::context_event_type::level_loaded] = mr::handle_level_loaded;
   handlers[mr::context_event_type::level_selected] = mr::handle_level_selected;
   handlers[mr::context_event_type::goto_page] = mr::handle_goto_page;
+  handlers[mr::context_event_type::save_level] = mr::handle_save_level;
 
   logger->info("entering main loop");
 
@@ -252,6 +259,11 @@ int main(int argc, char *argv[]) {
       if (IsKeyPressed(KEY_S) && IsKeyDown(KEY_R)) {
         shaders->reload_all();
       }
+
+      if (!ctx->get_levels().empty() && IsKeyPressed(KEY_S) &&
+          (IsKeyDown(KEY_LEFT_CONTROL) || IsKeyDown(KEY_RIGHT_CONTROL))) {
+        ctx->events.push(mr::context_event{mr::context_event_type::save_level, nullptr});
+      }
     }
 
     pager->get_selected()->process();
@@ -289,6 +301,10 @@ int main(int argc, char *argv[]) {
           auto goto_settings =
               ImGui::MenuItem("Settings", nullptr, current_page == 9, true);
 
+          if (ImGui::MenuItem("Save", "Ctrl+S", false, !ctx->get_levels().empty())) {
+            ctx->events.push(mr::context_event{mr::context_event_type::save_level, nullptr});
+          }
+
           if (goto_main) {
             pager->select(1);
           } else if (goto_geo) {
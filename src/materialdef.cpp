@@ -22,7 +22,8 @@ namespace mr {
   ) :
     name(name),
     color(color),
-    type(type) 
+    type(type),
+    id(no_def_id)
   { }
 
   MaterialDef::MaterialDef(
@@ -34,7 +35,8 @@ namespace mr {
     name(name),
     category(category),
     color(color),
-    type(type) 
+    type(type),
+    id(no_def_id)
   { }
 
   bool CustomMaterialDef::are_textures_loaded() const noexcept {
@@ -249,6 +249,8 @@ void Geo_Page::_place(uint16_t x, uint16_t y, uint16_t z, uint16_t width,
     }
   } break;
   }
+
+  level->geo_changed(x, y, z, width, height, depth);
 }
 
 void Geo_Page::_erase(uint16_t x, uint16_t y, uint16_t z, uint16_t width,
@@ -373,6 +375,8 @@ void Geo_Page::_erase(uint16_t x, uint16_t y, uint16_t z, uint16_t width,
     }
   } break;
   }
+
+  level->geo_changed(x, y, z, width, height, depth);
 }
 
 void Geo_Page::f3() const noexcept {
@@ -724,13 +728,16 @@ void Geo_Page::draw() noexcept {
     ClearBackground(WHITE);
 
     const auto &mtx = ctx->get_selected_level()->get_const_geo_matrix();
+    const auto &planes = ctx->get_selected_level()->get_feature_planes();
 
-    mr::draw::draw_geo_features_layer(mtx, ctx->_textures->geometry_editor, 0,
-                                      BLACK);
+    mr::draw::draw_geo_features_layer(mtx, planes,
+                                      ctx->_textures->geometry_editor, 0, BLACK);
 
-    mr::draw::draw_geo_cracked(mtx, ctx->_textures->geometry_editor, 0, BLACK);
+    mr::draw::draw_geo_cracked(mtx, planes, ctx->_textures->geometry_editor, 0,
+                               BLACK);
 
-    mr::draw::draw_geo_entrances(mtx, ctx->_textures->geometry_editor, BLACK);
+    mr::draw::draw_geo_entrances(mtx, planes, ctx->_textures->geometry_editor,
+                                 BLACK);
 
     EndTextureMode();
 
@@ -744,11 +751,13 @@ void Geo_Page::draw() noexcept {
     ClearBackground(WHITE);
 
     const auto &mtx = ctx->get_selected_level()->get_const_geo_matrix();
+    const auto &planes = ctx->get_selected_level()->get_feature_planes();
 
-    mr::draw::draw_geo_features_layer(mtx, ctx->_textures->geometry_editor, 1,
-                                      BLACK);
+    mr::draw::draw_geo_features_layer(mtx, planes,
+                                      ctx->_textures->geometry_editor, 1, BLACK);
 
-    mr::draw::draw_geo_cracked(mtx, ctx->_textures->geometry_editor, 1, BLACK);
+    mr::draw::draw_geo_cracked(mtx, planes, ctx->_textures->geometry_editor, 1,
+                               BLACK);
 
     EndTextureMode();
 
@@ -762,11 +771,13 @@ void Geo_Page::draw() noexcept {
     ClearBackground(WHITE);
 
     const auto &mtx = ctx->get_selected_level()->get_const_geo_matrix();
+    const auto &planes = ctx->get_selected_level()->get_feature_planes();
 
-    mr::draw::draw_geo_features_layer(mtx, ctx->_textures->geometry_editor, 2,
-                                      BLACK);
+    mr::draw::draw_geo_features_layer(mtx, planes,
+                                      ctx->_textures->geometry_editor, 2, BLACK);
 
-    mr::draw::draw_geo_cracked(mtx, ctx->_textures->geometry_editor, 2, BLACK);
+    mr::draw::draw_geo_cracked(mtx, planes, ctx->_textures->geometry_editor, 2,
+                               BLACK);
 
     EndTextureMode();
 
@@ -234,6 +234,7 @@ void Light_Page::draw() noexcept {
     ClearBackground(WHITE);
 
     mr::sdraw::draw_tile_prevs_layer(ctx->_shaders,
+                                     ctx->_tiledex, ctx->_materialdex,
                                      level->get_const_geo_matrix(),
                                      level->get_const_tile_matrix(), 0, 20);
 
@@ -246,6 +247,7 @@ void Light_Page::draw() noexcept {
     ClearBackground(WHITE);
 
     mr::sdraw::draw_tile_prevs_layer(ctx->_shaders,
+                                     ctx->_tiledex, ctx->_materialdex,
                                      level->get_const_geo_matrix(),
                                      level->get_const_tile_matrix(), 1, 20);
 
@@ -258,6 +260,7 @@ void Light_Page::draw() noexcept {
     ClearBackground(WHITE);
 
     mr::sdraw::draw_tile_prevs_layer(ctx->_shaders,
+                                     ctx->_tiledex, ctx->_materialdex,
                                      level->get_const_geo_matrix(),
                                      level->get_const_tile_matrix(), 2, 20);
 
@@ -253,6 +253,8 @@ void Props_Page::draw() noexcept {
 
     mr::sdraw::draw_tile_prevs_layer(
       ctx->_shaders,
+      ctx->_tiledex,
+      ctx->_materialdex,
       level->get_const_geo_matrix(),
       level->get_const_tile_matrix(),
       0,
@@ -272,6 +274,8 @@ void Props_Page::draw() noexcept {
 
     mr::sdraw::draw_tile_prevs_layer(
       ctx->_shaders,
+      ctx->_tiledex,
+      ctx->_materialdex,
       level->get_const_geo_matrix(),
       level->get_const_tile_matrix(),
       1,
@@ -291,6 +295,8 @@ void Props_Page::draw() noexcept {
 
     mr::sdraw::draw_tile_prevs_layer(
       ctx->_shaders,
+      ctx->_tiledex,
+      ctx->_materialdex,
       level->get_const_geo_matrix(),
       level->get_const_tile_matrix(),
       2,
@@ -43,10 +43,30 @@ void Start_Page::process() {
       try {
       
         const std::filesystem::path path_copy = *file;
-        this->loaded_level = mr::serde::deser_level(path_copy);
-        mr::serde::define_tile_matrix(this->loaded_level->get_tile_matrix(), ctx->_tiledex, ctx->_materialdex);
-        mr::serde::define_prop_list(this->loaded_level->props, ctx->_propdex);
+
+        // Without strict deserialization, malformed parts of the level
+        // are replaced with defaults and reported once it's loaded.
+        const bool strict = ctx->get_config()->strict_deserialization;
+        mr::serde::Diagnostics diagnostics;
+
+        this->loaded_level = mr::serde::deser_level(
+          path_copy, 
+          ctx->_propdex, 
+          strict ? nullptr : &diagnostics
+        );
         this->loaded_level->set_path(*file);
+
+        if (!diagnostics.empty()) {
+          std::stringstream sb;
+          sb << "level " << file->stem() << " loaded with " << diagnostics.size() << " problem(s)";
+          ctx->logger->warn(sb.str());
+
+          for (const auto &diagnostic : diagnostics.entries()) {
+            std::stringstream entry;
+            entry << diagnostic;
+            ctx->logger->warn(entry.str());
+          }
+        }
       
       } catch (const deserialization_failure &pf) {
         std::cout << "exception: " << pf.what() << std::endl;
@@ -283,8 +283,7 @@ void Tile_Page::_erase_cell() noexcept {
 
   switch (_hovered_cell->type) {
   case TileType::material:
-    _hovered_cell->type = TileType::_default;
-    _hovered_cell->material_def = nullptr;
+    *_hovered_cell = TileCell();
 
     BeginTextureMode(rt);
     DrawRectangleRec(rect, WHITE);
@@ -297,8 +296,8 @@ void Tile_Page::_erase_cell() noexcept {
                                                      _hovered_cell->head_pos_z))
       break;
 
-    if (_hovered_cell->tile_def != nullptr) {
-      const auto *def = _hovered_cell->tile_def;
+    if (ctx->_tiledex->tile(*_hovered_cell) != nullptr) {
+      const auto *def = ctx->_tiledex->tile(*_hovered_cell);
 
       rect.width = def->get_width() * 20.0f;
       rect.height = def->get_height() * 20.0f;
@@ -354,8 +353,8 @@ void Tile_Page::_erase_cell() noexcept {
   break;
 
   case TileType::head:
-    if (_hovered_cell->tile_def != nullptr) {
-      const auto *def = _hovered_cell->tile_def;
+    if (ctx->_tiledex->tile(*_hovered_cell) != nullptr) {
+      const auto *def = ctx->_tiledex->tile(*_hovered_cell);
 
       rect.width = def->get_width() * 20.0f;
       rect.height = def->get_height() * 20.0f;
@@ -639,7 +638,7 @@ void Tile_Page::process() {
 
         switch (cell->type) {
         case TileType::head: {
-          _selected_tile = cell->tile_def;
+          _selected_tile = ctx->_tiledex->tile(*cell);
 
           if (_selected_tile == nullptr)
             goto break_lookup;
@@ -669,7 +668,7 @@ void Tile_Page::process() {
           if (supposed_head == nullptr || supposed_head->type != TileType::head)
             goto break_lookup;
 
-          _selected_tile = supposed_head->tile_def;
+          _selected_tile = ctx->_tiledex->tile(*supposed_head);
 
           _redraw_tile_texture_rt();
           _redraw_tile_specs_rt();
@@ -689,7 +688,7 @@ void Tile_Page::process() {
         } break;
 
         case TileType::material: {
-          _selected_material = cell->material_def;
+          _selected_material = ctx->_materialdex->material(*cell);
           if (_selected_material == nullptr)
             goto break_lookup;
 
@@ -909,10 +908,12 @@ void Tile_Page::draw() noexcept {
 
     mr::draw::draw_geo_features_layer(
         ctx->get_selected_level()->get_const_geo_matrix(),
+        ctx->get_selected_level()->get_feature_planes(),
         ctx->_textures->geometry_editor, 0, BLACK);
 
     mr::draw::draw_geo_entrances(
         ctx->get_selected_level()->get_const_geo_matrix(),
+        ctx->get_selected_level()->get_feature_planes(),
         ctx->_textures->geometry_editor, BLACK);
     EndTextureMode();
 
@@ -954,6 +955,7 @@ void Tile_Page::draw() noexcept {
     ClearBackground(WHITE);
 
     mr::sdraw::draw_tile_prevs_layer(ctx->_shaders,
+                                     ctx->_tiledex, ctx->_materialdex,
                                      level->get_const_geo_matrix(),
                                      level->get_const_tile_matrix(), 0, 20);
 
@@ -969,6 +971,7 @@ void Tile_Page::draw() noexcept {
     ClearBackground(WHITE);
 
     mr::sdraw::draw_tile_prevs_layer(ctx->_shaders,
+                                     ctx->_tiledex, ctx->_materialdex,
                                      level->get_const_geo_matrix(),
                                      level->get_const_tile_matrix(), 1, 20);
 
@@ -984,6 +987,7 @@ void Tile_Page::draw() noexcept {
     ClearBackground(WHITE);
 
     mr::sdraw::draw_tile_prevs_layer(ctx->_shaders,
+                                     ctx->_tiledex, ctx->_materialdex,
                                      level->get_const_geo_matrix(),
                                      level->get_const_tile_matrix(), 2, 20);
 
@@ -1212,14 +1216,15 @@ void Tile_Page::draw() noexcept {
       if (_hovered_cell != nullptr) {
         switch (_hovered_cell->type) {
         case TileType::head: {
-          if (_hovered_cell->tile_def != nullptr) {
-            auto offset = _hovered_cell->tile_def->get_head_offset();
+          const auto *def = ctx->_tiledex->tile(*_hovered_cell);
+          if (def != nullptr) {
+            auto offset = def->get_head_offset();
             DrawRectangleLinesEx(
               Rectangle{
                 (_mtx_mouse_pos.x - offset.x) * 20.0f,
                 (_mtx_mouse_pos.y - offset.y) * 20.0f,
-                _hovered_cell->tile_def->get_width() * 20.0f,
-                _hovered_cell->tile_def->get_height() * 20.0f
+                def->get_width() * 20.0f,
+                def->get_height() * 20.0f
               },
               2, 
               WHITE
@@ -1228,13 +1233,14 @@ void Tile_Page::draw() noexcept {
         } break;
 
         case TileType::body: {
-          if (_hovered_cell->tile_def != nullptr) {
-            auto offset = _hovered_cell->tile_def->get_head_offset();
+          const auto *def = ctx->_tiledex->tile(*_hovered_cell);
+          if (def != nullptr) {
+            auto offset = def->get_head_offset();
             DrawRectangleLinesEx(
                 Rectangle{(_hovered_cell->head_pos_x - offset.x) * 20.0f,
                           (_hovered_cell->head_pos_y - offset.y) * 20.0f,
-                          _hovered_cell->tile_def->get_width() * 20.0f,
-                          _hovered_cell->tile_def->get_height() * 20.0f},
+                          def->get_width() * 20.0f,
+                          def->get_height() * 20.0f},
                 2, WHITE);
           }
         } break;
@@ -1541,11 +1547,11 @@ void Tile_Page::f3() const noexcept {
   if (_hovered_cell) {
     switch (_hovered_cell->type) {
     case TileType::head: {
-      auto *def = _hovered_cell->tile_def;
+      auto *def = ctx->_tiledex->tile(*_hovered_cell);
 
       if (def == nullptr) {
         f3->print("Undefined Tile \"", true);
-        f3->print(_hovered_cell->und_name, true);
+        f3->print(std::string(_hovered_cell->und_name()), true);
         f3->print("\"", true);
       } else {
         f3->print(def->get_name(), true);
@@ -1553,11 +1559,11 @@ void Tile_Page::f3() const noexcept {
     } break;
 
     case TileType::body: {
-      auto *def = _hovered_cell->tile_def;
+      auto *def = ctx->_tiledex->tile(*_hovered_cell);
 
       if (def == nullptr) {
         f3->print("Undefined Tile \"", true);
-        f3->print(_hovered_cell->und_name, true);
+        f3->print(std::string(_hovered_cell->und_name()), true);
         f3->print("\"", true);
       } else {
         f3->print(def->get_name(), true);
@@ -1570,11 +1576,11 @@ void Tile_Page::f3() const noexcept {
     } break;
 
     case TileType::material: {
-      auto *def = _hovered_cell->material_def;
+      auto *def = ctx->_materialdex->material(*_hovered_cell);
 
       if (def == nullptr) {
         f3->print("Undefined Material \"", true);
-        f3->print(_hovered_cell->und_name, true);
+        f3->print(std::string(_hovered_cell->und_name()), true);
         f3->print("\"", true);
       } else {
         f3->print(def->get_name(), true);
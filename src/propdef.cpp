@@ -39,10 +39,10 @@ int PropDef::get_pixel_width() const noexcept { return texture.width; }
 int PropDef::get_pixel_height() const noexcept { return texture.height; }
 
 PropDef::PropDef(int depth, std::string &&name, PropType type) :
-    depth(depth), name(std::move(name)), type(type), tags({}), loaded(false), color({255, 0, 0, 255})
+    depth(depth), name(std::move(name)), type(type), tags({}), loaded(false), color({255, 0, 0, 255}), id(no_def_id)
 {}
 PropDef::PropDef(int depth, std::string &&name, PropType type, std::unordered_set<std::string> &&tags) :
-    depth(depth), name(std::move(name)), type(type), tags(std::move(tags)), loaded(false), color({255, 0, 0, 255})
+    color({255, 0, 0, 255}), loaded(false), id(no_def_id), depth(depth), type(type), name(std::move(name)), tags(std::move(tags)), tag_set(TagSet::of(this->tags))
 {}
 
 PropDef::~PropDef() {
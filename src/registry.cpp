@@ -0,0 +1,66 @@
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <MobitRenderer/registry.h>
+
+namespace mr {
+
+namespace {
+
+class tag_table {
+private:
+  std::mutex _mutex;
+  std::unordered_map<std::string, Tag> _tags;
+
+public:
+  Tag intern(std::string_view name) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    const std::string key(name);
+
+    auto found = _tags.find(key);
+    if (found != _tags.end()) return found->second;
+
+    if (_tags.size() >= TagSet::capacity) return Tag();
+
+    const Tag tag(_tags.size());
+    _tags.emplace(key, tag);
+
+    return tag;
+  }
+
+  tag_table() {
+    // In the order of the constants in mr::tags.
+    for (const char *name : {
+      "INTERNAL",
+      "colored",
+      "effectColorA",
+      "effectColorB",
+      "notTrashProp",
+      "notProp",
+      "customColor"
+    }) intern(name);
+  }
+};
+
+tag_table &tag_names() {
+  static tag_table table;
+  return table;
+}
+
+}; // namespace
+
+Tag intern_tag(std::string_view name) {
+  return tag_names().intern(name);
+}
+
+TagSet TagSet::of(const std::unordered_set<std::string> &tags) {
+  TagSet set;
+  for (const auto &tag : tags) set.add(intern_tag(tag));
+  return set;
+}
+
+}; // namespace mr
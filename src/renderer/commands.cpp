@@ -0,0 +1,246 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <raylib.h>
+#include <rlgl.h>
+
+#include <MobitRenderer/draw.h>
+#include <MobitRenderer/renderer/commands.h>
+
+namespace mr::renderer {
+
+// Extra samplers set with SetShaderValueTexture() are forgotten when
+// rlgl flushes a full batch on its own, so shader modes are restarted
+// well before a batch can fill up (2048 quads on OpenGL ES).
+static const size_t max_batched_draws = 1024;
+
+DrawRecorder::bucket &DrawRecorder::_bucket(const RenderTexture2D &target) {
+    auto found = _bucket_indices.find(target.id);
+
+    if (found != _bucket_indices.end()) {
+        auto &b = _buckets[found->second];
+        b.target = target;
+        return b;
+    }
+
+    _bucket_indices[target.id] = _buckets.size();
+    _buckets.push_back(bucket{ target, {} });
+
+    return _buckets.back();
+}
+
+void DrawRecorder::draw(
+    const RenderTexture2D &target,
+    const Shader &shader,
+    int texture_loc,
+    const Texture2D &texture,
+    Rectangle source,
+    Rectangle destination
+) {
+    _bucket(target).commands.push_back(command{
+        command_type::texture,
+        shader,
+        texture_loc,
+        texture,
+        source,
+        destination,
+        0
+    });
+
+    _size++;
+}
+
+void DrawRecorder::draw_darkest(
+    const RenderTexture2D &target,
+    const Texture2D &texture,
+    Rectangle source,
+    Rectangle destination
+) {
+    _bucket(target).commands.push_back(command{
+        command_type::darkest,
+        Shader{0, nullptr},
+        -1,
+        texture,
+        source,
+        destination,
+        0
+    });
+
+    _size++;
+}
+
+void DrawRecorder::draw_keyed(
+    const RenderTexture2D &target,
+    const Texture2D &texture,
+    Rectangle source,
+    Rectangle destination
+) {
+    _bucket(target).commands.push_back(command{
+        command_type::keyed,
+        Shader{0, nullptr},
+        -1,
+        texture,
+        source,
+        destination,
+        0
+    });
+
+    _size++;
+}
+
+void DrawRecorder::draw_quad(
+    const RenderTexture2D &target,
+    const Shader &shader,
+    int texture_loc,
+    const Texture2D &texture,
+    const Quad &quad,
+    const QuadUniforms &uniforms
+) {
+    _bucket(target).commands.push_back(command{
+        command_type::quad,
+        shader,
+        texture_loc,
+        texture,
+        Rectangle{},
+        Rectangle{},
+        _quads.size()
+    });
+
+    _quads.push_back(quad_command{ quad, uniforms });
+
+    _size++;
+}
+
+void DrawRecorder::flush() {
+    if (_size == 0) return;
+
+    for (auto &b : _buckets) {
+        if (b.commands.empty()) continue;
+
+        BeginTextureMode(b.target);
+
+        // The state left by the previous command.
+        bool shading = false, blending = false;
+        int blend_mode = BLEND_ALPHA;
+        unsigned int shader_id = 0, texture_id = 0;
+        size_t batched = 0;
+
+        for (const auto &c : b.commands) {
+            switch (c.type) {
+            case command_type::texture: {
+                if (blending) {
+                    EndBlendMode();
+                    blending = false;
+                }
+
+                const bool same =
+                    shading &&
+                    shader_id == c.shader.id &&
+                    texture_id == c.texture.id &&
+                    batched < max_batched_draws;
+
+                if (!same) {
+                    if (shading) EndShaderMode();
+                    shading = false;
+
+                    if (c.shader.id != 0) {
+                        BeginShaderMode(c.shader);
+                        SetShaderValueTexture(c.shader, c.texture_loc, c.texture);
+
+                        shading = true;
+                        shader_id = c.shader.id;
+                        texture_id = c.texture.id;
+                        batched = 0;
+                    }
+                }
+
+                DrawTexturePro(c.texture, c.source, c.destination, Vector2{0, 0}, 0, WHITE);
+                batched++;
+            }
+            break;
+
+            case command_type::darkest:
+                if (shading) {
+                    EndShaderMode();
+                    shading = false;
+                }
+
+                if (blending && blend_mode != BLEND_CUSTOM) EndBlendMode();
+
+                // The factors are set first so that they apply to the
+                // whole run, and not only from its second draw onwards.
+                if (!blending || blend_mode != BLEND_CUSTOM) {
+                    rlSetBlendFactors(1, 1, 0x8007);
+                    BeginBlendMode(BLEND_CUSTOM);
+                    blending = true;
+                    blend_mode = BLEND_CUSTOM;
+                }
+
+                DrawTexturePro(c.texture, c.source, c.destination, Vector2{0, 0}, 0, WHITE);
+            break;
+
+            case command_type::keyed:
+                if (shading) {
+                    EndShaderMode();
+                    shading = false;
+                }
+
+                if (blending && blend_mode != BLEND_ALPHA_PREMULTIPLY) EndBlendMode();
+
+                if (!blending || blend_mode != BLEND_ALPHA_PREMULTIPLY) {
+                    BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+                    blending = true;
+                    blend_mode = BLEND_ALPHA_PREMULTIPLY;
+                }
+
+                DrawTexturePro(c.texture, c.source, c.destination, Vector2{0, 0}, 0, WHITE);
+            break;
+
+            case command_type::quad: {
+                if (blending) {
+                    EndBlendMode();
+                    blending = false;
+                }
+
+                if (shading) EndShaderMode();
+
+                const auto &q = _quads[c.quad];
+
+                // The uniforms are unique to each quad, so it's never batched.
+                BeginShaderMode(c.shader);
+                SetShaderValueTexture(c.shader, c.texture_loc, c.texture);
+                SetShaderValueV(c.shader, q.uniforms.vertices_loc, q.uniforms.vertices, SHADER_UNIFORM_VEC2, 4);
+                SetShaderValueV(c.shader, q.uniforms.tex_coord_loc, q.uniforms.tex_coord, SHADER_UNIFORM_FLOAT, 4);
+
+                mr::draw::draw_texture(c.texture, q.quad);
+
+                EndShaderMode();
+                shading = false;
+            }
+            break;
+            }
+        }
+
+        if (shading) EndShaderMode();
+        if (blending) EndBlendMode();
+
+        EndTextureMode();
+
+        b.commands.clear();
+    }
+
+    _quads.clear();
+    _size = 0;
+}
+
+void DrawRecorder::clear() noexcept {
+    for (auto &b : _buckets) b.commands.clear();
+
+    _quads.clear();
+    _size = 0;
+}
+
+DrawRecorder::DrawRecorder() : _size(0) {}
+
+};
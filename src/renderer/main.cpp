@@ -130,7 +130,10 @@ Renderer::Renderer(
     _material_progress(0),
     _material_layer_progress(0),
     _material_progress_x(0),
-    _material_progress_y(0)
+    _material_progress_y(0),
+
+    _unified_materials_loaded(false),
+    _unified_atlas(2048, true)
 {}
 
 Renderer::~Renderer() {
@@ -839,62 +842,40 @@ void Renderer::_prepare() {
     for (int c = 0; c < _tiles_to_render1.size(); c++) {
         const auto &camera = _config.cameras.empty() ? _level->cameras[c] : _level->cameras[_config.cameras[c]];
 
-        for (int x = 0; x < columns; x++) {
-            for (int y = 0; y < rows; y++) {
-                const int mx = x + static_cast<int>(camera.get_position().x/20);
-                const int my = y + static_cast<int>(camera.get_position().y/20);
-
-                if (mtx.is_in_bounds(mx, my, 0)) {
-                    const auto *cell1 = mtx.get_const_ptr(static_cast<matrix_t>(mx), static_cast<matrix_t>(my), 0);
-
-                    if (cell1 != nullptr && cell1->type == TileType::head && cell1->tile_def != nullptr) {
-                        _tiles_to_render1[c]
-                            .push_back(
-                                Render_TileCell{ 
-                                    _rand.next(100000), 
-                                    static_cast<matrix_t>(x), 
-                                    static_cast<matrix_t>(y), 
-                                    0, 
-                                    cell1 
-                                }
-                            );
-                    }
+        const int cam_x = static_cast<int>(camera.get_position().x/20);
+        const int cam_y = static_cast<int>(camera.get_position().y/20);
+
+        // Cells outside of the matrix were always skipped, so the clipped
+        // region consumes the same random numbers in the same order.
+        const auto region = mtx.region(cam_x, cam_y, columns, rows);
+        const int x_end = region.get_x() + region.get_width();
+        const int y_end = region.get_y() + region.get_height();
+
+        for (int mx = region.get_x(); mx < x_end; mx++) {
+            for (int my = region.get_y(); my < y_end; my++) {
+                const matrix_t x = static_cast<matrix_t>(mx - cam_x);
+                const matrix_t y = static_cast<matrix_t>(my - cam_y);
+
+                const auto *cell1 = &region.at(static_cast<matrix_t>(mx), static_cast<matrix_t>(my), 0);
+
+                if (cell1->type == TileType::head && _tiles->tile(*cell1) != nullptr) {
+                    _tiles_to_render1[c]
+                        .push_back(Render_TileCell{ _rand.next(100000), x, y, 0, cell1 });
                 }
 
-                if (mtx.is_in_bounds(mx, my, 1)) {
-                    const auto *cell2 = mtx.get_const_ptr(static_cast<matrix_t>(mx), static_cast<matrix_t>(my), 1);
-
-                    if (cell2 != nullptr && cell2->type == TileType::head && cell2->tile_def != nullptr) {
-                        _tiles_to_render2[c]
-                            .push_back(
-                                Render_TileCell{ 
-                                    _rand.next(100000), 
-                                    static_cast<matrix_t>(x), 
-                                    static_cast<matrix_t>(y), 
-                                    1, 
-                                    cell2 
-                                }
-                            );
-                    }
+                const auto *cell2 = &region.at(static_cast<matrix_t>(mx), static_cast<matrix_t>(my), 1);
+
+                if (cell2->type == TileType::head && _tiles->tile(*cell2) != nullptr) {
+                    _tiles_to_render2[c]
+                        .push_back(Render_TileCell{ _rand.next(100000), x, y, 1, cell2 });
                 }
 
-                if (mtx.is_in_bounds(mx, my, 2)) {
-                    const auto *cell3 = mtx.get_const_ptr(static_cast<matrix_t>(mx), static_cast<matrix_t>(my), 2);
+                const auto *cell3 = &region.at(static_cast<matrix_t>(mx), static_cast<matrix_t>(my), 2);
         
-                    if (cell3 != nullptr && cell3->type == TileType::head && cell3->tile_def != nullptr) {
-                        _tiles_to_render3[c]
-                            .push_back(
-                                Render_TileCell{ 
-                                    _rand.next(100000), 
-                                    static_cast<matrix_t>(x), 
-                                    static_cast<matrix_t>(y), 
-                                    2, 
-                                    cell3 
-                                }
-                            );
-                    }
+                if (cell3->type == TileType::head && _tiles->tile(*cell3) != nullptr) {
+                    _tiles_to_render3[c]
+                        .push_back(Render_TileCell{ _rand.next(100000), x, y, 2, cell3 });
                 }
-
             }
         }
     }
@@ -921,6 +902,8 @@ void Renderer::_prepare() {
         );
     }
 
+    _material_neighbours.build(*_level, *_materials);
+
     size_t cams_num = _config.cameras.empty() ? _level->cameras.size() : _config.cameras.size();
     const auto *default_material = _materials->material(_level->default_material);
 
@@ -941,31 +924,37 @@ void Renderer::_prepare() {
 
         const auto &camera = _config.cameras.empty() ? _level->cameras[c] : _level->cameras[_config.cameras[c]];
 
-        for (int x = 0; x < columns; x++) {
-            for (int y = 0; y < rows; y++) {
-                int cx = x + static_cast<int>(camera.get_position().x/20);
-                int cy = y + static_cast<int>(camera.get_position().y/20);
+        const int cam_x = static_cast<int>(camera.get_position().x/20);
+        const int cam_y = static_cast<int>(camera.get_position().y/20);
 
-                if (!mtx.is_in_bounds(cx, cy, 0)) continue;
+        const auto tiles = mtx.region(cam_x, cam_y, columns, rows);
+        const auto geo_region = geos.region(cam_x, cam_y, columns, rows);
+        const int x_end = tiles.get_x() + tiles.get_width();
+        const int y_end = tiles.get_y() + tiles.get_height();
+
+        for (int cx = tiles.get_x(); cx < x_end; cx++) {
+            for (int cy = tiles.get_y(); cy < y_end; cy++) {
+                const int x = cx - cam_x;
+                const int y = cy - cam_y;
 
                 matrix_t mx = static_cast<matrix_t>(cx);
                 matrix_t my = static_cast<matrix_t>(cy);
 
-                const auto &tile1 = mtx.get_const(mx, my, 0);
-                const auto &tile2 = mtx.get_const(mx, my, 1);
-                const auto &tile3 = mtx.get_const(mx, my, 2);
+                const auto &tile1 = tiles.at(mx, my, 0);
+                const auto &tile2 = tiles.at(mx, my, 1);
+                const auto &tile3 = tiles.at(mx, my, 2);
 
-                const auto &geo1 = geos.get_const(mx, my, 0);
-                const auto &geo2 = geos.get_const(mx, my, 1);
-                const auto &geo3 = geos.get_const(mx, my, 2);
+                const auto &geo1 = geo_region.at(mx, my, 0);
+                const auto &geo2 = geo_region.at(mx, my, 1);
+                const auto &geo3 = geo_region.at(mx, my, 2);
             
                 if (!geo1.is_air()) {
-                    if (tile1.type == TileType::material && tile1.material_def != nullptr) 
+                    if (tile1.type == TileType::material && _materials->material(tile1) != nullptr) 
                     {
                         materials_to_render
                             [c]
                             [0]
-                            [static_cast<size_t>(tile1.material_def->get_type())]
+                            [static_cast<size_t>(_materials->material(tile1)->get_type())]
                             .push_back(Render_MaterialCell(_rand.next(100000), mx, my, 0, x, y, 0, geo1, &tile1));
                     }
                     else if (tile1.type == TileType::_default) {
@@ -978,12 +967,12 @@ void Renderer::_prepare() {
                 }
 
                 if (!geo2.is_air()) {
-                    if (tile2.type == TileType::material && tile2.material_def != nullptr) 
+                    if (tile2.type == TileType::material && _materials->material(tile2) != nullptr) 
                     {
                         materials_to_render
                             [c]
                             [1]
-                            [static_cast<size_t>(tile2.material_def->get_type())]
+                            [static_cast<size_t>(_materials->material(tile2)->get_type())]
                             .push_back(Render_MaterialCell(_rand.next(100000), mx, my, 1, x, y, 1, geo2, &tile2));
                     }
                     else if (tile2.type == TileType::_default) {
@@ -996,12 +985,12 @@ void Renderer::_prepare() {
                 }
 
                 if (!geo3.is_air()) {
-                    if (tile3.type == TileType::material && tile3.material_def != nullptr) 
+                    if (tile3.type == TileType::material && _materials->material(tile3) != nullptr) 
                     {
                         materials_to_render
                             [c]
                             [2]
-                            [static_cast<size_t>(tile3.material_def->get_type())]
+                            [static_cast<size_t>(_materials->material(tile3)->get_type())]
                             .push_back(Render_MaterialCell(_rand.next(100000), mx, my, 0, x, y, 2, geo3, &tile3));
                     }
                     else if (tile3.type == TileType::_default) {
@@ -1070,6 +1059,8 @@ void Renderer::_prepare() {
         _random_machines.push_back(t);
     }
 
+    _plan_unified_materials();
+
     _preparation_done = true;
 }
 
@@ -1146,6 +1137,8 @@ bool Renderer::frame_render() {
             _draw_prop(p.get());
         }
 
+        _commands.flush();
+
         _set_render_progress(RENDER_PROGRESS_EFFECTS);
         return false;
     }
@@ -1207,7 +1200,7 @@ bool Renderer::_is_material(int x, int y, int z, const MaterialDef *def) {
     const auto &tile = tiles.get_const(mx, my, mz);
 
     if (tile.type == TileType::material) {
-        return tile.material_def == def;
+        return _materials->material(tile) == def;
     } else if (tile.type == TileType::_default) {
         return def->get_name() == _level->default_material;
     }
@@ -1218,36 +1211,34 @@ bool Renderer::_is_material(int x, int y, int z, const MaterialDef *def) {
 void Renderer::_render_poles_layer(uint8_t layer) {
     if (layer > 2) return;
 
-    const auto &geos = _level->get_const_geo_matrix();
+    const auto &planes = _level->get_feature_planes();
 
     BeginTextureMode(_layers[layer * 10 + 4]);
 
-    for (int x = 0; x < columns; x++) {
-        for (int y = 0; y < rows; y++) {
-            const int mx = x + static_cast<int>(_camera->get_position().x/20);
-            const int my = y + static_cast<int>(_camera->get_position().y/20);
+    const int cam_x = static_cast<int>(_camera->get_position().x/20);
+    const int cam_y = static_cast<int>(_camera->get_position().y/20);
 
-            if (!geos.is_in_bounds(mx, my, layer)) continue;
+    // Only cells with poles are visited; both kinds are drawn in the same
+    // opaque color, so drawing one kind after the other looks the same.
+    planes.for_each(GeoFeature::vertical_pole, layer, cam_x, cam_y, columns, rows, [&](matrix_t mx, matrix_t my) {
+        const int x = mx - cam_x;
+        const int y = my - cam_y;
 
-            const auto &geo = geos.get_const(static_cast<matrix_t>(mx), static_cast<matrix_t>(my), layer);
+        DrawRectangleRec(
+            Rectangle{x * 20.0f + 8, y * 20.0f, 4.0f, 20.0f}, 
+            Color{255, 0, 0, 255}
+        );
+    });
 
-            // if (geo.is_solid()) continue;
+    planes.for_each(GeoFeature::horizontal_pole, layer, cam_x, cam_y, columns, rows, [&](matrix_t mx, matrix_t my) {
+        const int x = mx - cam_x;
+        const int y = my - cam_y;
 
-            if (geo.has_feature(GeoFeature::vertical_pole)) {
-                DrawRectangleRec(
-                    Rectangle{x * 20.0f + 8, y * 20.0f, 4.0f, 20.0f}, 
-                    Color{255, 0, 0, 255}
-                );
-            }
-
-            if (geo.has_feature(GeoFeature::horizontal_pole)) {
-                DrawRectangleRec(
-                    Rectangle{x * 20.0f, y * 20.0f + 8, 20.0f, 4.0f}, 
-                    Color{255, 0, 0, 255}
-                );
-            }
-        }
-    }
+        DrawRectangleRec(
+            Rectangle{x * 20.0f, y * 20.0f + 8, 20.0f, 4.0f}, 
+            Color{255, 0, 0, 255}
+        );
+    });
 
     EndTextureMode();
 }
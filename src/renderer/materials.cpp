@@ -50,6 +50,98 @@ bool Renderer::_frame_render_materials_layer(uint8_t layer, int threshold) {
     return _material_progress >= 3;
 }
 
+void Renderer::_plan_unified_materials() {
+    _unified_materials.assign(_materials->materials().size(), Render_UnifiedMaterial());
+    _unified_materials_loaded = false;
+
+    const auto *default_material = _materials->material(_level->default_material);
+    const auto unified = static_cast<size_t>(MaterialRenderType::unified);
+
+    for (auto &camera : _materials_to_render) {
+        for (auto &layer : camera) {
+            // Copied, since a queue can't be iterated.
+            auto cells = layer[unified];
+
+            while (!cells.empty()) {
+                const auto *tile = cells.front().tile;
+                const auto *def = tile->type == TileType::material ? _materials->material(*tile) : default_material;
+
+                if (def != nullptr && def->get_id() < _unified_materials.size()) {
+                    _unified_materials[def->get_id()].used = true;
+                }
+
+                cells.pop();
+            }
+        }
+    }
+
+    for (size_t id = 0; id < _unified_materials.size(); id++) {
+        auto &plan = _unified_materials[id];
+        if (!plan.used) continue;
+
+        const auto &name = _materials->material(static_cast<def_id_t>(id))->get_name();
+
+        plan.textured =
+            name == "Concrete" || 
+            name == "RainStone" || 
+            name == "Bricks" || 
+            name == "Tiny Signs" || 
+            name == "Cliff" ||
+            name == "Non-Slip Metal" ||
+            name == "BulkMetal" || 
+            name == "MassiveBulkMetal" || 
+            name == "Asphalt";
+
+        if (plan.textured) plan.texture_member = _castlibs->member(name + "Texture");
+
+        if (name == "Scaffolding") plan.tileset_member = _castlibs->member("ScaffoldingDR");
+        else if (name == "Invisible") plan.tileset_member = _castlibs->member("Superstructure");
+        else plan.tileset_member = _castlibs->member("tileSet" + name);
+    }
+}
+
+void Renderer::_load_unified_materials() {
+    // The largest tileset rectangle drawn by _frame_render_unified_layer();
+    // smaller tilesets keep their own texture, since the shader draws out
+    // of bounds samples as white.
+    static const float tileset_width = 220, tileset_height = 80;
+
+    _unified_atlas.clear();
+
+    std::vector<TextureAtlas::handle_t> handles(_unified_materials.size());
+
+    for (size_t id = 0; id < _unified_materials.size(); id++) {
+        const auto *member = _unified_materials[id].tileset_member;
+        if (member != nullptr) handles[id] = _unified_atlas.add(member->get_texture_path());
+    }
+
+    _unified_atlas.build();
+
+    for (size_t id = 0; id < _unified_materials.size(); id++) {
+        auto &plan = _unified_materials[id];
+
+        // Overlay textures are sampled with wrapped coordinates,
+        // so they can't be packed.
+        if (plan.texture_member != nullptr) plan.texture = plan.texture_member->get_loaded_texture();
+
+        if (plan.tileset_member == nullptr) continue;
+
+        const auto region = _unified_atlas.region(handles[id]);
+
+        if (region.is_packed() && region.rect.width >= tileset_width && region.rect.height >= tileset_height) {
+            plan.tileset = *region.texture;
+            plan.tileset_origin = Vector2{ region.rect.x, region.rect.y };
+            plan.tileset_keyed = true;
+        } else {
+            plan.tileset = plan.tileset_member->get_loaded_texture();
+            plan.tileset_origin = Vector2{ 0, 0 };
+            plan.tileset_keyed = false;
+        }
+    }
+
+    _unified_materials_loaded = true;
+}
+
 bool Renderer::_frame_render_unified_layer(uint8_t layer, int threshold) {
     if (layer > 2 || threshold <= 0) return true;
 
@@ -58,14 +150,23 @@ bool Renderer::_frame_render_unified_layer(uint8_t layer, int threshold) {
     uint8_t sublayer = layer * 10;
     auto *default_material = _materials->material(_level->default_material);
     MaterialDef *def = nullptr;
+    const Render_UnifiedMaterial *plan = nullptr;
     Rectangle rect;
-    CastMember *tileset = nullptr, *mat_texture = nullptr;
 
     Texture2D ts_texture, texture;
 
     std::pair<ivec2, ivec2> profl;
     int gt_at_v = 0, gt_at_h = 0;
     Rectangle pst_rect;
+    uint8_t neighbours = 0;
+
+    // Packed tilesets are keyed, and need no shader.
+    auto draw_tileset = [&](const RenderTexture2D &to, Rectangle src, Rectangle dst) {
+        if (plan->tileset_keyed) _commands.draw_keyed(to, ts_texture, src, dst);
+        else _commands.draw(to, _white_remover, _white_remover_texture_loc, ts_texture, src, dst);
+    };
+
+    if (!_unified_materials_loaded) _load_unified_materials();
 
     while (progress < threshold && !queue.empty()) {
         
@@ -73,7 +174,7 @@ bool Renderer::_frame_render_unified_layer(uint8_t layer, int threshold) {
 
         if (cell.geo.is_air()) goto skip;
         if (
-            (cell.tile->type == TileType::material && cell.tile->material_def == nullptr) || 
+            (cell.tile->type == TileType::material && _materials->material(*cell.tile) == nullptr) || 
             (
                 cell.tile->type == TileType::_default && 
                 (
@@ -82,29 +183,20 @@ bool Renderer::_frame_render_unified_layer(uint8_t layer, int threshold) {
             )
         ) goto skip;
 
-        def = cell.tile->type == TileType::material ? cell.tile->material_def : default_material;
+        def = cell.tile->type == TileType::material ? _materials->material(*cell.tile) : default_material;
 
-        if (
-            def->get_name() == "Concrete" || 
-            def->get_name() == "RainStone" || 
-            def->get_name() == "Bricks" || 
-            def->get_name() == "Tiny Signs" || 
-            def->get_name() == "Cliff" ||
-            def->get_name() == "Non-Slip Metal" ||
-            def->get_name() == "BulkMetal" || 
-            def->get_name() == "MassiveBulkMetal" || 
-            def->get_name() == "Asphalt")
-        {
-            mat_texture = _castlibs->member(def->get_name() + "Texture");
-            if (mat_texture == nullptr) continue;
-            texture = mat_texture->get_loaded_texture();
-            if (!mat_texture->is_loaded()) continue;
+        if (def->get_id() >= _unified_materials.size()) goto skip;
+        plan = &_unified_materials[def->get_id()];
+
+        if (plan->textured) {
+            if (plan->texture_member == nullptr) goto skip;
+            texture = plan->texture;
 
             if (cell.geo.is_solid()) {
-                BeginTextureMode(_layers[sublayer]);
-                BeginShaderMode(_white_remover);
-                SetShaderValueTexture(_white_remover, _white_remover_texture_loc, texture);
-                DrawTexturePro(
+                _commands.draw(
+                    _layers[sublayer],
+                    _white_remover,
+                    _white_remover_texture_loc,
                     texture,
                     Rectangle {
                         (cell.x * 20) % texture.width * 1.0f,
@@ -117,27 +209,18 @@ bool Renderer::_frame_render_unified_layer(uint8_t layer, int threshold) {
                         cell.y * 20.0f,
                         20.0f,
                         20.0f
-                    },
-                    Vector2 {0, 0},
-                    0,
-                    WHITE
+                    }
                 );
-                EndShaderMode();
-                EndTextureMode();
             }
         }
 
         rect = { cell.x * 20.0f, cell.y * 20.0f, 20.0f, 20.0f };
-        
-        if (def->get_name() == "Scaffolding") tileset = _castlibs->member("ScaffoldingDR");
-        else if (def->get_name() == "Invisible") tileset = _castlibs->member("Superstructure");
-        else tileset = _castlibs->member("tileSet" + def->get_name());
 
-        if (tileset == nullptr) continue;
-        ts_texture = tileset->get_loaded_texture();
-        if (!tileset->is_loaded()) continue;
+        if (plan->tileset_member == nullptr) goto skip;
+        ts_texture = plan->tileset;
 
         if (cell.geo.is_solid()) {
+            neighbours = _material_neighbours.at(cell.mx, cell.my, layer);
 
             for (int f = 1; f <= 4; f++) {
                 switch (f) {
@@ -185,29 +268,17 @@ bool Renderer::_frame_render_unified_layer(uint8_t layer, int threshold) {
 
                 uint8_t id = 0;
 
-                auto first = _is_material(
-                    cell.mx + profl.first.x, 
-                    cell.my + profl.first.y, 
-                    layer, 
-                    def
-                );
-                auto second = _is_material(
-                    cell.mx + profl.second.x, 
-                    cell.my + profl.second.y, 
-                    layer, 
-                    def
-                );
+                auto first = (neighbours & MaterialNeighbours::bit(profl.first.x, profl.first.y)) != 0;
+                auto second = (neighbours & MaterialNeighbours::bit(profl.second.x, profl.second.y)) != 0;
             
                 if (first) id |= 0b00000010;
                 if (second) id |= 0b00000001;
 
                 if (id == 3) {
                     if (
-                        _is_material(
-                            cell.mx + profl.first.x + profl.second.x,
-                            cell.my + profl.first.y + profl.second.y,
-                            layer,
-                            def
+                        neighbours & MaterialNeighbours::bit(
+                            profl.first.x + profl.second.x,
+                            profl.first.y + profl.second.y
                         )
                     ) {
                         gt_at_h = 10;
@@ -239,56 +310,24 @@ bool Renderer::_frame_render_unified_layer(uint8_t layer, int threshold) {
                 }
 
                 auto gt_rect = Rectangle {
-                    (gt_at_h - 1)*10.0f,
-                    (gt_at_v - 1)*10.0f,
+                    (gt_at_h - 1)*10.0f + plan->tileset_origin.x,
+                    (gt_at_v - 1)*10.0f + plan->tileset_origin.y,
                     10.0f, 10.0f
                 };
 
-                BeginTextureMode(_layers[sublayer]);
-                BeginShaderMode(_white_remover);
-                SetShaderValueTexture(_white_remover, _white_remover_texture_loc, ts_texture);
-                DrawTexturePro(
-                    ts_texture,
-                    gt_rect,
-                    Rectangle {
-                        pst_rect.x,
-                        pst_rect.y,
-                        pst_rect.width,
-                        pst_rect.height
-                    },
-                    // pst_rect,
-                    Vector2 {0, 0},
-                    0,
-                    WHITE
-                );
-                EndShaderMode();
-                EndTextureMode();
+                draw_tileset(_layers[sublayer], gt_rect, pst_rect);
 
                 for (int l = 1; l < 10; l++) {
-                    BeginTextureMode(_layers[sublayer + l]);
-                    BeginShaderMode(_white_remover);
-                    SetShaderValueTexture(_white_remover, _white_remover_texture_loc, ts_texture);
-                    DrawTexturePro(
-                        ts_texture,
+                    draw_tileset(
+                        _layers[sublayer + l],
                         Rectangle {
                             gt_rect.x + 120,
                             gt_rect.y,
                             gt_rect.width,
                             gt_rect.height
                         },
-                        Rectangle {
-                            pst_rect.x,
-                            pst_rect.y,
-                            pst_rect.width,
-                            pst_rect.height
-                        },
-                        // pst_rect,
-                        Vector2 {0, 0},
-                        0,
-                        WHITE
+                        pst_rect
                     );
-                    EndShaderMode();
-                    EndTextureMode();
                 }
             }
 
@@ -300,6 +339,8 @@ bool Renderer::_frame_render_unified_layer(uint8_t layer, int threshold) {
         progress++;
     }
 
+    _commands.flush();
+
     return queue.empty();
 }
 
@@ -460,20 +501,21 @@ bool Renderer::_frame_render_pipe_layer(uint8_t layer, int threshold) {
 
         if (cell.geo.is_air()) continue;
 
-        auto *tiles = get_tiles(cell.tile->material_def);
+        auto *material = _materials->material(*cell.tile);
+        auto *tiles = get_tiles(material);
         if (tiles == nullptr) continue;
         const Texture2D &texture = tiles->get_loaded_texture();
         if (!tiles->is_loaded()) continue;
 
-        trash = cell.tile->material_def->get_name() == "Trash";
+        trash = material->get_name() == "Trash";
 
-        uint8_t connection = get_connection(cell.tile->material_def, cell.mx, cell.my);
+        uint8_t connection = get_connection(material, cell.mx, cell.my);
 
         if (connection == 0) continue;
 
         auto pos = get_src_pos(connection);
 
-        if (cell.tile->material_def->get_name() == "Small Pipes") {
+        if (material->get_name() == "Small Pipes") {
             BeginTextureMode(_layers[sublayer + 5]);
             DrawRectangleLinesEx(
                 Rectangle { cell.x * 20.0f, cell.y * 20.0f, 20.0f, 20.0f },
@@ -602,7 +644,7 @@ bool Renderer::_frame_render_tiles_layer(uint8_t layer, int threshold) {
     const auto &geos = _level->get_const_geo_matrix();
     Matrix<bool> taken(_level->get_width(), _level->get_height(), 1);
 
-    const auto fits = [&taken, &tiles, &geos, layer, default_material](const TileDef *tile, const MaterialDef *mat, matrix_t mx, matrix_t my){
+    const auto fits = [this, &taken, &tiles, &geos, layer, default_material](const TileDef *tile, const MaterialDef *mat, matrix_t mx, matrix_t my){
         for (int w = 0; w < tile->get_width(); w++) {
             for (int h = 0; h < tile->get_height(); h++) {
                 if (taken.get_copy(mx + w, my + h, 0)) return false;
@@ -614,7 +656,7 @@ bool Renderer::_frame_render_tiles_layer(uint8_t layer, int threshold) {
                 
                 const auto &tilecell = tiles.get_const(mx + w, my + h, layer);
                 if (
-                    tilecell.type == TileType::material && tilecell.material_def != mat || 
+                    tilecell.type == TileType::material && _materials->material(tilecell) != mat || 
                     tilecell.type == TileType::_default && mat != default_material
                 ) return false;
             }
@@ -644,11 +686,11 @@ bool Renderer::_frame_render_tiles_layer(uint8_t layer, int threshold) {
 
         const auto &cell = queue.front();
 
-        if (cell.tile->material_def == chaotic_stone) {
+        if (_materials->material(*cell.tile) == chaotic_stone) {
             
-        } else if (cell.tile->material_def == tiled_stone) {
+        } else if (_materials->material(*cell.tile) == tiled_stone) {
 
-        } else if (cell.tile->material_def == random_machines) {
+        } else if (_materials->material(*cell.tile) == random_machines) {
             
         }
 
@@ -687,7 +729,7 @@ bool Renderer::_frame_render_bricks_layer(uint8_t layer, int threshold) {
 
             if (cell.type != TileType::_default && cell.type != TileType::material) continue;
             if (cell.type == TileType::_default && skip_default) continue;
-            if (cell.type == TileType::material && cell.material_def != def) continue;
+            if (cell.type == TileType::material && _materials->material(cell) != def) continue;
 
             const float x = _material_progress_x*20.0f;
             const float y = _material_progress_y*20.0f;
@@ -737,7 +779,7 @@ void Renderer::_render_bricks_layer(uint8_t layer) {
 
             if (cell.type != TileType::_default && cell.type != TileType::material) continue;
             if (cell.type == TileType::_default && skip_default) continue;
-            if (cell.type == TileType::material && cell.material_def != def) continue;
+            if (cell.type == TileType::material && _materials->material(cell) != def) continue;
 
             DrawTexturePro(
                 texture,
@@ -812,7 +854,7 @@ void Renderer::_render_concrete_layer(u_int8_t layer) {
 
             if (cell.type != TileType::_default && cell.type != TileType::material) continue;
             if (cell.type == TileType::_default && skip_default) continue;
-            if (cell.type == TileType::material && cell.material_def != def) continue;
+            if (cell.type == TileType::material && _materials->material(cell) != def) continue;
 
             mr::draw::draw_geo_texture(texture, geo, x * 20.0f, y * 20.0f);
         }
@@ -879,7 +921,7 @@ void Renderer::_render_standard_layer(uint8_t layer) {
 
             if (cell.type != TileType::_default && cell.type != TileType::material) continue;
             if (cell.type == TileType::_default && skip_default) continue;
-            if (cell.type == TileType::material && cell.material_def != def) continue;
+            if (cell.type == TileType::material && _materials->material(cell) != def) continue;
 
             DrawRectangle(mx * 20, my * 20, 20, 20, Color{0, 255, 0, 255});
         }
@@ -968,16 +1010,16 @@ void Renderer::_render_chaotic_stone_layer(uint8_t layer) {
             !br_geo->is_solid();
 
 
-        if (tl_tile->type == TileType::material && tl_tile->material_def != def) tl_taken = true;
+        if (tl_tile->type == TileType::material && _materials->material(*tl_tile) != def) tl_taken = true;
         else if (tl_tile->type == TileType::_default && skip_default) tl_taken = true;
 
-        if (tr_tile->type == TileType::material && tr_tile->material_def != def) tr_taken = true;
+        if (tr_tile->type == TileType::material && _materials->material(*tr_tile) != def) tr_taken = true;
         else if (tr_tile->type == TileType::_default && skip_default) tr_taken = true;
 
-        if (br_tile->type == TileType::material && br_tile->material_def != def) br_taken = true;
+        if (br_tile->type == TileType::material && _materials->material(*br_tile) != def) br_taken = true;
         else if (br_tile->type == TileType::_default && skip_default) br_taken = true;
 
-        if (bl_tile->type == TileType::material && bl_tile->material_def != def) bl_taken = true;
+        if (bl_tile->type == TileType::material && _materials->material(*bl_tile) != def) bl_taken = true;
         else if (bl_tile->type == TileType::_default && skip_default) bl_taken = true;
 
         space.set_noexcept(x    , y    , 0, tl_taken);
@@ -1031,7 +1073,7 @@ void Renderer::_render_chaotic_stone_layer(uint8_t layer) {
                 space.set_noexcept(x, y, 0, true);
                 continue;
             }
-            if ((cell.type == TileType::material && cell.material_def != def) || (cell.type == TileType::_default && skip_default)) {
+            if ((cell.type == TileType::material && _materials->material(cell) != def) || (cell.type == TileType::_default && skip_default)) {
                 space.set_noexcept(x, y, 0, true);
                 continue;
             }
@@ -1559,14 +1601,14 @@ void Renderer::_render_bigmetal_layer(uint8_t layer) {
 
     bool skip_default = _level->default_material != def->get_name();
 
-    static const auto LEFT         = static_cast<uint8_t>(0b10000000);
-    static const auto TOP          = static_cast<uint8_t>(0b01000000);
-    static const auto RIGHT        = static_cast<uint8_t>(0b00100000);
-    static const auto BOTTOM       = static_cast<uint8_t>(0b00010000);
-    static const auto TOP_LEFT     = static_cast<uint8_t>(0b00001000);
-    static const auto TOP_RIGHT    = static_cast<uint8_t>(0b00000100);
-    static const auto BOTTOM_RIGHT = static_cast<uint8_t>(0b00000010);
-    static const auto BOTTOM_LEFT  = static_cast<uint8_t>(0b00000001);
+    static const auto LEFT         = MaterialNeighbours::left;
+    static const auto TOP          = MaterialNeighbours::top;
+    static const auto RIGHT        = MaterialNeighbours::right;
+    static const auto BOTTOM       = MaterialNeighbours::bottom;
+    static const auto TOP_LEFT     = MaterialNeighbours::top_left;
+    static const auto TOP_RIGHT    = MaterialNeighbours::top_right;
+    static const auto BOTTOM_RIGHT = MaterialNeighbours::bottom_right;
+    static const auto BOTTOM_LEFT  = MaterialNeighbours::bottom_left;
 
     auto src_v = Rectangle { 30.0f, 10.0f, 10.0f, 10.0f };
     auto src_h = Rectangle { 50.0f, 10.0f, 10.0f, 10.0f };
@@ -1606,7 +1648,7 @@ void Renderer::_render_bigmetal_layer(uint8_t layer) {
             if (geo.is_air()) continue;
             if (tile.type != TileType::material && tile.type != TileType::_default) continue;
             if (
-                (tile.type == TileType::material && tile.material_def != def) || 
+                (tile.type == TileType::material && _materials->material(tile) != def) || 
                 (tile.type == TileType::_default && skip_default)
             ) continue;
 
@@ -1615,27 +1657,8 @@ void Renderer::_render_bigmetal_layer(uint8_t layer) {
                 Color { 0, 255, 0, 255 }
             );
 
-            uint8_t connection = 0;
-
-            auto left = _is_material(mx - 1, my, layer, def);
-            auto top = _is_material(mx, my - 1, layer, def);
-            auto right = _is_material(mx + 1, my, layer, def);
-            auto bottom = _is_material(mx, my + 1, layer, def);
-
-            auto topleft = _is_material(mx - 1, my - 1, layer, def);
-            auto topright = _is_material(mx + 1, my - 1, layer, def);
-            auto bottomright = _is_material(mx + 1, my + 1, layer, def);
-            auto bottomleft = _is_material(mx - 1, my + 1, layer, def);
-
-            if (left) connection |= LEFT;
-            if (top) connection |= TOP;
-            if (right) connection |= RIGHT;
-            if (bottom) connection |= BOTTOM;
-
-            if (topleft) connection |= TOP_LEFT;
-            if (topright) connection |= TOP_RIGHT;
-            if (bottomright) connection |= BOTTOM_RIGHT;
-            if (bottomleft) connection |= BOTTOM_LEFT;
+            // The cell is BigMetal, so these are its BigMetal neighbours.
+            const uint8_t connection = _material_neighbours.at(mx, my, layer);
 
 
             Rectangle tl_target = { x * 20.0f        , y * 20.0f        , 10.0f, 10.0f };
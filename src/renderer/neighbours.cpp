@@ -0,0 +1,117 @@
+#include <vector>
+#include <thread>
+#include <cstdint>
+#include <algorithm>
+
+#include <MobitRenderer/dex.h>
+#include <MobitRenderer/level.h>
+#include <MobitRenderer/matrix.h>
+#include <MobitRenderer/registry.h>
+#include <MobitRenderer/renderer.h>
+#include <MobitRenderer/definitions.h>
+
+namespace mr::renderer {
+
+/// @brief Calls f(first_row, end_row) over bands of rows, on as many
+/// threads as there are cores.
+template <typename F> static void for_each_row_band(int rows, F &&f) {
+    const int min_band = 16;
+
+    const int threads = std::max(1, std::min<int>(std::thread::hardware_concurrency(), rows / min_band));
+    const int band = (rows + threads - 1) / threads;
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+
+    for (int t = 1; t < threads; t++) {
+        const int begin = t * band, end = std::min(rows, begin + band);
+        if (begin >= end) break;
+
+        workers.emplace_back([&f, begin, end]() { f(begin, end); });
+    }
+
+    f(0, std::min(rows, band));
+
+    for (auto &w : workers) w.join();
+}
+
+void MaterialNeighbours::build(const Level &level, const MaterialDex &materials) {
+    const auto &geos = level.get_const_geo_matrix();
+    const auto &tiles = level.get_const_tile_matrix();
+
+    _width = std::min(geos.get_width(), tiles.get_width());
+    _height = std::min(geos.get_height(), tiles.get_height());
+    _depth = std::min(geos.get_depth(), tiles.get_depth());
+
+    const size_t size = static_cast<size_t>(_width) * _height * _depth;
+
+    _masks.assign(size, 0);
+    if (size == 0) return;
+
+    const auto *default_material = materials.material(level.default_material);
+    const def_id_t default_id = default_material == nullptr ? no_def_id : default_material->get_id();
+
+    // The material of each cell, and whether its geometry lets it
+    // be a neighbour.
+    std::vector<def_id_t> keys(size, no_def_id);
+    std::vector<uint8_t> solid(size, 0);
+
+    const auto geo_view = geos.region(0, 0, _width, _height);
+    const auto tile_view = tiles.region(0, 0, _width, _height);
+
+    for_each_row_band(_height, [&](int y0, int y1) {
+        for (matrix_t z = 0; z < _depth; z++) {
+            for (int y = y0; y < y1; y++) {
+                for (matrix_t x = 0; x < _width; x++) {
+                    const auto i = _index(x, y, z);
+
+                    const auto &tile = tile_view.at(x, y, z);
+                    const auto &geo = geo_view.at(x, y, z);
+
+                    if (tile.type == TileType::material) {
+                        const auto *def = materials.material(tile);
+                        if (def != nullptr) keys[i] = def->get_id();
+                    } else if (tile.type == TileType::_default) {
+                        keys[i] = default_id;
+                    }
+
+                    solid[i] = geo.is_solid() || geo.is_slope();
+                }
+            }
+        }
+    });
+
+    for_each_row_band(_height, [&](int y0, int y1) {
+        for (matrix_t z = 0; z < _depth; z++) {
+            for (int y = y0; y < y1; y++) {
+                for (int x = 0; x < _width; x++) {
+                    const auto i = _index(x, y, z);
+
+                    const auto key = keys[i];
+                    if (key == no_def_id) continue;
+
+                    uint8_t mask = 0;
+
+                    for (int dy = -1; dy <= 1; dy++) {
+                        const int ny = y + dy;
+                        if (ny < 0 || ny >= _height) continue;
+
+                        for (int dx = -1; dx <= 1; dx++) {
+                            const int nx = x + dx;
+                            if (nx < 0 || nx >= _width || (dx == 0 && dy == 0)) continue;
+
+                            const auto n = _index(nx, ny, z);
+                            if (solid[n] && keys[n] == key) mask |= bit(dx, dy);
+                        }
+                    }
+
+                    _masks[i] = mask;
+                }
+            }
+        }
+    });
+}
+
+MaterialNeighbours::MaterialNeighbours() : _width(0), _height(0), _depth(0) {}
+
+};
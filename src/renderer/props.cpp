@@ -62,18 +62,14 @@ void Renderer::_draw_prop(Prop *prop) noexcept {
             for (size_t s = 0; s < def->get_repeat()[l]; s++) {
                 if (starting_depth >= 30) break;
 
-                BeginTextureMode(_layers[starting_depth]);
-                // BeginShaderMode(_white_remover);
-                // SetShaderValueTexture(_white_remover, _white_remover_texture_loc, texture);
-                BeginShaderMode(_invb);
-                SetShaderValueTexture(_invb, _invb_texture_loc, texture);
-                SetShaderValueV(_invb, _invb_vertices_loc, vertices, SHADER_UNIFORM_VEC2, 4);
-                SetShaderValueV(_invb, _invb_tex_coord_loc, coords, SHADER_UNIFORM_FLOAT, 4);
-
-                mr::draw::draw_texture(texture, quad);
-
-                EndShaderMode();
-                EndTextureMode();
+                DrawRecorder::QuadUniforms uniforms = {
+                    _invb_vertices_loc,
+                    _invb_tex_coord_loc,
+                    { vertices[0], vertices[1], vertices[2], vertices[3] },
+                    { coords[0], coords[1], coords[2], coords[3] }
+                };
+
+                _commands.draw_quad(_layers[starting_depth], _invb, _invb_texture_loc, texture, quad, uniforms);
 
                 starting_depth++;
             }
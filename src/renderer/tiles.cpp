@@ -14,7 +14,6 @@
 #include <MobitRenderer/vec.h>
 #include <MobitRenderer/dirs.h>
 #include <MobitRenderer/draw.h>
-#include <MobitRenderer/sdraw.h>
 #include <MobitRenderer/level.h>
 #include <MobitRenderer/utils.h>
 #include <MobitRenderer/state.h>
@@ -27,8 +26,44 @@ namespace mr::renderer {
 void Renderer::_draw_tile_origin_mtx(TileDef *def, matrix_t x, matrix_t y, uint8_t layer) noexcept {
     if (def == nullptr || layer > 2) return;
 
-    auto texture = def->get_loaded_texture();
-    if (!def->is_texture_loaded()) return;
+    // Only the effect color layers are drawn from the texture itself;
+    // other tiles need just the keyed texture.
+    const bool darkest = def->has_tag(tags::effect_color_a) || def->has_tag(tags::effect_color_b);
+
+    if (darkest) def->load_textures();
+    else def->load_keyed_texture();
+
+    const auto &keyed = def->get_keyed_texture();
+    const bool is_keyed = def->is_keyed_texture_loaded();
+
+    if (!is_keyed || darkest) {
+        def->load_texture();
+        if (!def->is_texture_loaded()) return;
+    }
+
+    // Keyed draws skip the white remover shader, so they batch across
+    // tiles. The shader paints outside of the texture white, which the
+    // keyed texture can't, so such draws keep using it, loading the
+    // texture if they are the first to need it.
+    auto draw = [&](const RenderTexture2D &to, Rectangle src, Rectangle dst) {
+        const bool inside =
+            src.x >= 0 && src.y >= 0 &&
+            src.width >= 0 && src.height >= 0 &&
+            src.x + src.width <= keyed.width &&
+            src.y + src.height <= keyed.height;
+
+        if (is_keyed && inside) {
+            _commands.draw_keyed(to, keyed, src, dst);
+            return;
+        }
+
+        const auto &texture = def->get_loaded_texture();
+        if (!def->is_texture_loaded()) return;
+
+        _commands.draw(to, _white_remover, _white_remover_texture_loc, texture, src, dst);
+    };
+
+    const auto &texture = def->get_texture();
 
     auto offset = def->get_head_offset();
 
@@ -65,19 +100,7 @@ void Renderer::_draw_tile_origin_mtx(TileDef *def, matrix_t x, matrix_t y, uint8
             for (size_t s = 0; s < def->get_repeat()[l]; s++) {
                 if (comm >= 30) break;
                 
-                BeginTextureMode(_layers[comm]);
-                BeginShaderMode(_white_remover);
-                SetShaderValueTexture(_white_remover, _white_remover_texture_loc, texture);
-                DrawTexturePro(
-                    texture,
-                    src,
-                    target,
-                    Vector2{0,0},
-                    0,
-                    WHITE
-                );
-                EndShaderMode();
-                EndTextureMode();
+                draw(_layers[comm], src, target);
 
                 comm++;
             }
@@ -100,26 +123,16 @@ void Renderer::_draw_tile_origin_mtx(TileDef *def, matrix_t x, matrix_t y, uint8
 
         for (int l = 0; l < 10; l++) {
 
-            BeginTextureMode(_layers[layer * 10 + l]);
-            BeginShaderMode(_white_remover);
-            SetShaderValueTexture(_white_remover, _white_remover_texture_loc, texture);
-    
-            DrawTexturePro(
-                texture,
+            draw(
+                _layers[layer * 10 + l],
                 Rectangle {
                     0, 
                     static_cast<float>(def->get_width() * def->get_height() * 20),
                     width,
                     height
                 },
-                target,
-                Vector2{0, 0},
-                0,
-                WHITE
+                target
             );
-    
-            EndShaderMode();
-            EndTextureMode();
         }
     }
     break;
@@ -130,27 +143,17 @@ void Renderer::_draw_tile_origin_mtx(TileDef *def, matrix_t x, matrix_t y, uint8
         int limit = mr::utils::clamp(l + 9 + !def->get_specs2().empty() * 10, 0, 29);
 
         while (l < limit) {
-            BeginTextureMode(_layers[l]);
-            BeginShaderMode(_white_remover);
-            SetShaderValueTexture(_white_remover, _white_remover_texture_loc, texture);
-
-            DrawTexturePro(
-                texture,
+            draw(
+                _layers[l],
                 Rectangle {
                     width * _rand.next(def->get_rnd()),
                     0,
                     width,
                     height
                 },
-                target,
-                Vector2{0,0},
-                0,
-                WHITE
+                target
             );
 
-            EndShaderMode();
-            EndTextureMode();
-
             l++;
         }
     }
@@ -213,30 +216,12 @@ void Renderer::_draw_tile_origin_mtx(TileDef *def, matrix_t x, matrix_t y, uint8
         }
 
         //                   v    _frontImg was used instead
-        BeginTextureMode(_layers[sublayer]);
-        BeginShaderMode(_white_remover);
-        SetShaderValueTexture(_white_remover, _white_remover_texture_loc, texture);
-
-        DrawTexturePro(
-            texture,
-            src1,
-            target1,
-            Vector2{0, 0},
-            0,
-            WHITE
-        );
-
-        DrawTexturePro(
-            texture,
-            src2,
-            target2,
-            Vector2{0, 0},
-            0,
-            WHITE
-        );
+        draw(_layers[sublayer], src1, target1);
+        draw(_layers[sublayer], src2, target2);
 
-        EndShaderMode();
-        EndTextureMode();
+        const bool colored = def->has_tag(tags::colored);
+        const bool eff1 = def->has_tag(tags::effect_color_a);
+        const bool eff2 = def->has_tag(tags::effect_color_b);
 
         auto d = -1;
 
@@ -248,41 +233,28 @@ void Renderer::_draw_tile_origin_mtx(TileDef *def, matrix_t x, matrix_t y, uint8
 
                 if (d + sublayer > 29) goto out;
 
-                BeginTextureMode(_layers[d + sublayer]);
-                BeginShaderMode(_white_remover);
-                SetShaderValueTexture(_white_remover, _white_remover_texture_loc, texture);
-
-                DrawTexturePro(
-                    texture,
+                draw(
+                    _layers[d + sublayer],
                     Rectangle {
                         src1.x,
                         src1.y + src1.height*l,
                         src1.width,
                         src1.height
                     },
-                    target1,
-                    Vector2 {0, 0},
-                    0,
-                    WHITE
+                    target1
                 );
 
-                DrawTexturePro(
-                    texture,
+                draw(
+                    _layers[d + sublayer],
                     Rectangle {
                         src2.x,
                         src2.y + src2.height*l,
                         src2.width,
                         src2.height
                     },
-                    target2,
-                    Vector2 {0, 0},
-                    0,
-                    WHITE
+                    target2
                 );
 
-                EndShaderMode();
-                EndTextureMode();
-
                 auto src11 = src1;
                 auto src22 = src2;
 
@@ -292,49 +264,19 @@ void Renderer::_draw_tile_origin_mtx(TileDef *def, matrix_t x, matrix_t y, uint8
                 src22.x = src2.x + width;
                 src22.y = src2.height * l + height;
 
-                bool colored = def->get_tags().count("colored");
-                bool eff1 = def->get_tags().count("effectColorA");
-                bool eff2 = def->get_tags().count("effectColorB");
-
                 if (colored && !eff1 && !eff2) {
-                    BeginTextureMode(_dc_layers[d + sublayer]);
-                    BeginShaderMode(_white_remover);
-                    SetShaderValueTexture(_white_remover, _white_remover_texture_loc, texture);
-
-                    DrawTexturePro(
-                        texture,
-                        src11,
-                        target1,
-                        Vector2 {0, 0},
-                        0,
-                        WHITE
-                    );
-    
-                    DrawTexturePro(
-                        texture,
-                        src22,
-                        target2,
-                        Vector2 {0, 0},
-                        0,
-                        WHITE
-                    );
-
-                    EndShaderMode();
-                    EndTextureMode();
+                    draw(_dc_layers[d + sublayer], src11, target1);
+                    draw(_dc_layers[d + sublayer], src22, target2);
                 }
             
                 if (eff1) {
-                    BeginTextureMode(_ga_layers[d + sublayer]);
-                    mr::sdraw::draw_texture_darkest(texture, src11, target1);
-                    mr::sdraw::draw_texture_darkest(texture, src22, target2);
-                    EndTextureMode();
+                    _commands.draw_darkest(_ga_layers[d + sublayer], texture, src11, target1);
+                    _commands.draw_darkest(_ga_layers[d + sublayer], texture, src22, target2);
                 }
 
                 if (eff2) {
-                    BeginTextureMode(_gb_layers[d + sublayer]);
-                    mr::sdraw::draw_texture_darkest(texture, src11, target1);
-                    mr::sdraw::draw_texture_darkest(texture, src22, target2);
-                    EndTextureMode();
+                    _commands.draw_darkest(_gb_layers[d + sublayer], texture, src11, target1);
+                    _commands.draw_darkest(_gb_layers[d + sublayer], texture, src22, target2);
                 }
             }
         }
@@ -349,17 +291,19 @@ void Renderer::_draw_tile_origin_mtx(TileDef *def, matrix_t x, matrix_t y, uint8
 void Renderer::_draw_tiles_layer(uint8_t layer) noexcept {
     switch (layer) {
     case 0:
-        for (auto &c : _tiles_to_render1[_camera_index]) _draw_tile_origin_mtx(c.cell->tile_def, c.x, c.y, 0);
+        for (auto &c : _tiles_to_render1[_camera_index]) _draw_tile_origin_mtx(_tiles->tile(*c.cell), c.x, c.y, 0);
     break;
 
     case 1:
-        for (auto &c : _tiles_to_render2[_camera_index]) _draw_tile_origin_mtx(c.cell->tile_def, c.x, c.y, 1);
+        for (auto &c : _tiles_to_render2[_camera_index]) _draw_tile_origin_mtx(_tiles->tile(*c.cell), c.x, c.y, 1);
     break;
 
     case 2:
-        for (auto &c : _tiles_to_render3[_camera_index]) _draw_tile_origin_mtx(c.cell->tile_def, c.x, c.y, 2);
+        for (auto &c : _tiles_to_render3[_camera_index]) _draw_tile_origin_mtx(_tiles->tile(*c.cell), c.x, c.y, 2);
     break;
     }
+
+    _commands.flush();
 }
 
 };
\ No newline at end of file
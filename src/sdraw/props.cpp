@@ -356,7 +356,7 @@ void draw_decal_prop_preview(
 
     const auto texture = def->get_texture();
 
-    const auto shader = def->tags.find("customColor") == def->tags.end() 
+    const auto shader = !def->has_tag(tags::custom_color) 
         ? _shaders->default_prop() 
         : _shaders->white_remover_apply_color();
 
@@ -383,7 +383,7 @@ void draw_varied_decal_prop_preview(
 
     const auto texture = def->get_texture();
 
-    const auto shader = def->tags.find("customColor") == def->tags.end() 
+    const auto shader = !def->has_tag(tags::custom_color) 
         ? _shaders->default_prop() 
         : _shaders->white_remover_apply_color();
 
@@ -18,6 +18,8 @@ namespace mr::sdraw {
 
 void draw_tile_prevs_layer(
     const shaders* _shaders,
+    const TileDex *tiles,
+    const MaterialDex *materials,
     Matrix<GeoCell> const &geomtx,
     Matrix<TileCell> const &tilemtx,
     uint8_t layer,
@@ -41,7 +43,7 @@ void draw_tile_prevs_layer(
       switch (cell->type) {
         case TileType::head:
         {
-          auto *def = cell->tile_def;
+          auto *def = tiles->tile(*cell);
           if (def == nullptr) {
             break;
           }
@@ -79,7 +81,7 @@ void draw_tile_prevs_layer(
 
         case TileType::material:
         {
-          auto *def = cell->material_def;
+          auto *def = materials->material(*cell);
           if (def == nullptr) break;
 
           auto &geocell = geomtx.get_const(x, y, layer);
@@ -100,10 +102,10 @@ void draw_tile_prevs_layer(
       if (
         cell != nullptr && 
         cell->type == TileType::head && 
-        cell->tile_def != nullptr && 
-        !cell->tile_def->get_specs2().empty()
+        tiles->tile(*cell) != nullptr && 
+        !tiles->tile(*cell)->get_specs2().empty()
       ) {
-        auto *def = cell->tile_def;
+        auto *def = tiles->tile(*cell);
         auto &texture = def->get_loaded_texture();
         if (!def->is_texture_loaded()) continue;
 
@@ -124,10 +126,10 @@ void draw_tile_prevs_layer(
       if (
         cell != nullptr && 
         cell->type == TileType::head && 
-        cell->tile_def != nullptr && 
-        !cell->tile_def->get_specs3().empty()
+        tiles->tile(*cell) != nullptr && 
+        !tiles->tile(*cell)->get_specs3().empty()
       ) {
-        auto *def = cell->tile_def;
+        auto *def = tiles->tile(*cell);
         auto &texture = def->get_loaded_texture();
         if (!def->is_texture_loaded()) continue;
 
@@ -0,0 +1,814 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <raylib.h>
+
+#include <MobitParser/exceptions.h>
+#include <MobitParser/mapping.h>
+
+#include <MobitRenderer/definitions.h>
+#include <MobitRenderer/exceptions.h>
+#include <MobitRenderer/level.h>
+#include <MobitRenderer/matrix.h>
+#include <MobitRenderer/serialization.h>
+
+namespace mr::serde {
+
+// Cache files are only ever read by the build that wrote them, so the
+// records below are stored in native byte order and layout. Bump the
+// version whenever any of them changes.
+
+static constexpr char cache_magic[4] = { 'M', 'R', 'L', 'C' };
+static constexpr uint32_t cache_version = 4;
+
+// Written as a whole; catches caches from the other byte order.
+static constexpr uint32_t cache_byte_order = 0x01020304;
+
+struct cache_section {
+  uint64_t offset;
+  uint64_t count;
+};
+
+struct cache_header {
+  char magic[4];
+  uint32_t version;
+  uint32_t byte_order;
+  uint32_t reserved;
+
+  FileKey key;
+
+  uint16_t width, height;
+  uint16_t buffer_geos[4];
+
+  int32_t seed, water;
+  int32_t light_angle, light_flatness;
+
+  uint8_t light, terrain, front_water, pad;
+  uint32_t default_material;
+
+  // The MatrixLayout of both matrices, whose sections hold
+  // the backing storage as is, padding included.
+  uint32_t chunk_bits, chunk_rows;
+  uint64_t layer_size;
+
+  cache_section geometry;  // GeoCell, in storage order
+  cache_section tiles;     // cache_tilecell, in storage order
+  cache_section strings;   // cache_string
+  cache_section chars;     // char
+  cache_section cameras;   // cache_camera
+  cache_section props;     // cache_prop
+  cache_section segments;  // Vector2
+
+  cache_section effects;         // cache_effect
+  cache_section effect_configs;  // cache_effect_config
+  cache_section effect_options;  // uint32_t (string ids)
+  cache_section effect_chunks;   // cache_effect_chunk
+};
+
+struct cache_string {
+  uint32_t offset, length;
+};
+
+struct cache_tilecell {
+  uint32_t name;
+  uint16_t head_pos_x, head_pos_y, head_pos_z;
+  uint8_t type, pad;
+};
+
+struct cache_camera {
+  float x, y;
+  int32_t angles[4];  // top left, top right, bottom right, bottom left
+  float radii[4];
+};
+
+struct cache_prop {
+  int32_t depth;
+  uint32_t name;
+  float quad[8];  // top left, top right, bottom right, bottom left
+
+  int32_t render_order, seed, render_time, variation, custom_depth;
+  float thickness;
+  int8_t release;
+  uint8_t apply_color;
+  uint16_t pad;
+
+  uint32_t first_segment, segment_count;
+};
+
+struct cache_effect {
+  uint32_t name, type;
+  uint8_t cross_screen, pad[3];
+  int32_t repeats;
+  float affect_open_areas;
+
+  uint32_t first_config, config_count;
+  uint32_t first_chunk, chunk_count;
+};
+
+struct cache_effect_config {
+  uint32_t name;
+  uint32_t first_option, option_count;
+  uint8_t choice_type, pad[3];
+  int32_t choice;
+  uint32_t unlisted_choice;
+};
+
+// Only the allocated chunks of an effect matrix are stored.
+struct cache_effect_chunk {
+  uint32_t index;
+  uint8_t amounts[EffectMatrix::chunk_area];
+};
+
+static_assert(std::is_trivially_copyable<GeoCell>::value, "GeoCell is cached as raw bytes");
+static_assert(sizeof(Vector2) == 2 * sizeof(float), "Vector2 is cached as raw bytes");
+
+static constexpr uint64_t align_section(uint64_t offset) {
+  return (offset + 7) & ~uint64_t(7);
+}
+
+/// @brief A 64-bit hash of a file's bytes, a word at a time.
+static uint64_t hash_bytes(const char *data, size_t size) {
+  uint64_t hash = 0x9E3779B97F4A7C15ull ^ size;
+
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    uint64_t word;
+    std::memcpy(&word, data + i, 8);
+
+    hash = (hash ^ word) * 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 32;
+  }
+
+  uint64_t tail = 0;
+  std::memcpy(&tail, data + i, size - i);
+
+  hash = (hash ^ tail) * 0xC4CEB9FE1A85EC53ull;
+  hash ^= hash >> 29;
+
+  return hash;
+}
+
+std::filesystem::path level_cache_path(const std::filesystem::path &project) {
+  auto path = project;
+  path.replace_extension(".mrcache");
+  return path;
+}
+
+FileKey file_key(const std::filesystem::path &path) {
+  FileKey key{0, 0, 0};
+
+  key.size = static_cast<uint64_t>(std::filesystem::file_size(path));
+  key.mtime = static_cast<int64_t>(std::filesystem::last_write_time(path).time_since_epoch().count());
+
+  if (key.size > 0) {
+    mp::mapped_file file(path);
+    key.hash = hash_bytes(file.data(), file.size());
+  }
+
+  return key;
+}
+
+/// @brief Assigns every distinct string an index in the string table.
+class string_table {
+  std::unordered_map<std::string_view, uint32_t> _ids;
+
+public:
+  std::vector<cache_string> strings;
+  std::string chars;
+
+  uint32_t intern(std::string_view str) {
+    auto found = _ids.find(str);
+    if (found != _ids.end()) return found->second;
+
+    auto id = static_cast<uint32_t>(strings.size());
+
+    strings.push_back(cache_string{
+      static_cast<uint32_t>(chars.size()),
+      static_cast<uint32_t>(str.size())
+    });
+    chars.append(str);
+
+    _ids.emplace(str, id);
+    return id;
+  }
+};
+
+template <typename T>
+static void append_section(std::vector<char> &file, cache_section &section, const T *data, size_t count) {
+  file.resize(align_section(file.size()), 0);
+
+  section.offset = file.size();
+  section.count = count;
+
+  if (count == 0) return;
+
+  file.resize(file.size() + sizeof(T) * count);
+  std::memcpy(file.data() + section.offset, data, sizeof(T) * count);
+}
+
+void write_level_cache(const Level &level, const std::filesystem::path &project, const FileKey &key) {
+  const auto &geo_matrix = level.get_const_geo_matrix();
+  const auto &tile_matrix = level.get_const_tile_matrix();
+
+  cache_header header;
+  std::memset(&header, 0, sizeof(header));
+
+  std::memcpy(header.magic, cache_magic, sizeof(cache_magic));
+  header.version = cache_version;
+  header.byte_order = cache_byte_order;
+  header.key = key;
+
+  header.width = level.get_width();
+  header.height = level.get_height();
+  header.buffer_geos[0] = level.buffer_geos.left;
+  header.buffer_geos[1] = level.buffer_geos.top;
+  header.buffer_geos[2] = level.buffer_geos.right;
+  header.buffer_geos[3] = level.buffer_geos.bottom;
+
+  header.seed = level.seed;
+  header.water = level.water;
+  header.light_angle = level.light_angle;
+  header.light_flatness = level.light_flatness;
+  header.light = level.light;
+  header.terrain = level.terrain;
+  header.front_water = level.front_water;
+
+  header.chunk_bits = MatrixLayout::chunk_bits;
+  header.chunk_rows = geo_matrix.get_layout().rows;
+  header.layer_size = geo_matrix.get_layout().layer_size;
+
+  string_table strings;
+  header.default_material = strings.intern(level.default_material);
+
+  // The geometry is written straight from the matrix; tile cells only
+  // need their names swapped for string ids, looked up once per name.
+
+  std::vector<cache_tilecell> tiles(tile_matrix.storage_size());
+
+  constexpr uint32_t unassigned = ~uint32_t(0);
+  std::vector<uint32_t> name_ids;
+
+  const TileCell *cells = tile_matrix.data();
+
+  for (size_t c = 0; c < tiles.size(); c++) {
+    const auto &cell = cells[c];
+
+    if (cell.name >= name_ids.size()) name_ids.resize(static_cast<size_t>(cell.name) + 1, unassigned);
+
+    auto &name = name_ids[cell.name];
+    if (name == unassigned) name = strings.intern(cell.und_name());
+
+    tiles[c] = cache_tilecell{
+      name,
+      cell.head_pos_x, cell.head_pos_y, cell.head_pos_z,
+      static_cast<uint8_t>(cell.type), 0
+    };
+  }
+
+  std::vector<cache_camera> cameras;
+  cameras.reserve(level.cameras.size());
+
+  for (const auto &camera : level.cameras) {
+    cameras.push_back(cache_camera{
+      camera.get_position().x, camera.get_position().y,
+      {
+        camera.get_top_left_angle(), camera.get_top_right_angle(),
+        camera.get_bottom_right_angle(), camera.get_bottom_left_angle()
+      },
+      {
+        camera.get_top_left_radius(), camera.get_top_right_radius(),
+        camera.get_bottom_right_radius(), camera.get_bottom_left_radius()
+      }
+    });
+  }
+
+  std::vector<cache_prop> props;
+  std::vector<Vector2> segments;
+
+  props.reserve(level.props.size());
+
+  for (const auto &prop : level.props) {
+    const auto &settings = prop->settings;
+    const auto &quad = prop->quad;
+
+    cache_prop record;
+    std::memset(&record, 0, sizeof(record));
+
+    record.depth = prop->depth;
+    record.name = strings.intern(prop->und_name != nullptr ? std::string_view(*prop->und_name) : std::string_view());
+
+    const Vector2 vertices[4] = { quad.topleft, quad.topright, quad.bottomright, quad.bottomleft };
+    for (int v = 0; v < 4; v++) {
+      record.quad[v * 2] = vertices[v].x;
+      record.quad[v * 2 + 1] = vertices[v].y;
+    }
+
+    record.render_order = settings.render_order;
+    record.seed = settings.seed;
+    record.render_time = settings.render_time;
+    record.variation = settings.variation;
+    record.custom_depth = settings.custom_depth;
+    record.thickness = settings.thickness;
+    record.release = static_cast<int8_t>(settings.release);
+    record.apply_color = settings.apply_color;
+
+    record.first_segment = static_cast<uint32_t>(segments.size());
+    record.segment_count = static_cast<uint32_t>(settings.segments.size());
+    segments.insert(segments.end(), settings.segments.begin(), settings.segments.end());
+
+    props.push_back(record);
+  }
+
+  std::vector<cache_effect> effects;
+  std::vector<cache_effect_config> effect_configs;
+  std::vector<uint32_t> effect_options;
+  std::vector<cache_effect_chunk> effect_chunks;
+
+  effects.reserve(level.get_const_effects().size());
+
+  for (const auto &effect : level.get_const_effects()) {
+    cache_effect record;
+    std::memset(&record, 0, sizeof(record));
+
+    record.name = strings.intern(effect.name);
+    record.type = strings.intern(effect.type);
+    record.cross_screen = effect.cross_screen;
+    record.repeats = effect.repeats;
+    record.affect_open_areas = effect.affect_open_areas;
+
+    record.first_config = static_cast<uint32_t>(effect_configs.size());
+    record.config_count = static_cast<uint32_t>(effect.config.size());
+
+    for (const auto &config : effect.config) {
+      cache_effect_config config_record;
+      std::memset(&config_record, 0, sizeof(config_record));
+
+      config_record.name = strings.intern(config.name);
+      config_record.first_option = static_cast<uint32_t>(effect_options.size());
+      config_record.option_count = static_cast<uint32_t>(config.options.size());
+      config_record.choice_type = config.choice_type;
+      config_record.choice = config.choice;
+      config_record.unlisted_choice = strings.intern(config.unlisted_choice);
+
+      for (const auto &option : config.options)
+        effect_options.push_back(strings.intern(option));
+
+      effect_configs.push_back(config_record);
+    }
+
+    record.first_chunk = static_cast<uint32_t>(effect_chunks.size());
+
+    for (size_t c = 0; c < effect.matrix.chunk_count(); c++) {
+      const uint8_t *amounts = effect.matrix.get_chunk(c);
+      if (amounts == nullptr) continue;
+
+      cache_effect_chunk chunk;
+      chunk.index = static_cast<uint32_t>(c);
+      std::memcpy(chunk.amounts, amounts, sizeof(chunk.amounts));
+
+      effect_chunks.push_back(chunk);
+    }
+
+    record.chunk_count = static_cast<uint32_t>(effect_chunks.size()) - record.first_chunk;
+
+    effects.push_back(record);
+  }
+
+  std::vector<char> file(sizeof(cache_header));
+
+  append_section(file, header.geometry, geo_matrix.data(), geo_matrix.storage_size());
+  append_section(file, header.tiles,    tiles.data(), tiles.size());
+  append_section(file, header.strings,  strings.strings.data(), strings.strings.size());
+  append_section(file, header.chars,    strings.chars.data(), strings.chars.size());
+  append_section(file, header.cameras,  cameras.data(), cameras.size());
+  append_section(file, header.props,    props.data(), props.size());
+  append_section(file, header.segments, segments.data(), segments.size());
+
+  append_section(file, header.effects,        effects.data(), effects.size());
+  append_section(file, header.effect_configs, effect_configs.data(), effect_configs.size());
+  append_section(file, header.effect_options, effect_options.data(), effect_options.size());
+  append_section(file, header.effect_chunks,  effect_chunks.data(), effect_chunks.size());
+
+  std::memcpy(file.data(), &header, sizeof(header));
+
+  // Written aside and renamed, so that a reader never maps a partial cache.
+  const auto path = level_cache_path(project);
+  auto temporary = path;
+  temporary += ".tmp";
+
+  {
+    std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+    if (!out) throw serialization_failure("failed to open '"+temporary.string()+"' for writing");
+
+    out.write(file.data(), static_cast<std::streamsize>(file.size()));
+    out.close();
+
+    if (!out) {
+      std::error_code ec;
+      std::filesystem::remove(temporary, ec);
+      throw serialization_failure("failed to write '"+temporary.string()+"'");
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(temporary, path, ec);
+
+  if (ec) {
+    std::filesystem::remove(temporary, ec);
+    throw serialization_failure("failed to replace '"+path.string()+"'");
+  }
+}
+
+/// @brief Bounds-checked, alignment-safe access to the sections of a
+/// mapped cache file.
+class cache_reader {
+  const mp::mapped_file &_file;
+
+public:
+  template <typename T>
+  bool check(const cache_section &section) const {
+    if (section.offset > _file.size()) return false;
+    return section.count <= (_file.size() - section.offset) / sizeof(T);
+  }
+
+  template <typename T>
+  T at(const cache_section &section, size_t index) const {
+    T value;
+    std::memcpy(&value, _file.data() + section.offset + index * sizeof(T), sizeof(T));
+    return value;
+  }
+
+  explicit cache_reader(const mp::mapped_file &file) : _file(file) {}
+};
+
+std::unique_ptr<Level> read_level_cache(const std::filesystem::path &project, const FileKey &key) {
+  const auto path = level_cache_path(project);
+
+  std::error_code ec;
+  if (!std::filesystem::is_regular_file(path, ec)) return nullptr;
+
+  std::unique_ptr<mp::mapped_file> file;
+
+  try {
+    file = std::make_unique<mp::mapped_file>(path);
+  } catch (mp::mapping_failure &) {
+    return nullptr;
+  }
+
+  if (file->size() < sizeof(cache_header)) return nullptr;
+
+  cache_header header;
+  std::memcpy(&header, file->data(), sizeof(header));
+
+  if (std::memcmp(header.magic, cache_magic, sizeof(cache_magic)) != 0 ||
+      header.version != cache_version ||
+      header.byte_order != cache_byte_order) return nullptr;
+
+  if (header.key != key) return nullptr;
+
+  if (header.width == 0 || header.height == 0) return nullptr;
+
+  cache_reader reader(*file);
+
+  if (!reader.check<GeoCell>(header.geometry) ||
+      !reader.check<cache_tilecell>(header.tiles) ||
+      !reader.check<cache_string>(header.strings) ||
+      !reader.check<char>(header.chars) ||
+      !reader.check<cache_camera>(header.cameras) ||
+      !reader.check<cache_prop>(header.props) ||
+      !reader.check<Vector2>(header.segments) ||
+      !reader.check<cache_effect>(header.effects) ||
+      !reader.check<cache_effect_config>(header.effect_configs) ||
+      !reader.check<uint32_t>(header.effect_options) ||
+      !reader.check<cache_effect_chunk>(header.effect_chunks)) return nullptr;
+
+  // Strings
+
+  std::vector<std::string_view> strings;
+  strings.reserve(header.strings.count);
+
+  const char *chars = file->data() + header.chars.offset;
+
+  for (size_t s = 0; s < header.strings.count; s++) {
+    auto str = reader.at<cache_string>(header.strings, s);
+
+    if (str.offset > header.chars.count || str.length > header.chars.count - str.offset)
+      return nullptr;
+
+    strings.emplace_back(chars + str.offset, str.length);
+  }
+
+  if (header.default_material >= strings.size()) return nullptr;
+
+  auto level = std::make_unique<Level>(header.width, header.height);
+
+  level->set_path(project);
+
+  level->buffer_geos = BufferGeos(
+    header.buffer_geos[0],
+    header.buffer_geos[1],
+    header.buffer_geos[2],
+    header.buffer_geos[3]
+  );
+
+  level->seed = header.seed;
+  level->water = header.water;
+  level->light_angle = header.light_angle;
+  level->light_flatness = header.light_flatness;
+  level->light = header.light != 0;
+  level->terrain = header.terrain != 0;
+  level->front_water = header.front_water != 0;
+  level->default_material = std::string(strings[header.default_material]);
+
+  // Matrices
+
+  auto &geo_matrix = level->get_geo_matrix();
+  auto &tile_matrix = level->get_tile_matrix();
+
+  // The storage is copied as is, so it must have been written
+  // with the layout these matrices have.
+  const auto &layout = geo_matrix.get_layout();
+
+  if (header.chunk_bits != MatrixLayout::chunk_bits ||
+      header.chunk_rows != layout.rows ||
+      header.layer_size != layout.layer_size ||
+      header.geometry.count != geo_matrix.storage_size() ||
+      header.tiles.count != tile_matrix.storage_size()) return nullptr;
+
+  std::memcpy(geo_matrix.data(), file->data() + header.geometry.offset, sizeof(GeoCell) * header.geometry.count);
+
+  // Cell names are interned once per distinct string.
+  constexpr tile_name_t uninterned = ~tile_name_t(0);
+  std::vector<tile_name_t> tile_names(strings.size(), uninterned);
+
+  TileCell *cells = tile_matrix.data();
+
+  for (size_t c = 0; c < header.tiles.count; c++) {
+    auto record = reader.at<cache_tilecell>(header.tiles, c);
+    if (record.name >= strings.size() || record.type > static_cast<uint8_t>(TileType::material))
+      return nullptr;
+
+    auto &name = tile_names[record.name];
+    if (name == uninterned) name = intern_tile_name(strings[record.name]);
+
+    auto &cell = cells[c];
+
+    cell.type = static_cast<TileType>(record.type);
+    cell.name = name;
+    cell.head_pos_x = record.head_pos_x;
+    cell.head_pos_y = record.head_pos_y;
+    cell.head_pos_z = static_cast<uint8_t>(record.head_pos_z > UINT8_MAX ? UINT8_MAX : record.head_pos_z);
+  }
+
+  // Cameras
+
+  level->cameras.reserve(header.cameras.count);
+
+  for (size_t c = 0; c < header.cameras.count; c++) {
+    auto record = reader.at<cache_camera>(header.cameras, c);
+
+    LevelCamera camera;
+
+    camera.set_position(Vector2{record.x, record.y});
+
+    camera.set_top_left_angle(record.angles[0]);
+    camera.set_top_right_angle(record.angles[1]);
+    camera.set_bottom_right_angle(record.angles[2]);
+    camera.set_bottom_left_angle(record.angles[3]);
+
+    camera.set_top_left_radius(record.radii[0]);
+    camera.set_top_right_radius(record.radii[1]);
+    camera.set_bottom_right_radius(record.radii[2]);
+    camera.set_bottom_left_radius(record.radii[3]);
+
+    level->cameras.push_back(camera);
+  }
+
+  // Props
+
+  // Props of the same name share it, as in deser_props().
+  std::vector<std::shared_ptr<std::string>> names(strings.size());
+
+  level->props.reserve(header.props.count);
+
+  for (size_t p = 0; p < header.props.count; p++) {
+    auto record = reader.at<cache_prop>(header.props, p);
+
+    if (record.name >= strings.size() ||
+        record.first_segment > header.segments.count ||
+        record.segment_count > header.segments.count - record.first_segment ||
+        record.release < -1 || record.release > 1) return nullptr;
+
+    auto &name = names[record.name];
+    if (name == nullptr) name = std::make_shared<std::string>(strings[record.name]);
+
+    Quad quad(
+      Vector2{record.quad[0], record.quad[1]},
+      Vector2{record.quad[2], record.quad[3]},
+      Vector2{record.quad[4], record.quad[5]},
+      Vector2{record.quad[6], record.quad[7]}
+    );
+
+    auto prop = std::make_shared<Prop>(record.depth, name, quad);
+    auto &settings = prop->settings;
+
+    settings.render_order = record.render_order;
+    settings.seed = record.seed;
+    settings.render_time = record.render_time;
+    settings.variation = record.variation;
+    settings.custom_depth = record.custom_depth;
+    settings.thickness = record.thickness;
+    settings.release = static_cast<RopeRelease>(record.release);
+    settings.apply_color = record.apply_color != 0;
+
+    settings.segments.reserve(record.segment_count);
+    for (uint32_t s = 0; s < record.segment_count; s++)
+      settings.segments.push_back(reader.at<Vector2>(header.segments, record.first_segment + s));
+
+    level->props.push_back(std::move(prop));
+  }
+
+  // Effects
+
+  auto &effects = level->get_effects();
+  effects.reserve(header.effects.count);
+
+  for (size_t e = 0; e < header.effects.count; e++) {
+    auto record = reader.at<cache_effect>(header.effects, e);
+
+    if (record.name >= strings.size() || record.type >= strings.size() ||
+        record.first_config > header.effect_configs.count ||
+        record.config_count > header.effect_configs.count - record.first_config ||
+        record.first_chunk > header.effect_chunks.count ||
+        record.chunk_count > header.effect_chunks.count - record.first_chunk) return nullptr;
+
+    Effect effect(header.width, header.height);
+
+    effect.name = std::string(strings[record.name]);
+    effect.type = std::string(strings[record.type]);
+    effect.cross_screen = record.cross_screen != 0;
+    effect.repeats = record.repeats;
+    effect.affect_open_areas = record.affect_open_areas;
+
+    effect.config.reserve(record.config_count);
+
+    for (uint32_t c = 0; c < record.config_count; c++) {
+      auto config_record = reader.at<cache_effect_config>(header.effect_configs, record.first_config + c);
+
+      if (config_record.name >= strings.size() ||
+          config_record.unlisted_choice >= strings.size() ||
+          config_record.first_option > header.effect_options.count ||
+          config_record.option_count > header.effect_options.count - config_record.first_option)
+        return nullptr;
+
+      EffectConfig config;
+
+      config.name = std::string(strings[config_record.name]);
+      config.choice_type = config_record.choice_type;
+      config.choice = config_record.choice;
+      config.unlisted_choice = std::string(strings[config_record.unlisted_choice]);
+
+      config.options.reserve(config_record.option_count);
+
+      for (uint32_t o = 0; o < config_record.option_count; o++) {
+        auto option = reader.at<uint32_t>(header.effect_options, config_record.first_option + o);
+        if (option >= strings.size()) return nullptr;
+
+        config.options.emplace_back(strings[option]);
+      }
+
+      effect.config.push_back(std::move(config));
+    }
+
+    for (uint32_t c = 0; c < record.chunk_count; c++) {
+      auto chunk = reader.at<cache_effect_chunk>(header.effect_chunks, record.first_chunk + c);
+      if (chunk.index >= effect.matrix.chunk_count()) return nullptr;
+
+      for (auto amount : chunk.amounts) if (amount > EffectMatrix::max_amount) return nullptr;
+
+      std::memcpy(effect.matrix.get_or_allocate_chunk(chunk.index), chunk.amounts, sizeof(chunk.amounts));
+    }
+
+    effects.push_back(std::move(effect));
+  }
+
+  return level;
+}
+
+// Keyed images
+
+static constexpr char keyed_magic[4] = { 'M', 'R', 'K', 'I' };
+static constexpr uint32_t keyed_version = 1;
+
+struct keyed_header {
+  char magic[4];
+  uint32_t version;
+  uint32_t byte_order;
+  uint32_t variant;
+
+  FileKey key;
+
+  int32_t width, height;
+};
+
+std::filesystem::path keyed_image_cache_path(const std::filesystem::path &directory, const std::filesystem::path &image) {
+  const auto hash = std::hash<std::string>{}(std::filesystem::absolute(image).lexically_normal().string());
+
+  char name[32];
+  std::snprintf(name, sizeof(name), "%016llx.mrkeyed", static_cast<unsigned long long>(hash));
+
+  return directory / name;
+}
+
+Image read_keyed_image_cache(const std::filesystem::path &cache, const FileKey &key, uint32_t variant) {
+  const Image none = { nullptr, 0, 0, 0, 0 };
+
+  std::error_code ec;
+  if (!std::filesystem::is_regular_file(cache, ec)) return none;
+
+  std::unique_ptr<mp::mapped_file> file;
+
+  try {
+    file = std::make_unique<mp::mapped_file>(cache);
+  } catch (mp::mapping_failure &) {
+    return none;
+  }
+
+  if (file->size() < sizeof(keyed_header)) return none;
+
+  keyed_header header;
+  std::memcpy(&header, file->data(), sizeof(header));
+
+  if (std::memcmp(header.magic, keyed_magic, sizeof(keyed_magic)) != 0 ||
+      header.version != keyed_version ||
+      header.byte_order != cache_byte_order ||
+      header.variant != variant) return none;
+
+  if (header.key != key || header.width <= 0 || header.height <= 0) return none;
+
+  const size_t size = static_cast<size_t>(header.width) * header.height * 4;
+  if (file->size() - sizeof(keyed_header) != size) return none;
+
+  auto *pixels = MemAlloc(static_cast<unsigned int>(size));
+  if (pixels == nullptr) return none;
+
+  std::memcpy(pixels, file->data() + sizeof(keyed_header), size);
+
+  return Image{ pixels, header.width, header.height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+}
+
+void write_keyed_image_cache(const Image &image, const std::filesystem::path &cache, const FileKey &key, uint32_t variant) {
+  if (image.data == nullptr || image.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8)
+    throw serialization_failure("only keyed R8G8B8A8 images can be cached");
+
+  keyed_header header;
+  std::memset(&header, 0, sizeof(header));
+
+  std::memcpy(header.magic, keyed_magic, sizeof(keyed_magic));
+  header.version = keyed_version;
+  header.byte_order = cache_byte_order;
+  header.variant = variant;
+  header.key = key;
+  header.width = image.width;
+  header.height = image.height;
+
+  const size_t size = static_cast<size_t>(image.width) * image.height * 4;
+
+  // Written aside and renamed, as level caches are.
+  auto temporary = cache;
+  temporary += ".tmp";
+
+  {
+    std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+    if (!out) throw serialization_failure("failed to open '"+temporary.string()+"' for writing");
+
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(static_cast<const char *>(image.data), static_cast<std::streamsize>(size));
+    out.close();
+
+    if (!out) {
+      std::error_code ec;
+      std::filesystem::remove(temporary, ec);
+      throw serialization_failure("failed to write '"+temporary.string()+"'");
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(temporary, cache, ec);
+
+  if (ec) {
+    std::filesystem::remove(temporary, ec);
+    throw serialization_failure("failed to replace '"+cache.string()+"'");
+  }
+}
+
+}; // namespace mr::serde
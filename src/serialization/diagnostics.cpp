@@ -0,0 +1,46 @@
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <MobitRenderer/serialization.h>
+
+namespace mr::serde {
+
+std::ostream &operator<<(std::ostream &os, const Diagnostic &diagnostic) {
+  os << diagnostic.path;
+
+  if (diagnostic.x >= 0) {
+    os << " (" << diagnostic.x;
+    if (diagnostic.y >= 0) os << ", " << diagnostic.y;
+    if (diagnostic.z >= 0) os << ", " << diagnostic.z;
+    os << ')';
+  }
+
+  return os << ": " << diagnostic.message;
+}
+
+void Diagnostics::report(std::string path, int x, int y, int z, std::string message) {
+  _entries.push_back(Diagnostic{ std::move(path), x, y, z, std::move(message) });
+}
+
+void Diagnostics::report(std::string path, std::string message) {
+  report(std::move(path), -1, -1, -1, std::move(message));
+}
+
+void Diagnostics::append(Diagnostics &&other) {
+  if (_entries.empty()) {
+    _entries = std::move(other._entries);
+  } else {
+    _entries.insert(
+      _entries.end(),
+      std::make_move_iterator(other._entries.begin()),
+      std::make_move_iterator(other._entries.end())
+    );
+  }
+
+  other._entries.clear();
+}
+
+}; // namespace mr::serde
@@ -0,0 +1,239 @@
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <MobitParser/events.h>
+
+#include <MobitRenderer/exceptions.h>
+#include <MobitRenderer/level.h>
+#include <MobitRenderer/matrix.h>
+#include <MobitRenderer/serialization.h>
+
+namespace mr::serde {
+
+/// @brief Reads the #mtrx columns, storing only the non-zero amounts.
+static void deser_effect_matrix(mp::event_reader &reader, EffectMatrix &matrix) {
+  if (reader.next().type != mp::event_type::begin_list)
+    throw deserialization_failure("matrix is not a Linear List");
+
+  int x = 0;
+
+  for (; reader.peek().type != mp::event_type::end_list; x++) {
+    // Keep counting the columns for the error below.
+    if (x >= matrix.get_width()) {
+      reader.skip();
+      continue;
+    }
+
+    if (reader.next().type != mp::event_type::begin_list) {
+      std::stringstream sb;
+      sb << "matrix column " << x << " is not a Linear List";
+      throw deserialization_failure(sb.str());
+    }
+
+    int y = 0;
+
+    for (; reader.peek().type != mp::event_type::end_list; y++) {
+      const auto e = reader.next();
+
+      float amount;
+
+      if (e.type == mp::event_type::integer) amount = static_cast<float>(e.integer);
+      else if (e.type == mp::event_type::floating) amount = e.floating;
+      else {
+        std::stringstream sb;
+        sb << "amount at (" << x << ", " << y << ") is not an Int or a Float";
+        throw deserialization_failure(sb.str());
+      }
+
+      if (y >= matrix.get_height()) continue;
+
+      const uint8_t quantized = EffectMatrix::quantize(amount);
+      if (quantized != 0) matrix.set(x, y, quantized);
+    }
+
+    reader.next();
+
+    if (y != matrix.get_height()) {
+      std::stringstream sb;
+      sb << "incorrect matrix height at column " << x << " (expected "
+         << matrix.get_height() << " but got " << y << ")";
+      throw deserialization_failure(sb.str());
+    }
+  }
+
+  reader.next();
+
+  if (x != matrix.get_width()) {
+    std::stringstream sb;
+    sb << "incorrect matrix width (expected " << matrix.get_width()
+       << " but got " << x << ")";
+    throw deserialization_failure(sb.str());
+  }
+}
+
+/// @brief Reads #Options: a list of [name, [options...], choice] entries.
+static void deser_effect_options(mp::event_reader &reader, std::vector<EffectConfig> &configs) {
+  if (reader.next().type != mp::event_type::begin_list)
+    throw deserialization_failure("options is not a Linear List");
+
+  for (size_t o = 0; reader.peek().type != mp::event_type::end_list; o++) {
+    auto insufficient = [o]() {
+      return deserialization_failure(
+        "option " + std::to_string(o + 1) +
+        " has insufficient elements (expected 3)");
+    };
+
+    if (reader.next().type != mp::event_type::begin_list)
+      throw deserialization_failure(
+        "option " + std::to_string(o + 1) + " is not a Linear List");
+
+    EffectConfig config;
+    config.choice_type = 0;
+    config.choice = 0;
+
+    if (reader.peek().type == mp::event_type::end_list) throw insufficient();
+    config.name = deser_string(reader);
+
+    if (reader.peek().type == mp::event_type::end_list) throw insufficient();
+    if (reader.next().type != mp::event_type::begin_list)
+      throw deserialization_failure(
+        "choices of option \"" + config.name + "\" are not a Linear List");
+
+    while (reader.peek().type != mp::event_type::end_list)
+      config.options.push_back(deser_string(reader));
+
+    reader.next();
+
+    if (reader.peek().type == mp::event_type::end_list) throw insufficient();
+    const auto choice = reader.next();
+
+    switch (choice.type) {
+    case mp::event_type::string: {
+      // Unknown choices are kept out of range rather than rejected.
+      const auto found = std::find(config.options.begin(), config.options.end(), choice.value);
+      config.choice_type = 0;
+      config.choice = static_cast<int>(std::distance(config.options.begin(), found));
+
+      if (found == config.options.end()) config.unlisted_choice = std::string(choice.value);
+    }
+    break;
+
+    case mp::event_type::integer:
+      config.choice_type = 1;
+      config.choice = choice.integer;
+      break;
+
+    case mp::event_type::floating:
+      config.choice_type = 1;
+      config.choice = static_cast<int>(choice.floating);
+      break;
+
+    default:
+      throw deserialization_failure(
+        "choice of option \"" + config.name + "\" is not a String or a number");
+    }
+
+    while (reader.peek().type != mp::event_type::end_list) reader.skip();
+    reader.next();
+
+    configs.push_back(std::move(config));
+  }
+
+  reader.next();
+}
+
+static Effect deser_effect(mp::event_reader &reader, matrix_t width, matrix_t height) {
+  if (reader.next().type != mp::event_type::begin_list)
+    throw deserialization_failure("effect is not a Property List");
+
+  Effect effect(width, height);
+
+  bool has_name = false, has_matrix = false;
+
+  while (reader.peek().type == mp::event_type::property) {
+    const auto key = reader.next();
+
+    try {
+      if (key.is("nm")) {
+        effect.name = deser_string(reader);
+        has_name = true;
+      }
+      else if (key.is("tp")) effect.type = deser_string(reader);
+      else if (key.is("crossscreen")) effect.cross_screen = deser_int(reader) != 0;
+      else if (key.is("repeats")) effect.repeats = deser_int(reader);
+      else if (key.is("affectopenareas")) {
+        const auto e = reader.next();
+
+        if (e.type == mp::event_type::floating) effect.affect_open_areas = e.floating;
+        else if (e.type == mp::event_type::integer) effect.affect_open_areas = static_cast<float>(e.integer);
+        else throw deserialization_failure("node is not an Int or a Float");
+      }
+      else if (key.is("mtrx")) {
+        deser_effect_matrix(reader, effect.matrix);
+        has_matrix = true;
+      }
+      else if (key.is("options")) deser_effect_options(reader, effect.config);
+      else reader.skip();
+    } catch (deserialization_failure &e) {
+      std::string msg("failed to deserialize property #");
+      msg.append(key.value);
+      msg += ": ";
+      msg += e.what();
+      throw deserialization_failure(msg);
+    }
+  }
+
+  if (reader.next().type != mp::event_type::end_list)
+    throw deserialization_failure("effect is not a Property List");
+
+  if (!has_name) throw deserialization_failure("missing required property #nm");
+  if (!has_matrix) throw deserialization_failure("missing required property #mtrx");
+
+  return effect;
+}
+
+void deser_effects(mp::event_reader &reader, std::vector<Effect> &effects, matrix_t width, matrix_t height, Diagnostics *diagnostics) {
+  if (reader.next().type != mp::event_type::begin_list)
+    throw deserialization_failure("effects line is not a Property List");
+
+  if (!reader.seek_property("effects"))
+    throw deserialization_failure("required property #effects not found");
+
+  if (reader.next().type != mp::event_type::begin_list)
+    throw deserialization_failure("#effects is not a Linear List");
+
+  std::vector<Effect> new_effects;
+
+  for (int e = 0; reader.peek().type != mp::event_type::end_list; e++) {
+    // Where to resume from, should the effect be malformed.
+    std::optional<mp::event_reader> effect_start;
+    if (diagnostics != nullptr) effect_start = reader;
+
+    try {
+      new_effects.push_back(deser_effect(reader, width, height));
+    } catch (deserialization_failure &de) {
+      if (diagnostics == nullptr) {
+        std::stringstream sb;
+        sb << "failed to deserialize effect " << e << ": " << de.what();
+        throw deserialization_failure(sb.str());
+      }
+
+      diagnostics->report("effects", e, -1, -1, de.what());
+
+      reader = *effect_start;
+      reader.skip();
+    }
+  }
+
+  // The rest of the line only holds editor state.
+
+  effects = std::move(new_effects);
+}
+
+}; // namespace mr::serde
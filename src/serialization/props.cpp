@@ -22,17 +22,17 @@ mr::Rope            *deser_rope_prop            (const mp::Props*);
 namespace mr::serde {
 
 PropDefCategory deser_propdef_category(const mp::Node *node) {
-    const mp::List *list = dynamic_cast<const mp::List*>(node);
+    const mp::List *list = mp::node_cast<mp::List>(node);
   
     if (list == nullptr) 
         throw deserialization_failure("category is not a linear list");
 
-    mp::Node *name_node = list->elements[0].get();
-    mp::String *name_string_node = dynamic_cast<mp::String*>(name_node);
+    mp::Node *name_node = list->elements[0];
+    mp::String *name_string_node = mp::node_cast<mp::String>(name_node);
     if (name_string_node == nullptr)
         throw deserialization_failure("category name is not a string");
 
-    mp::Node *color_node = list->elements[1].get();
+    mp::Node *color_node = list->elements[1];
     Color color;
 
     try {
@@ -44,21 +44,21 @@ PropDefCategory deser_propdef_category(const mp::Node *node) {
         throw deserialization_failure(msg);
     }
 
-    return PropDefCategory{name_string_node->str, color};
+    return PropDefCategory{std::string(name_string_node->str), color};
 }
 
 PropDef *deser_propdef(const mp::Node *node) {
-    const mp::Props *props = dynamic_cast<const mp::Props*>(node);
+    const mp::Props *props = mp::node_cast<mp::Props>(node);
     if (props == nullptr) throw deserialization_failure("node is not a Property List");
 
-    const auto type_iter = props->map.find("tp");
+    const auto type_iter = props->map.find(mp::keys::tp);
     if (type_iter == props->map.end()) 
         throw deserialization_failure("missing required property #tp");
 
     std::string type_str;
 
     try {
-        type_str = deser_string(type_iter->second.get());
+        type_str = deser_string(type_iter->second);
     } catch (deserialization_failure &de) {
         throw deserialization_failure(std::string("failed to deserialize #tp property: ")+de.what());
     }
@@ -98,315 +98,338 @@ PropDef *deser_propdef(const mp::Node *node) {
     return def;
 }
 
-void deser_props(const mp::Node *node, std::vector<std::shared_ptr<Prop>> &props) {
-    const mp::List *list = dynamic_cast<const mp::List*>(node);
+/// @brief Deserializes the prop at the given (one-based) position.
+/// @param names Shares the name strings between props of the same definition.
+static std::shared_ptr<Prop> deser_prop(
+    const mp::Node *prop_node_ptr,
+    size_t counter,
+    std::unordered_map<std::string, std::shared_ptr<std::string>> &names
+) {
+    const mp::List *prop_node = mp::node_cast<mp::List>(prop_node_ptr);
 
-    if (list == nullptr) throw deserialization_failure("node is not a Linear List");
-
-    std::vector<std::shared_ptr<Prop>> new_props;
-    std::unordered_map<std::string, std::shared_ptr<std::string>> names;
+    if (prop_node == nullptr) throw deserialization_failure(
+        std::string("failed to deserialize prop #")
+        +std::to_string(counter)
+        +": prop is not a Linear List"
+    );
 
-    size_t counter = 0;
-    for (const auto &prop_node_ptr : list->elements) {
-        counter++;
+    if (prop_node->elements.size() < 4) throw deserialization_failure(
+        std::string("failed to parse prop #")
+        +std::to_string(counter)
+        +": insufficient elements (expected at least 4)"
+    );
 
-        const mp::List *prop_node = dynamic_cast<const mp::List*>(prop_node_ptr.get());
+    int depth = 0;
+    std::shared_ptr<std::string> und_name;
+    Quad quad;
+    PropSettings settings;
 
-        if (prop_node == nullptr) throw deserialization_failure(
+    try {
+        depth = deser_int(prop_node->elements[0]);
+    } catch (deserialization_failure &de) {
+        throw deserialization_failure(
             std::string("failed to deserialize prop #")
             +std::to_string(counter)
-            +": prop is not a Linear List"
+            +": "
+            +de.what()
         );
+    }
 
-        if (prop_node->elements.size() < 4) throw deserialization_failure(
-            std::string("failed to parse prop #")
-            +std::to_string(counter)
-            +": insufficient elements (expected at least 4)"
-        );
+    try {
+        auto name = deser_string(prop_node->elements[1]);
 
-        int depth = 0;
-        std::shared_ptr<std::string> und_name;
-        Quad quad;
-        PropSettings settings;
+        auto found_name = names.find(name);
 
-        try {
-            depth = deser_int(prop_node->elements[0].get());
-        } catch (deserialization_failure &de) {
-            throw deserialization_failure(
-                std::string("failed to deserialize prop #")
-                +std::to_string(counter)
-                +": "
-                +de.what()
-            );
+        if (found_name == names.end()) {
+            und_name = std::make_shared<std::string>(name);
+            names[name] = und_name;
+        } else {
+            und_name = found_name->second;
         }
+    } catch (deserialization_failure &de) {
+        throw deserialization_failure(
+            std::string("failed to deserialize prop #")
+            +std::to_string(counter)
+            +": "
+            +de.what()
+        );
+    }
 
-        try {
-            auto name = deser_string(prop_node->elements[1].get());
-
-            auto found_name = names.find(name);
+    // Quad
 
-            if (found_name == names.end()) {
-                und_name = std::make_shared<std::string>(name);
-                names[name] = und_name;
-            } else {
-                und_name = found_name->second;
-            }
-        } catch (deserialization_failure &de) {
-            throw deserialization_failure(
-                std::string("failed to deserialize prop #")
-                +std::to_string(counter)
-                +": "
-                +de.what()
-            );
-        }
+    const mp::List *quad_node = mp::node_cast<mp::List>(prop_node->elements[3]);
+    if (quad_node == nullptr) throw deserialization_failure(
+        std::string("failed to deserialize prop #")
+        +std::to_string(counter)
+        +": element #4 (quad vertices) is not a Linear List"
+    );
 
-        // Quad
+    if (quad_node->elements.size() < 4) throw deserialization_failure(
+        std::string("failed to deserialize prop #")
+        +std::to_string(counter)
+        +": element #4 (quad vertices) elements are insufficient (expected at least 4)"
+    );
 
-        const mp::List *quad_node = dynamic_cast<const mp::List*>(prop_node->elements[3].get());
-        if (quad_node == nullptr) throw deserialization_failure(
+    try {
+        deser_point(quad_node->elements[0], quad.topleft);
+    } catch (deserialization_failure &de) {
+        throw deserialization_failure(
             std::string("failed to deserialize prop #")
             +std::to_string(counter)
-            +": element #4 (quad vertices) is not a Linear List"
+            +"'s top left quad vertex: "
+            +de.what()
         );
+    }
 
-        if (quad_node->elements.size() < 4) throw deserialization_failure(
+    try {
+        deser_point(quad_node->elements[1], quad.topright);
+    } catch (deserialization_failure &de) {
+        throw deserialization_failure(
             std::string("failed to deserialize prop #")
             +std::to_string(counter)
-            +": element #4 (quad vertices) elements are insufficient (expected at least 4)"
+            +"'s top right quad vertex: "
+            +de.what()
         );
+    }
 
-        try {
-            deser_point(quad_node->elements[0].get(), quad.topleft);
-        } catch (deserialization_failure &de) {
-            throw deserialization_failure(
-                std::string("failed to deserialize prop #")
-                +std::to_string(counter)
-                +"'s top left quad vertex: "
-                +de.what()
-            );
-        }
+    try {
+        deser_point(quad_node->elements[2], quad.bottomright);
+    } catch (deserialization_failure &de) {
+        throw deserialization_failure(
+            std::string("failed to deserialize prop #")
+            +std::to_string(counter)
+            +"'s bottom right quad vertex: "
+            +de.what()
+        );
+    }
 
-        try {
-            deser_point(quad_node->elements[1].get(), quad.topright);
-        } catch (deserialization_failure &de) {
-            throw deserialization_failure(
-                std::string("failed to deserialize prop #")
-                +std::to_string(counter)
-                +"'s top right quad vertex: "
-                +de.what()
-            );
-        }
+    try {
+        deser_point(quad_node->elements[3], quad.bottomleft);
+    } catch (deserialization_failure &de) {
+        throw deserialization_failure(
+            std::string("failed to deserialize prop #")
+            +std::to_string(counter)
+            +"'s bottom left quad vertex: "
+            +de.what()
+        );
+    }
 
-        try {
-            deser_point(quad_node->elements[2].get(), quad.bottomright);
-        } catch (deserialization_failure &de) {
-            throw deserialization_failure(
-                std::string("failed to deserialize prop #")
-                +std::to_string(counter)
-                +"'s bottom right quad vertex: "
-                +de.what()
-            );
-        }
+    quad *= 1.25f;
 
-        try {
-            deser_point(quad_node->elements[3].get(), quad.bottomleft);
-        } catch (deserialization_failure &de) {
-            throw deserialization_failure(
-                std::string("failed to deserialize prop #")
-                +std::to_string(counter)
-                +"'s bottom left quad vertex: "
-                +de.what()
-            );
-        }
+    // Settings & Segments
 
-        quad *= 1.25f;
+    if (prop_node->elements.size() > 4) {
+        const mp::Props *extra_node = mp::node_cast<mp::Props>(prop_node->elements[4]);
 
-        // Settings & Segments
+        if (extra_node == nullptr) throw deserialization_failure(
+            std::string("failed to deserialize prop #")
+            +std::to_string(counter)
+            +": element #5 is not a Property List"
+        );
 
-        if (prop_node->elements.size() > 4) {
-            const mp::Props *extra_node = dynamic_cast<const mp::Props*>(prop_node->elements[4].get());
+        auto settings_iter = extra_node->map.find(mp::keys::settings);
+        // Rope segments are saved under #points; #point is still accepted.
+        auto segments_iter = extra_node->map.find("points");
+        if (segments_iter == extra_node->map.end()) segments_iter = extra_node->map.find(mp::keys::point);
 
-            if (extra_node == nullptr) throw deserialization_failure(
+        if (settings_iter != extra_node->map.end()) {
+            const mp::Props *settings_node = mp::node_cast<mp::Props>(settings_iter->second);
+            if (settings_node == nullptr) throw deserialization_failure(
                 std::string("failed to deserialize prop #")
                 +std::to_string(counter)
-                +": element #5 is not a Property List"
+                +" #settings: node is not a Property List"
             );
 
-            auto settings_iter = extra_node->map.find("settings");
-            auto segments_iter = extra_node->map.find("point");
-
-            if (settings_iter != extra_node->map.end()) {
-                const mp::Props *settings_node = dynamic_cast<const mp::Props*>(settings_iter->second.get());
-                if (settings_node == nullptr) throw deserialization_failure(
-                    std::string("failed to deserialize prop #")
-                    +std::to_string(counter)
-                    +" #settings: node is not a Property List"
-                );
-
-                const auto &map = settings_node->map;
-                const auto notfound = settings_node->map.end();
-
-                auto render_order = map.find("renderorder");
-                auto seed = map.find("seed");
-                auto render_time = map.find("rendertime");
-                auto variation = map.find("var");
-                auto custom_depth = map.find("customdepth");
-                auto thickness = map.find("thickness");
-                auto apply_color = map.find("applycolor");
-                auto release = map.find("release");
-
-                if (render_order != notfound) {
-                    try {
-                        settings.render_order = deser_int(render_order->second.get());
-                    } catch (deserialization_failure &de) {
-                        throw deserialization_failure(
-                            std::string("failed to deserialize prop #")
-                            +std::to_string(counter)
-                            +"'s settings property #renderOrder: "
-                            +de.what()
-                        );
-                    }
+            const auto &map = settings_node->map;
+            const auto notfound = settings_node->map.end();
+
+            auto render_order = map.find(mp::keys::renderorder);
+            auto seed = map.find(mp::keys::seed);
+            auto render_time = map.find(mp::keys::rendertime);
+            auto variation = map.find(mp::keys::var);
+            auto custom_depth = map.find(mp::keys::customdepth);
+            auto thickness = map.find(mp::keys::thickness);
+            auto apply_color = map.find(mp::keys::applycolor);
+            auto release = map.find(mp::keys::release);
+
+            if (render_order != notfound) {
+                try {
+                    settings.render_order = deser_int(render_order->second);
+                } catch (deserialization_failure &de) {
+                    throw deserialization_failure(
+                        std::string("failed to deserialize prop #")
+                        +std::to_string(counter)
+                        +"'s settings property #renderOrder: "
+                        +de.what()
+                    );
                 }
+            }
 
-                if (seed != notfound) {
-                    try {
-                        settings.seed = deser_int(seed->second.get());
-                    } catch (deserialization_failure &de) {
-                        throw deserialization_failure(
-                            std::string("failed to deserialize prop #")
-                            +std::to_string(counter)
-                            +"'s settings property #seed: "
-                            +de.what()
-                        );
-                    }
+            if (seed != notfound) {
+                try {
+                    settings.seed = deser_int(seed->second);
+                } catch (deserialization_failure &de) {
+                    throw deserialization_failure(
+                        std::string("failed to deserialize prop #")
+                        +std::to_string(counter)
+                        +"'s settings property #seed: "
+                        +de.what()
+                    );
                 }
+            }
 
-                if (render_time != notfound) {
-                    try {
-                        settings.render_time = deser_int(render_time->second.get());
-                    } catch (deserialization_failure &de) {
-                        throw deserialization_failure(
-                            std::string("failed to deserialize prop #")
-                            +std::to_string(counter)
-                            +"'s settings property #renderTime: "
-                            +de.what()
-                        );
-                    }
+            if (render_time != notfound) {
+                try {
+                    settings.render_time = deser_int(render_time->second);
+                } catch (deserialization_failure &de) {
+                    throw deserialization_failure(
+                        std::string("failed to deserialize prop #")
+                        +std::to_string(counter)
+                        +"'s settings property #renderTime: "
+                        +de.what()
+                    );
                 }
+            }
 
-                if (variation != notfound) {
-                    try {
-                        settings.variation = deser_int(variation->second.get());
-                        if (--settings.variation < 0) settings.variation = 0;
-                    } catch (deserialization_failure &de) {
-                        throw deserialization_failure(
-                            std::string("failed to deserialize prop #")
-                            +std::to_string(counter)
-                            +"'s settings property #var: "
-                            +de.what()
-                        );
-                    }
+            if (variation != notfound) {
+                try {
+                    settings.variation = deser_int(variation->second);
+                    if (--settings.variation < 0) settings.variation = 0;
+                } catch (deserialization_failure &de) {
+                    throw deserialization_failure(
+                        std::string("failed to deserialize prop #")
+                        +std::to_string(counter)
+                        +"'s settings property #var: "
+                        +de.what()
+                    );
                 }
+            }
 
-                if (custom_depth != notfound) {
-                    try {
-                        settings.custom_depth = deser_int(custom_depth->second.get());
-                    } catch (deserialization_failure &de) {
-                        throw deserialization_failure(
-                            std::string("failed to deserialize prop #")
-                            +std::to_string(counter)
-                            +"'s settings property #customDepth: "
-                            +de.what()
-                        );
-                    }
-                } else {
-                    settings.custom_depth = depth;
+            if (custom_depth != notfound) {
+                try {
+                    settings.custom_depth = deser_int(custom_depth->second);
+                } catch (deserialization_failure &de) {
+                    throw deserialization_failure(
+                        std::string("failed to deserialize prop #")
+                        +std::to_string(counter)
+                        +"'s settings property #customDepth: "
+                        +de.what()
+                    );
                 }
+            } else {
+                settings.custom_depth = depth;
+            }
 
-                if (thickness != notfound) {
-                    try {
-                        settings.thickness = deser_float(thickness->second.get());
-                    } catch (deserialization_failure &de) {
-                        throw deserialization_failure(
-                            std::string("failed to deserialize prop #")
-                            +std::to_string(counter)
-                            +"'s settings property #thickness: "
-                            +de.what()
-                        );
-                    }
+            if (thickness != notfound) {
+                try {
+                    settings.thickness = deser_float(thickness->second);
+                } catch (deserialization_failure &de) {
+                    throw deserialization_failure(
+                        std::string("failed to deserialize prop #")
+                        +std::to_string(counter)
+                        +"'s settings property #thickness: "
+                        +de.what()
+                    );
                 }
+            }
 
-                if (apply_color != notfound) {
-                    try {
-                        settings.apply_color = deser_bool(apply_color->second.get());
-                    } catch (deserialization_failure &de) {
-                        throw deserialization_failure(
-                            std::string("failed to deserialize prop #")
-                            +std::to_string(counter)
-                            +"'s settings property #applyColor: "
-                            +de.what()
-                        );
-                    }
+            if (apply_color != notfound) {
+                try {
+                    settings.apply_color = deser_bool(apply_color->second);
+                } catch (deserialization_failure &de) {
+                    throw deserialization_failure(
+                        std::string("failed to deserialize prop #")
+                        +std::to_string(counter)
+                        +"'s settings property #applyColor: "
+                        +de.what()
+                    );
                 }
+            }
 
-                if (release != notfound) {
-                    try {
-                        int r = deser_int(release->second.get());
-                    
-                        if      (r == -1) settings.release = RopeRelease::left;
-                        else if (r ==  0) settings.release = RopeRelease::none;
-                        else if (r ==  1) settings.release = RopeRelease::right;
-                        else throw deserialization_failure(
-                            std::string("failed to deserialize prop #")
-                            +std::to_string(counter)
-                            +"'s settings property #release: invalid value (accepted values are -1, 0, 1)"
-                        );
-
-                    } catch (deserialization_failure &de) {
-                        throw deserialization_failure(
-                            std::string("failed to deserialize prop #")
-                            +std::to_string(counter)
-                            +"'s settings property #release: "
-                            +de.what()
-                        );
-                    }
+            if (release != notfound) {
+                try {
+                    int r = deser_int(release->second);
+                
+                    if      (r == -1) settings.release = RopeRelease::left;
+                    else if (r ==  0) settings.release = RopeRelease::none;
+                    else if (r ==  1) settings.release = RopeRelease::right;
+                    else throw deserialization_failure(
+                        std::string("failed to deserialize prop #")
+                        +std::to_string(counter)
+                        +"'s settings property #release: invalid value (accepted values are -1, 0, 1)"
+                    );
+
+                } catch (deserialization_failure &de) {
+                    throw deserialization_failure(
+                        std::string("failed to deserialize prop #")
+                        +std::to_string(counter)
+                        +"'s settings property #release: "
+                        +de.what()
+                    );
                 }
             }
-            if (segments_iter != extra_node->map.end()) {
-                const mp::List *list = dynamic_cast<const mp::List*>(segments_iter->second.get());
-                if (list == nullptr) throw deserialization_failure(
-                    std::string("failed to deserialize prop #")
-                    +std::to_string(counter)
-                    +" #point: node is not a Linear List"
-                );
-
-                settings.segments.reserve(list->elements.size());
-
-                size_t counter = 0;
-                for (const auto &point_node : list->elements) {
-                    counter++;
-
-                    try {
-                        Vector2 point;
-                        deser_point(point_node.get(), point);
-                        settings.segments.push_back(point);
-                    } catch (deserialization_failure &de) {
-                        throw deserialization_failure(
-                            std::string("failed to deserialize prop #")
-                            +std::to_string(counter)
-                            +"'s rope segments #"
-                            +std::to_string(counter)
-                            +": "
-                            +de.what()
-                        );
-                    }
+        }
+        if (segments_iter != extra_node->map.end()) {
+            const mp::List *list = mp::node_cast<mp::List>(segments_iter->second);
+            if (list == nullptr) throw deserialization_failure(
+                std::string("failed to deserialize prop #")
+                +std::to_string(counter)
+                +" #point: node is not a Linear List"
+            );
+
+            settings.segments.reserve(list->elements.size());
+
+            size_t counter = 0;
+            for (const auto &point_node : list->elements) {
+                counter++;
+
+                try {
+                    Vector2 point;
+                    deser_point(point_node, point);
+                    settings.segments.push_back(point);
+                } catch (deserialization_failure &de) {
+                    throw deserialization_failure(
+                        std::string("failed to deserialize prop #")
+                        +std::to_string(counter)
+                        +"'s rope segments #"
+                        +std::to_string(counter)
+                        +": "
+                        +de.what()
+                    );
                 }
             }
         }
-    
-        Prop new_prop = Prop(depth, std::move(und_name), quad);
-        new_prop.settings = std::move(settings);
-        new_props.push_back(std::make_shared<Prop>(std::move(new_prop)));
+    }
+
+    Prop new_prop = Prop(depth, std::move(und_name), quad);
+    new_prop.settings = std::move(settings);
+
+    return std::make_shared<Prop>(std::move(new_prop));
+}
+
+void deser_props(const mp::Node *node, std::vector<std::shared_ptr<Prop>> &props, Diagnostics *diagnostics) {
+    const mp::List *list = mp::node_cast<mp::List>(node);
+
+    if (list == nullptr) throw deserialization_failure("node is not a Linear List");
+
+    std::vector<std::shared_ptr<Prop>> new_props;
+    std::unordered_map<std::string, std::shared_ptr<std::string>> names;
+
+    new_props.reserve(list->elements.size());
+
+    size_t counter = 0;
+    for (const auto &prop_node_ptr : list->elements) {
+        counter++;
+
+        // A malformed prop is rare enough that leniency can afford
+        // to unwind; it's dropped and the rest are kept.
+        try {
+            new_props.push_back(deser_prop(prop_node_ptr, counter, names));
+        } catch (deserialization_failure &de) {
+            if (diagnostics == nullptr) throw;
+
+            diagnostics->report("props", static_cast<int>(counter - 1), -1, -1, de.what());
+        }
     }
 
     props = std::move(new_props);
@@ -439,11 +462,11 @@ void define_prop_list(
 };
 
 inline void deser_nm_or_throw(const mp::Props *props, std::string &name) {
-    const auto nm_iter = props->map.find("nm");
+    const auto nm_iter = props->map.find(mp::keys::nm);
     if (nm_iter == props->map.end()) throw mr::deserialization_failure("missing required property #nm");
 
     try {
-        name = mr::serde::deser_string(nm_iter->second.get());
+        name = mr::serde::deser_string(nm_iter->second);
     } catch (mr::deserialization_failure &de) {
         throw mr::deserialization_failure(
             std::string("failed to deserialize property #nm: ")+de.what()
@@ -611,19 +634,19 @@ mr::Standard        *deser_standard_prop        (const mp::Props *node) {
     deser_nm_or_throw(node, name);
     
     // Optional
-    const auto depth_iter           = map.find("depth");
-    const auto tags_iter            = map.find("tags"); 
-    const auto repeat_iter          = map.find("repeatl");
-    const auto size_iter            = map.find("sz");
-    const auto color_treatment_iter = map.find("colortreatment");
-    const auto bevel_iter           = map.find("bevel");
-
-    if (depth_iter != notfound)           deser_depth_or_throw(depth_iter->second.get(), depth);
-    if (tags_iter != notfound)            deser_tags_or_throw(tags_iter->second.get(), tags);
-    if (repeat_iter != notfound)          deser_repeat_or_throw(repeat_iter->second.get(), repeat);
-    if (size_iter != notfound)            deser_size_or_throw(size_iter->second.get(), width, height);
-    if (color_treatment_iter != notfound) deser_color_treatment_or_throw(color_treatment_iter->second.get(), color_treatment);
-    if (bevel_iter != notfound)           deser_bevel_or_throw(bevel_iter->second.get(), bevel);
+    const auto depth_iter           = map.find(mp::keys::depth);
+    const auto tags_iter            = map.find(mp::keys::tags); 
+    const auto repeat_iter          = map.find(mp::keys::repeatl);
+    const auto size_iter            = map.find(mp::keys::sz);
+    const auto color_treatment_iter = map.find(mp::keys::colortreatment);
+    const auto bevel_iter           = map.find(mp::keys::bevel);
+
+    if (depth_iter != notfound)           deser_depth_or_throw(depth_iter->second, depth);
+    if (tags_iter != notfound)            deser_tags_or_throw(tags_iter->second, tags);
+    if (repeat_iter != notfound)          deser_repeat_or_throw(repeat_iter->second, repeat);
+    if (size_iter != notfound)            deser_size_or_throw(size_iter->second, width, height);
+    if (color_treatment_iter != notfound) deser_color_treatment_or_throw(color_treatment_iter->second, color_treatment);
+    if (bevel_iter != notfound)           deser_bevel_or_throw(bevel_iter->second, bevel);
     
     return new mr::Standard(
         depth, 
@@ -654,25 +677,25 @@ mr::VariedStandard  *deser_varied_standard_prop (const mp::Props *node) {
     deser_nm_or_throw(node, name);
     
     // Optional
-    const auto depth_iter           = map.find("depth");
-    const auto tags_iter            = map.find("tags"); 
-    const auto repeat_iter          = map.find("repeatl");
-    const auto size_iter            = map.find("sz");
-    const auto color_treatment_iter = map.find("colortreatment");
-    const auto bevel_iter           = map.find("bevel");
-    const auto colorize_iter        = map.find("colorize");
-    const auto variations_iter      = map.find("vars");
-    const auto random_iter          = map.find("random");
-
-    if (depth_iter != notfound)           deser_depth_or_throw(depth_iter->second.get(), depth);
-    if (tags_iter != notfound)            deser_tags_or_throw(tags_iter->second.get(), tags);
-    if (repeat_iter != notfound)          deser_repeat_or_throw(repeat_iter->second.get(), repeat);
-    if (size_iter != notfound)            deser_size_or_throw(size_iter->second.get(), width, height);
-    if (color_treatment_iter != notfound) deser_color_treatment_or_throw(color_treatment_iter->second.get(), color_treatment);
-    if (bevel_iter != notfound)           deser_bevel_or_throw(bevel_iter->second.get(), bevel);
-    if (colorize_iter != notfound)        deser_colorize_or_throw(colorize_iter->second.get(), colorize);
-    if (random_iter != notfound)          deser_random_or_throw(random_iter->second.get(), random);
-    if (variations_iter != notfound)      deser_variations_or_throw(variations_iter->second.get(), variations);
+    const auto depth_iter           = map.find(mp::keys::depth);
+    const auto tags_iter            = map.find(mp::keys::tags); 
+    const auto repeat_iter          = map.find(mp::keys::repeatl);
+    const auto size_iter            = map.find(mp::keys::sz);
+    const auto color_treatment_iter = map.find(mp::keys::colortreatment);
+    const auto bevel_iter           = map.find(mp::keys::bevel);
+    const auto colorize_iter        = map.find(mp::keys::colorize);
+    const auto variations_iter      = map.find(mp::keys::vars);
+    const auto random_iter          = map.find(mp::keys::random);
+
+    if (depth_iter != notfound)           deser_depth_or_throw(depth_iter->second, depth);
+    if (tags_iter != notfound)            deser_tags_or_throw(tags_iter->second, tags);
+    if (repeat_iter != notfound)          deser_repeat_or_throw(repeat_iter->second, repeat);
+    if (size_iter != notfound)            deser_size_or_throw(size_iter->second, width, height);
+    if (color_treatment_iter != notfound) deser_color_treatment_or_throw(color_treatment_iter->second, color_treatment);
+    if (bevel_iter != notfound)           deser_bevel_or_throw(bevel_iter->second, bevel);
+    if (colorize_iter != notfound)        deser_colorize_or_throw(colorize_iter->second, colorize);
+    if (random_iter != notfound)          deser_random_or_throw(random_iter->second, random);
+    if (variations_iter != notfound)      deser_variations_or_throw(variations_iter->second, variations);
 
     return new mr::VariedStandard(
         depth, 
@@ -703,25 +726,25 @@ mr::Soft            *deser_soft_prop            (const mp::Props *node) {
     deser_nm_or_throw(node, name);
     
     // Optional
-    const auto depth_iter            = map.find("depth");
-    const auto tags_iter             = map.find("tags");
-    const auto round_iter            = map.find("round");
-    const auto self_shade_iter       = map.find("selfshade");
-    const auto smooth_shading_iter   = map.find("smoothshading");
-    const auto contour_exp_iter      = map.find("contourexp");
-    const auto highlight_border_iter = map.find("highlightborder");
-    const auto depth_aff_iter        = map.find("depthaffecthilites");
-    const auto shadow_border_iter    = map.find("shadowborder");
-
-    if (depth_iter != notfound)            deser_depth_or_throw(depth_iter->second.get(), depth);
-    if (tags_iter != notfound)             deser_tags_or_throw(tags_iter->second.get(), tags);
-    if (round_iter != notfound)            deser_round_or_throw(round_iter->second.get(), round);
-    if (self_shade_iter != notfound)       deser_self_shade_or_throw(self_shade_iter->second.get(), self_shade);
-    if (smooth_shading_iter != notfound)   deser_smooth_shading_or_throw(smooth_shading_iter->second.get(), smooth_shading);
-    if (contour_exp_iter != notfound)      deser_contour_exp_or_throw(contour_exp_iter->second.get(), contour_exp);
-    if (highlight_border_iter != notfound) deser_highlight_border_or_throw(highlight_border_iter->second.get(), highlight_border);
-    if (depth_aff_iter != notfound)        deser_depth_aff_hil_or_throw(depth_aff_iter->second.get(), depth_affect_hilites);
-    if (shadow_border_iter != notfound)    deser_shadow_border_or_throw(shadow_border_iter->second.get(), shadow_border);
+    const auto depth_iter            = map.find(mp::keys::depth);
+    const auto tags_iter             = map.find(mp::keys::tags);
+    const auto round_iter            = map.find(mp::keys::round);
+    const auto self_shade_iter       = map.find(mp::keys::selfshade);
+    const auto smooth_shading_iter   = map.find(mp::keys::smoothshading);
+    const auto contour_exp_iter      = map.find(mp::keys::contourexp);
+    const auto highlight_border_iter = map.find(mp::keys::highlightborder);
+    const auto depth_aff_iter        = map.find(mp::keys::depthaffecthilites);
+    const auto shadow_border_iter    = map.find(mp::keys::shadowborder);
+
+    if (depth_iter != notfound)            deser_depth_or_throw(depth_iter->second, depth);
+    if (tags_iter != notfound)             deser_tags_or_throw(tags_iter->second, tags);
+    if (round_iter != notfound)            deser_round_or_throw(round_iter->second, round);
+    if (self_shade_iter != notfound)       deser_self_shade_or_throw(self_shade_iter->second, self_shade);
+    if (smooth_shading_iter != notfound)   deser_smooth_shading_or_throw(smooth_shading_iter->second, smooth_shading);
+    if (contour_exp_iter != notfound)      deser_contour_exp_or_throw(contour_exp_iter->second, contour_exp);
+    if (highlight_border_iter != notfound) deser_highlight_border_or_throw(highlight_border_iter->second, highlight_border);
+    if (depth_aff_iter != notfound)        deser_depth_aff_hil_or_throw(depth_aff_iter->second, depth_affect_hilites);
+    if (shadow_border_iter != notfound)    deser_shadow_border_or_throw(shadow_border_iter->second, shadow_border);
 
     return new mr::Soft(
         depth, std::move(name), std::move(tags),
@@ -750,36 +773,36 @@ mr::VariedSoft      *deser_varied_soft_prop     (const mp::Props *node) {
     // Required
     deser_nm_or_throw(node, name);
 
-    const auto pixel_size_iter = map.find("pxlsize");
+    const auto pixel_size_iter = map.find(mp::keys::pxlsize);
     if (pixel_size_iter == notfound) throw mr::deserialization_failure("missing required property #pxlSize");       
-    deser_pixel_size_or_throw(pixel_size_iter->second.get(), pixel_width, pixel_height);
+    deser_pixel_size_or_throw(pixel_size_iter->second, pixel_width, pixel_height);
     
     // Optional
-    const auto depth_iter            = map.find("depth");
-    const auto tags_iter             = map.find("tags");
-    const auto round_iter            = map.find("round");
-    const auto self_shade_iter       = map.find("selfshade");
-    const auto smooth_shading_iter   = map.find("smoothshading");
-    const auto contour_exp_iter      = map.find("contourexp");
-    const auto highlight_border_iter = map.find("highlightborder");
-    const auto depth_aff_iter        = map.find("depthaffecthilites");
-    const auto shadow_border_iter    = map.find("shadowborder");
-    const auto random_iter           = map.find("random");
-    const auto colorize_iter         = map.find("colorize");
-    const auto variations_iter       = map.find("vars");
-
-    if (depth_iter != notfound)            deser_depth_or_throw(depth_iter->second.get(), depth);
-    if (tags_iter != notfound)             deser_tags_or_throw(tags_iter->second.get(), tags);
-    if (round_iter != notfound)            deser_round_or_throw(round_iter->second.get(), round);
-    if (self_shade_iter != notfound)       deser_self_shade_or_throw(self_shade_iter->second.get(), self_shade);
-    if (smooth_shading_iter != notfound)   deser_smooth_shading_or_throw(smooth_shading_iter->second.get(), smooth_shading);
-    if (contour_exp_iter != notfound)      deser_contour_exp_or_throw(contour_exp_iter->second.get(), contour_exp);
-    if (highlight_border_iter != notfound) deser_highlight_border_or_throw(highlight_border_iter->second.get(), highlight_border);
-    if (depth_aff_iter != notfound)        deser_depth_aff_hil_or_throw(depth_aff_iter->second.get(), depth_affect_hilites);
-    if (shadow_border_iter != notfound)    deser_shadow_border_or_throw(shadow_border_iter->second.get(), shadow_border);
-    if (random_iter != notfound)           deser_random_or_throw(random_iter->second.get(), random);
-    if (colorize_iter != notfound)         deser_colorize_or_throw(colorize_iter->second.get(), colorize);
-    if (variations_iter != notfound)       deser_variations_or_throw(variations_iter->second.get(), variations);
+    const auto depth_iter            = map.find(mp::keys::depth);
+    const auto tags_iter             = map.find(mp::keys::tags);
+    const auto round_iter            = map.find(mp::keys::round);
+    const auto self_shade_iter       = map.find(mp::keys::selfshade);
+    const auto smooth_shading_iter   = map.find(mp::keys::smoothshading);
+    const auto contour_exp_iter      = map.find(mp::keys::contourexp);
+    const auto highlight_border_iter = map.find(mp::keys::highlightborder);
+    const auto depth_aff_iter        = map.find(mp::keys::depthaffecthilites);
+    const auto shadow_border_iter    = map.find(mp::keys::shadowborder);
+    const auto random_iter           = map.find(mp::keys::random);
+    const auto colorize_iter         = map.find(mp::keys::colorize);
+    const auto variations_iter       = map.find(mp::keys::vars);
+
+    if (depth_iter != notfound)            deser_depth_or_throw(depth_iter->second, depth);
+    if (tags_iter != notfound)             deser_tags_or_throw(tags_iter->second, tags);
+    if (round_iter != notfound)            deser_round_or_throw(round_iter->second, round);
+    if (self_shade_iter != notfound)       deser_self_shade_or_throw(self_shade_iter->second, self_shade);
+    if (smooth_shading_iter != notfound)   deser_smooth_shading_or_throw(smooth_shading_iter->second, smooth_shading);
+    if (contour_exp_iter != notfound)      deser_contour_exp_or_throw(contour_exp_iter->second, contour_exp);
+    if (highlight_border_iter != notfound) deser_highlight_border_or_throw(highlight_border_iter->second, highlight_border);
+    if (depth_aff_iter != notfound)        deser_depth_aff_hil_or_throw(depth_aff_iter->second, depth_affect_hilites);
+    if (shadow_border_iter != notfound)    deser_shadow_border_or_throw(shadow_border_iter->second, shadow_border);
+    if (random_iter != notfound)           deser_random_or_throw(random_iter->second, random);
+    if (colorize_iter != notfound)         deser_colorize_or_throw(colorize_iter->second, colorize);
+    if (variations_iter != notfound)       deser_variations_or_throw(variations_iter->second, variations);
 
     return new mr::VariedSoft(
         depth, std::move(name), std::move(tags),
@@ -812,32 +835,32 @@ mr::ColoredSoft     *deser_colored_soft_prop    (const mp::Props *node) {
     // Required
     deser_nm_or_throw(node, name);
 
-    const auto pixel_size_iter = map.find("pxlsize");
+    const auto pixel_size_iter = map.find(mp::keys::pxlsize);
     if (pixel_size_iter == notfound) throw mr::deserialization_failure("missing required property #pxlSize");       
-    deser_pixel_size_or_throw(pixel_size_iter->second.get(), pixel_width, pixel_height);
+    deser_pixel_size_or_throw(pixel_size_iter->second, pixel_width, pixel_height);
 
     // Optional
-    const auto depth_iter            = map.find("depth");
-    const auto tags_iter             = map.find("tags");
-    const auto round_iter            = map.find("round");
-    const auto self_shade_iter       = map.find("selfshade");
-    const auto smooth_shading_iter   = map.find("smoothshading");
-    const auto contour_exp_iter      = map.find("contourexp");
-    const auto highlight_border_iter = map.find("highlightborder");
-    const auto depth_aff_iter        = map.find("depthaffecthilites");
-    const auto shadow_border_iter    = map.find("shadowborder");
-    const auto colorize_iter         = map.find("colorize");
-
-    if (depth_iter != notfound)            deser_depth_or_throw(depth_iter->second.get(), depth);
-    if (tags_iter != notfound)             deser_tags_or_throw(tags_iter->second.get(), tags);
-    if (round_iter != notfound)            deser_round_or_throw(round_iter->second.get(), round);
-    if (self_shade_iter != notfound)       deser_self_shade_or_throw(self_shade_iter->second.get(), self_shade);
-    if (smooth_shading_iter != notfound)   deser_smooth_shading_or_throw(smooth_shading_iter->second.get(), smooth_shading);
-    if (contour_exp_iter != notfound)      deser_contour_exp_or_throw(contour_exp_iter->second.get(), contour_exp);
-    if (highlight_border_iter != notfound) deser_highlight_border_or_throw(highlight_border_iter->second.get(), highlight_border);
-    if (depth_aff_iter != notfound)        deser_depth_aff_hil_or_throw(depth_aff_iter->second.get(), depth_affect_hilites);
-    if (shadow_border_iter != notfound)    deser_shadow_border_or_throw(shadow_border_iter->second.get(), shadow_border);
-    if (colorize_iter != notfound)         deser_colorize_or_throw(colorize_iter->second.get(), colorize);
+    const auto depth_iter            = map.find(mp::keys::depth);
+    const auto tags_iter             = map.find(mp::keys::tags);
+    const auto round_iter            = map.find(mp::keys::round);
+    const auto self_shade_iter       = map.find(mp::keys::selfshade);
+    const auto smooth_shading_iter   = map.find(mp::keys::smoothshading);
+    const auto contour_exp_iter      = map.find(mp::keys::contourexp);
+    const auto highlight_border_iter = map.find(mp::keys::highlightborder);
+    const auto depth_aff_iter        = map.find(mp::keys::depthaffecthilites);
+    const auto shadow_border_iter    = map.find(mp::keys::shadowborder);
+    const auto colorize_iter         = map.find(mp::keys::colorize);
+
+    if (depth_iter != notfound)            deser_depth_or_throw(depth_iter->second, depth);
+    if (tags_iter != notfound)             deser_tags_or_throw(tags_iter->second, tags);
+    if (round_iter != notfound)            deser_round_or_throw(round_iter->second, round);
+    if (self_shade_iter != notfound)       deser_self_shade_or_throw(self_shade_iter->second, self_shade);
+    if (smooth_shading_iter != notfound)   deser_smooth_shading_or_throw(smooth_shading_iter->second, smooth_shading);
+    if (contour_exp_iter != notfound)      deser_contour_exp_or_throw(contour_exp_iter->second, contour_exp);
+    if (highlight_border_iter != notfound) deser_highlight_border_or_throw(highlight_border_iter->second, highlight_border);
+    if (depth_aff_iter != notfound)        deser_depth_aff_hil_or_throw(depth_aff_iter->second, depth_affect_hilites);
+    if (shadow_border_iter != notfound)    deser_shadow_border_or_throw(shadow_border_iter->second, shadow_border);
+    if (colorize_iter != notfound)         deser_colorize_or_throw(colorize_iter->second, colorize);
 
     return new mr::ColoredSoft(
         depth, std::move(name), std::move(tags),
@@ -865,11 +888,11 @@ mr::SoftEffect      *deser_soft_effect_prop     (const mp::Props *node) {
     deser_nm_or_throw(node, name);
 
     // Optional
-    const auto depth_iter           = map.find("depth");
-    const auto tags_iter            = map.find("tags"); 
+    const auto depth_iter           = map.find(mp::keys::depth);
+    const auto tags_iter            = map.find(mp::keys::tags); 
 
-    if (depth_iter != notfound)           deser_depth_or_throw(depth_iter->second.get(), depth);
-    if (tags_iter != notfound)            deser_tags_or_throw(tags_iter->second.get(), tags);
+    if (depth_iter != notfound)           deser_depth_or_throw(depth_iter->second, depth);
+    if (tags_iter != notfound)            deser_tags_or_throw(tags_iter->second, tags);
 
     return new mr::SoftEffect(
         depth, std::move(name), std::move(tags)
@@ -887,11 +910,11 @@ mr::Decal           *deser_decal_prop           (const mp::Props *node) {
     deser_nm_or_throw(node, name);
 
     // Optional
-    const auto depth_iter           = map.find("depth");
-    const auto tags_iter            = map.find("tags"); 
+    const auto depth_iter           = map.find(mp::keys::depth);
+    const auto tags_iter            = map.find(mp::keys::tags); 
 
-    if (depth_iter != notfound)           deser_depth_or_throw(depth_iter->second.get(), depth);
-    if (tags_iter != notfound)            deser_tags_or_throw(tags_iter->second.get(), tags);
+    if (depth_iter != notfound)           deser_depth_or_throw(depth_iter->second, depth);
+    if (tags_iter != notfound)            deser_tags_or_throw(tags_iter->second, tags);
 
     return new mr::Decal(
         depth, std::move(name), std::move(tags)
@@ -912,21 +935,21 @@ mr::VariedDecal     *deser_varied_decal_prop    (const mp::Props *node) {
     // Required
     deser_nm_or_throw(node, name);
 
-    const auto pixel_size_iter       = map.find("pxlsize");
+    const auto pixel_size_iter       = map.find(mp::keys::pxlsize);
     if (pixel_size_iter == notfound) throw mr::deserialization_failure("missing required property #pxlSize");
-    deser_pixel_size_or_throw(pixel_size_iter->second.get(), pixel_width, pixel_height);
+    deser_pixel_size_or_throw(pixel_size_iter->second, pixel_width, pixel_height);
 
 
     // Optional
-    const auto depth_iter            = map.find("depth");
-    const auto tags_iter             = map.find("tags");
-    const auto random_iter           = map.find("random");
-    const auto variations_iter       = map.find("vars");
+    const auto depth_iter            = map.find(mp::keys::depth);
+    const auto tags_iter             = map.find(mp::keys::tags);
+    const auto random_iter           = map.find(mp::keys::random);
+    const auto variations_iter       = map.find(mp::keys::vars);
 
-    if (depth_iter != notfound)      deser_depth_or_throw(depth_iter->second.get(), depth);
-    if (tags_iter != notfound)       deser_tags_or_throw(tags_iter->second.get(), tags);
-    if (random_iter != notfound)     deser_random_or_throw(random_iter->second.get(), random);
-    if (variations_iter != notfound) deser_variations_or_throw(variations_iter->second.get(), variations);
+    if (depth_iter != notfound)      deser_depth_or_throw(depth_iter->second, depth);
+    if (tags_iter != notfound)       deser_tags_or_throw(tags_iter->second, tags);
+    if (random_iter != notfound)     deser_random_or_throw(random_iter->second, random);
+    if (variations_iter != notfound) deser_variations_or_throw(variations_iter->second, variations);
 
     return new mr::VariedDecal(
         depth, std::move(name), std::move(tags),
@@ -950,13 +973,13 @@ mr::Antimatter      *deser_antimatter_prop      (const mp::Props *node) {
     deser_nm_or_throw(node, name);
 
     // Optional
-    const auto depth_iter           = map.find("depth");
-    const auto tags_iter            = map.find("tags");
-    const auto contour_exp_iter      = map.find("contourexp");
+    const auto depth_iter           = map.find(mp::keys::depth);
+    const auto tags_iter            = map.find(mp::keys::tags);
+    const auto contour_exp_iter      = map.find(mp::keys::contourexp);
 
-    if (depth_iter != notfound)           deser_depth_or_throw(depth_iter->second.get(), depth);
-    if (tags_iter != notfound)            deser_tags_or_throw(tags_iter->second.get(), tags);
-    if (contour_exp_iter != notfound)      deser_contour_exp_or_throw(contour_exp_iter->second.get(), contour_exp);
+    if (depth_iter != notfound)           deser_depth_or_throw(depth_iter->second, depth);
+    if (tags_iter != notfound)            deser_tags_or_throw(tags_iter->second, tags);
+    if (contour_exp_iter != notfound)      deser_contour_exp_or_throw(contour_exp_iter->second, contour_exp);
 
     return new mr::Antimatter(
         depth, std::move(name), std::move(tags), contour_exp
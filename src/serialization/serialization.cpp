@@ -1,10 +1,14 @@
 #include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <future>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -17,6 +21,9 @@
 #include <toml++/impl/parse_error.hpp>
 #include <toml++/impl/parser.hpp>
 
+#include <MobitParser/events.h>
+#include <MobitParser/exceptions.h>
+#include <MobitParser/mapping.h>
 #include <MobitParser/nodes.h>
 #include <MobitParser/tokens.h>
 
@@ -30,8 +37,8 @@
 namespace mr::serde {
 
 CustomMaterialDef *deser_materialdef(const mp::Node *node) {
-  const mp::Props *props = dynamic_cast<const mp::Props*>(node);
-   
+  const mp::Props *props = mp::node_cast<mp::Props>(node);
+
   if (props == nullptr) throw deserialization_failure("node is not a property list");
 
   std::string name;
@@ -47,8 +54,8 @@ CustomMaterialDef *deser_materialdef(const mp::Node *node) {
 
   // nm
   try {
-    const auto &name_node = dict.at("nm");
-    name = deser_string(name_node.get());
+    const auto &name_node = dict.at(mp::keys::nm);
+    name = deser_string(name_node);
   } catch (std::out_of_range &e) {
     throw deserialization_failure("missing required propery: 'nm'");
   } catch (deserialization_failure &de) {
@@ -59,8 +66,8 @@ CustomMaterialDef *deser_materialdef(const mp::Node *node) {
 
   // color
   try {
-    const auto &color_node = dict.at("color");
-    color = deser_color(color_node.get());
+    const auto &color_node = dict.at(mp::keys::color);
+    color = deser_color(color_node);
   } catch (std::out_of_range &e) {
     color = RED;
   } catch (deserialization_failure &de) {
@@ -71,11 +78,11 @@ CustomMaterialDef *deser_materialdef(const mp::Node *node) {
 
   // Params
 
-  auto texture_params_iter = dict.find("texture");
+  auto texture_params_iter = dict.find(mp::keys::texture);
   if (texture_params_iter != dict.end()) {
-    mp::Node *texture_params_node = texture_params_iter->second.get();
+    mp::Node *texture_params_node = texture_params_iter->second;
 
-    mp::Props *texture_props = dynamic_cast<mp::Props*>(texture_params_node);
+    mp::Props *texture_props = mp::node_cast<mp::Props>(texture_params_node);
     if (texture_props == nullptr) throw deserialization_failure("#texture property is not a property list");
 
     int tw, th;
@@ -83,7 +90,7 @@ CustomMaterialDef *deser_materialdef(const mp::Node *node) {
     std::unordered_set<std::string> ttags;
 
     try {
-      mp::Node *size_node = texture_props->map.at("sz").get();
+      mp::Node *size_node = texture_props->map.at(mp::keys::sz);
       deser_point(size_node, tw, th);
 
     } catch (std::out_of_range &re) {
@@ -94,10 +101,10 @@ CustomMaterialDef *deser_materialdef(const mp::Node *node) {
       throw deserialization_failure(msg);
     }
 
-    auto trepeat_iter = texture_props->map.find("repeatl");
+    auto trepeat_iter = texture_props->map.find(mp::keys::repeatl);
     if (trepeat_iter != texture_props->map.end()) {
       try {
-        trepeat = deser_int_vec(trepeat_iter->second.get());
+        trepeat = deser_int_vec(trepeat_iter->second);
       } catch (deserialization_failure &de) {
         throw deserialization_failure(
           std::string("failed to deserialize #texture property 'repeatL': ") + de.what()
@@ -105,10 +112,10 @@ CustomMaterialDef *deser_materialdef(const mp::Node *node) {
       }
     }
 
-    auto ttags_iter = texture_props->map.find("tags");
+    auto ttags_iter = texture_props->map.find(mp::keys::tags);
     if (ttags_iter != texture_props->map.end()) {
       try {
-        ttags = deser_string_set(ttags_iter->second.get());
+        ttags = deser_string_set(ttags_iter->second);
       } catch (deserialization_failure &de) {
         throw deserialization_failure(
           std::string("failed to deserialize #texture property 'tags': ") + de.what()
@@ -119,22 +126,22 @@ CustomMaterialDef *deser_materialdef(const mp::Node *node) {
     texture_params = new MaterialDefTexture(tw, th, trepeat, ttags);
   }
 
-  auto block_params_iter = dict.find("block");
+  auto block_params_iter = dict.find(mp::keys::block);
   if (block_params_iter != dict.end()) {
     std::vector<int> brepeat;
     int brnd;
     int bbuffer;
     std::unordered_set<std::string> btags;
 
-    mp::Props *block_props = dynamic_cast<mp::Props*>(block_params_iter->second.get());
+    mp::Props *block_props = mp::node_cast<mp::Props>(block_params_iter->second);
     if (block_props == nullptr) throw deserialization_failure("#block property is not a property list");
 
     /// TODO: continue here..
 
-    auto brnd_iter = block_props->map.find("rnd");
+    auto brnd_iter = block_props->map.find(mp::keys::rnd);
     if (brnd_iter != block_props->map.end()) {
       try {
-        brnd = deser_int(brnd_iter->second.get());
+        brnd = deser_int(brnd_iter->second);
       } catch (deserialization_failure &de) {
         throw deserialization_failure(
           std::string("failed to deserialize #block property 'rnd': ") + de.what()
@@ -142,10 +149,10 @@ CustomMaterialDef *deser_materialdef(const mp::Node *node) {
       }
     }
 
-    auto bbuffer_iter = block_props->map.find("bftiles");
+    auto bbuffer_iter = block_props->map.find(mp::keys::bftiles);
     if (bbuffer_iter != block_props->map.end()) {
       try {
-        bbuffer = deser_uint8(bbuffer_iter->second.get());
+        bbuffer = deser_uint8(bbuffer_iter->second);
       } catch (deserialization_failure &de) {
         throw deserialization_failure(
           std::string("failed to deserialize #block property 'bfTiles': ") + de.what()
@@ -153,10 +160,10 @@ CustomMaterialDef *deser_materialdef(const mp::Node *node) {
       }
     }
 
-    auto btags_iter = block_props->map.find("tags");
+    auto btags_iter = block_props->map.find(mp::keys::tags);
     if (btags_iter != block_props->map.end()) {
       try {
-        btags = deser_string_set(btags_iter->second.get());
+        btags = deser_string_set(btags_iter->second);
       } catch (deserialization_failure &de) {
         throw deserialization_failure(
           std::string("failed to deserialize #block property 'tags': ") + de.what()
@@ -172,22 +179,22 @@ CustomMaterialDef *deser_materialdef(const mp::Node *node) {
     );
   }
 
-  auto slope_params_iter = dict.find("slope");
+  auto slope_params_iter = dict.find(mp::keys::slope);
   if (slope_params_iter != dict.end()) {
     std::vector<int> brepeat;
     int brnd;
     int bbuffer;
     std::unordered_set<std::string> btags;
 
-    mp::Props *block_props = dynamic_cast<mp::Props*>(block_params_iter->second.get());
+    mp::Props *block_props = mp::node_cast<mp::Props>(block_params_iter->second);
     if (block_props == nullptr) throw deserialization_failure("#block property is not a property list");
 
     /// TODO: continue here..
 
-    auto brnd_iter = block_props->map.find("rnd");
+    auto brnd_iter = block_props->map.find(mp::keys::rnd);
     if (brnd_iter != block_props->map.end()) {
       try {
-        brnd = deser_int(brnd_iter->second.get());
+        brnd = deser_int(brnd_iter->second);
       } catch (deserialization_failure &de) {
         throw deserialization_failure(
           std::string("failed to deserialize #slope property 'rnd': ") + de.what()
@@ -195,10 +202,10 @@ CustomMaterialDef *deser_materialdef(const mp::Node *node) {
       }
     }
 
-    auto bbuffer_iter = block_props->map.find("bftiles");
+    auto bbuffer_iter = block_props->map.find(mp::keys::bftiles);
     if (bbuffer_iter != block_props->map.end()) {
       try {
-        bbuffer = deser_uint8(bbuffer_iter->second.get());
+        bbuffer = deser_uint8(bbuffer_iter->second);
       } catch (deserialization_failure &de) {
         throw deserialization_failure(
           std::string("failed to deserialize #slope property 'bfTiles': ") + de.what()
@@ -206,10 +213,10 @@ CustomMaterialDef *deser_materialdef(const mp::Node *node) {
       }
     }
 
-    auto btags_iter = block_props->map.find("tags");
+    auto btags_iter = block_props->map.find(mp::keys::tags);
     if (btags_iter != block_props->map.end()) {
       try {
-        btags = deser_string_set(btags_iter->second.get());
+        btags = deser_string_set(btags_iter->second);
       } catch (deserialization_failure &de) {
         throw deserialization_failure(
           std::string("failed to deserialize #slope property 'tags': ") + de.what()
@@ -225,22 +232,22 @@ CustomMaterialDef *deser_materialdef(const mp::Node *node) {
     );
   }
 
-  auto floor_params_iter = dict.find("floor");
+  auto floor_params_iter = dict.find(mp::keys::floor);
   if (floor_params_iter != dict.end()) {
     std::vector<int> brepeat;
     int brnd;
     int bbuffer;
     std::unordered_set<std::string> btags;
 
-    mp::Props *block_props = dynamic_cast<mp::Props*>(block_params_iter->second.get());
+    mp::Props *block_props = mp::node_cast<mp::Props>(block_params_iter->second);
     if (block_props == nullptr) throw deserialization_failure("#block property is not a property list");
 
     /// TODO: continue here..
 
-    auto brnd_iter = block_props->map.find("rnd");
+    auto brnd_iter = block_props->map.find(mp::keys::rnd);
     if (brnd_iter != block_props->map.end()) {
       try {
-        brnd = deser_int(brnd_iter->second.get());
+        brnd = deser_int(brnd_iter->second);
       } catch (deserialization_failure &de) {
         throw deserialization_failure(
           std::string("failed to deserialize #floor property 'rnd': ") + de.what()
@@ -248,10 +255,10 @@ CustomMaterialDef *deser_materialdef(const mp::Node *node) {
       }
     }
 
-    auto bbuffer_iter = block_props->map.find("bftiles");
+    auto bbuffer_iter = block_props->map.find(mp::keys::bftiles);
     if (bbuffer_iter != block_props->map.end()) {
       try {
-        bbuffer = deser_uint8(bbuffer_iter->second.get());
+        bbuffer = deser_uint8(bbuffer_iter->second);
       } catch (deserialization_failure &de) {
         throw deserialization_failure(
           std::string("failed to deserialize #floor property 'bfTiles': ") + de.what()
@@ -259,10 +266,10 @@ CustomMaterialDef *deser_materialdef(const mp::Node *node) {
       }
     }
 
-    auto btags_iter = block_props->map.find("tags");
+    auto btags_iter = block_props->map.find(mp::keys::tags);
     if (btags_iter != block_props->map.end()) {
       try {
-        btags = deser_string_set(btags_iter->second.get());
+        btags = deser_string_set(btags_iter->second);
       } catch (deserialization_failure &de) {
         throw deserialization_failure(
           std::string("failed to deserialize #floor property 'tags': ") + de.what()
@@ -279,8 +286,8 @@ CustomMaterialDef *deser_materialdef(const mp::Node *node) {
   }
 
   return new CustomMaterialDef(
-    name, 
-    color, 
+    name,
+    color,
     texture_params,
     block_params,
     slope_params,
@@ -372,169 +379,182 @@ GeoType get_geo_type(int type) {
   }
 }
 
+GeoFeature get_geo_feature(int feature) {
+  switch (feature) {
+  case 1:
+    return GeoFeature::horizontal_pole;
+  case 2:
+    return GeoFeature::vertical_pole;
+
+  case 3:
+    return GeoFeature::bathive;
+  case 4:
+    return GeoFeature::shortcut_entrance;
+  case 5:
+    return GeoFeature::shortcut_path;
+  case 6:
+    return GeoFeature::room_entrance;
+  case 7:
+    return GeoFeature::dragon_den;
+  case 9:
+    return GeoFeature::place_rock;
+  case 10:
+    return GeoFeature::place_spear;
+  case 11:
+    return GeoFeature::cracked_terrain;
+  case 12:
+    return GeoFeature::forbid_fly_chains;
+  case 13:
+    return GeoFeature::garbage_worm_hole;
+  case 18:
+    return GeoFeature::waterfall;
+  case 19:
+    return GeoFeature::wack_a_mole_hole;
+  case 20:
+    return GeoFeature::worm_grass;
+  case 21:
+    return GeoFeature::scavenger_hole;
+
+  default:
+    return GeoFeature::none;
+  }
+}
+
 GeoFeature get_geo_features(const mp::List *list) {
   auto features = GeoFeature::none;
 
-  for (auto &feature_element : list->elements) {
-    auto *feature_ptr = dynamic_cast<mp::Int *>(feature_element.get());
-
-    if (feature_ptr == nullptr)
+  for (const auto *feature : list->elements) {
+    if (feature == nullptr || feature->kind != mp::node_kind::integer)
       continue;
 
-    GeoFeature feature;
+    features = features | get_geo_feature(feature->as_int()->number);
+  }
 
-    switch (feature_ptr->number) {
-    case 1:
-      feature = GeoFeature::horizontal_pole;
-      break;
-    case 2:
-      feature = GeoFeature::vertical_pole;
-      break;
+  return features;
+}
 
-    case 3:
-      feature = GeoFeature::bathive;
-      break;
-    case 4:
-      feature = GeoFeature::shortcut_entrance;
-      break;
-    case 5:
-      feature = GeoFeature::shortcut_path;
-      break;
-    case 6:
-      feature = GeoFeature::room_entrance;
-      break;
-    case 7:
-      feature = GeoFeature::dragon_den;
-      break;
-    case 9:
-      feature = GeoFeature::place_rock;
-      break;
-    case 10:
-      feature = GeoFeature::place_spear;
-      break;
-    case 11:
-      feature = GeoFeature::cracked_terrain;
-      break;
-    case 12:
-      feature = GeoFeature::forbid_fly_chains;
-      break;
-    case 13:
-      feature = GeoFeature::garbage_worm_hole;
-      break;
-    case 18:
-      feature = GeoFeature::waterfall;
-      break;
-    case 19:
-      feature = GeoFeature::wack_a_mole_hole;
-      break;
-    case 20:
-      feature = GeoFeature::worm_grass;
-      break;
-    case 21:
-      feature = GeoFeature::scavenger_hole;
-      break;
+static const char *find_line_end(const char *cursor, const char *end) {
+  // Lines end with '\n', "\r\n" or a lone '\r'; memchr() scans
+  // for each a word at a time.
+  const auto *line_feed = static_cast<const char *>(
+    std::memchr(cursor, '\n', static_cast<size_t>(end - cursor))
+  );
 
-    default:
-      feature = GeoFeature::none;
-      break;
-    }
+  const char *limit = line_feed == nullptr ? end : line_feed;
 
-    features = features | feature;
-  }
+  const auto *carriage_return = static_cast<const char *>(
+    std::memchr(cursor, '\r', static_cast<size_t>(limit - cursor))
+  );
 
-  return features;
+  return carriage_return == nullptr ? limit : carriage_return;
 }
-std::unique_ptr<ProjectSaveFileNodes> parse_project(const std::filesystem::path &file_path) {
-  std::ifstream file(file_path);
 
-  if (!file.is_open()) {
-    std::stringstream ss;
-    ss << "could not open project save file '" << file_path << "'";
+std::unique_ptr<ProjectSaveFileViews> map_project(const std::filesystem::path &file_path) {
+  auto views = std::make_unique<ProjectSaveFileViews>();
+
+  try {
+    views->file = std::make_unique<mp::mapped_file>(file_path);
+  } catch (mp::mapping_failure &) {
     throw file_read_error();
   }
 
+  std::string_view *lines[] = {
+    &views->geometry,
+    &views->tiles,
+    &views->effects,
+    &views->light_settings,
+    &views->terrain_settings,
+    &views->seed_and_sizes,
+    &views->cameras,
+    &views->water,
+    &views->props
+  };
+
+  const char *cursor = views->file->begin();
+  const char *end = views->file->end();
+
+  for (auto *line : lines) {
+    if (cursor == end) break;
+
+    const char *line_end = find_line_end(cursor, end);
+    *line = std::string_view(cursor, static_cast<size_t>(line_end - cursor));
+
+    cursor = line_end;
+    if (cursor != end && *cursor == '\r') cursor++;
+    if (cursor != end && *cursor == '\n') cursor++;
+  }
+
+  return views;
+}
+
+/// @brief Tokenizes and parses a single line in place.
+/// @return nullptr if the line is empty.
+static std::unique_ptr<mp::Node> parse_line(std::string_view line, const char *name) {
+  // Tokens refer directly to the mapped file; nothing is copied
+  // until mp::parse() builds the nodes.
+  std::vector<mp::token_view> tokens;
+  const char *cursor = line.data();
+
+  try {
+    if (!mp::tokenize_line(cursor, line.data() + line.size(), tokens))
+      return nullptr;
+
+    return mp::parse(tokens, true);
+  } catch (std::exception &e) {
+    throw parse_failure(std::string("failed to parse ")+name+": "+e.what());
+  }
+}
+
+/// Lines shorter than this are parsed on the calling thread; spawning a
+/// worker for them costs more than it saves.
+static constexpr size_t parallel_line_threshold = 64 * 1024;
+
+std::unique_ptr<ProjectSaveFileNodes> parse_project(const ProjectSaveFileViews &views, bool matrices, bool parallel) {
   auto nodes = std::make_unique<ProjectSaveFileNodes>();
 
-  int counter = 0;
+  parallel = parallel && std::thread::hardware_concurrency() > 1;
 
-  std::vector<mp::token> tokens;
+  struct line_job {
+    std::unique_ptr<mp::Node> &node;
+    std::string_view line;
+    const char *name;
+    std::future<std::unique_ptr<mp::Node>> result;
+  };
 
-  while (mp::tokenize_line(file, tokens)) {
-    switch (counter) {
-    case 0:
-      try {
-        nodes->geometry = mp::parse(tokens, true);
-      } catch (std::exception &e) {
-        std::string msg = "failed to parse geometry: ";
-        msg.append(e.what());
-        throw parse_failure(msg);
-      }
-      break;
-    case 1:
-      try {
-        nodes->tiles = mp::parse(tokens, true);
-      } catch (std::exception &e) {
-        std::string msg = "failed to parse tiles: ";
-        msg.append(e.what());
-        throw parse_failure(msg);
-      }
-      break;
-    case 2:
-      break;
-    case 3:
-      break;
-    case 4:
-      try {
-        nodes->terrain_settings = mp::parse(tokens, true);
-      } catch (std::exception &e) {
-        std::string msg = "failed to parse terrain settings: ";
-        msg.append(e.what());
-        throw parse_failure(msg);
-      }
-      break;
-    case 5:
-      try {
-        nodes->seed_and_sizes = mp::parse(tokens, true);
-      } catch (std::exception &e) {
-        std::string msg = "failed to parse seed and sizes: ";
-        msg.append(e.what());
-        throw parse_failure(msg);
-      }
-      break;
-    case 6:
-      try {
-        nodes->cameras = mp::parse(tokens, true);
-      } catch (std::exception &e) {
-        std::string msg = "failed to parse cameras: ";
-        msg.append(e.what());
-        throw parse_failure(msg);
-      }
-      break;
-    case 7:
-      try {
-        nodes->water = mp::parse(tokens, true);
-      } catch (std::exception &e) {
-        throw parse_failure(std::string("failed to parse water: ")+e.what());
-      }
-      break;
-    case 8:
-      try {
-        nodes->props = mp::parse(tokens, true);
-      } catch (std::exception &e) {
-        throw parse_failure(std::string("failed to parse props: ")+e.what());
-      }
-      break;
-    }
+  std::vector<line_job> jobs;
+  jobs.reserve(8);
 
-    if (++counter > 8)
-      break;
-    ;
+  if (matrices) {
+    jobs.push_back({nodes->geometry, views.geometry, "geometry", {}});
+    jobs.push_back({nodes->tiles,    views.tiles,    "tiles",    {}});
   }
 
-  file.close();
+  jobs.push_back({nodes->light_settings,   views.light_settings,   "light settings",   {}});
+  jobs.push_back({nodes->terrain_settings, views.terrain_settings, "terrain settings", {}});
+  jobs.push_back({nodes->seed_and_sizes,   views.seed_and_sizes,   "seed and sizes",   {}});
+  jobs.push_back({nodes->cameras,          views.cameras,          "cameras",          {}});
+  jobs.push_back({nodes->water,            views.water,            "water",            {}});
+  jobs.push_back({nodes->props,            views.props,            "props",            {}});
+
+  // Heavy lines start on their own threads right away; the rest are
+  // deferred and run on this thread when collected. Collecting in line
+  // order reports the same error a serial parse would.
+  for (auto &job : jobs) {
+    auto policy = parallel && job.line.size() >= parallel_line_threshold
+      ? std::launch::async
+      : std::launch::deferred;
+
+    job.result = std::async(policy, parse_line, job.line, job.name);
+  }
+
+  for (auto &job : jobs) job.node = job.result.get();
 
   return nodes;
 }
+
+std::unique_ptr<ProjectSaveFileNodes> parse_project(const std::filesystem::path &file_path) {
+  return parse_project(*map_project(file_path), true, true);
+}
 std::unique_ptr<ProjectSaveFileNodes> parse_project(const std::unique_ptr<ProjectSaveFileLines> &file_lines) {
   if (file_lines == nullptr)
     return nullptr;
@@ -548,8 +568,39 @@ std::unique_ptr<ProjectSaveFileNodes> parse_project(const std::unique_ptr<Projec
   return nodes;
 }
 
+static deserialization_failure malformed_geocell(const char *what, int x, int y, int z) {
+  std::stringstream sb;
+  sb << "malformed geometry " << what << " at (x: " << x << ", y: " << y
+     << ", z: " << z << ')';
+
+  return deserialization_failure(sb.str());
+}
+
+/// @brief Deserializes a single [type, [features]] geometry cell node.
+static GeoCell deser_geocell(const mp::Node *node, int x, int y, int z) {
+  if (node == nullptr || node->kind != mp::node_kind::list)
+    throw malformed_geocell("cell", x, y, z);
+
+  const auto &layer = node->as_list()->elements;
+  if (layer.size() < 2) throw malformed_geocell("cell", x, y, z);
+
+  const mp::Node *type = layer[0];
+  const mp::Node *features = layer[1];
+
+  if (type == nullptr || type->kind != mp::node_kind::integer)
+    throw malformed_geocell("cell type", x, y, z);
+
+  if (features == nullptr || features->kind != mp::node_kind::list)
+    throw malformed_geocell("cell features", x, y, z);
+
+  return GeoCell{
+    get_geo_type(type->as_int()->number),
+    get_geo_features(features->as_list())
+  };
+}
+
 void deser_geometry_matrix(const mp::Node *node, Matrix<GeoCell> &matrix) {
-  const mp::List *columns = dynamic_cast<const mp::List *>(node);
+  const mp::List *columns = mp::node_cast<mp::List>(node);
 
   if (columns == nullptr)
     throw deserialization_failure("top level node (columns) is not a linear list");
@@ -564,7 +615,7 @@ void deser_geometry_matrix(const mp::Node *node, Matrix<GeoCell> &matrix) {
   }
 
   for (auto x = 0; x < matrix.get_width(); x++) {
-    auto *rows = dynamic_cast<mp::List *>(columns->elements[x].get());
+    auto *rows = mp::node_cast<mp::List>(columns->elements[x]);
 
     if (rows == nullptr) {
       std::stringstream sb;
@@ -585,7 +636,7 @@ void deser_geometry_matrix(const mp::Node *node, Matrix<GeoCell> &matrix) {
     }
 
     for (auto y = 0; y < matrix.get_height(); y++) {
-      auto *depth = dynamic_cast<mp::List *>(rows->elements[y].get());
+      auto *depth = mp::node_cast<mp::List>(rows->elements[y]);
 
       if (depth == nullptr)
         throw deserialization_failure(
@@ -600,154 +651,379 @@ void deser_geometry_matrix(const mp::Node *node, Matrix<GeoCell> &matrix) {
         throw deserialization_failure(sb.str());
       }
 
-      auto *l1 = dynamic_cast<mp::List *>(depth->elements[0].get());
-      auto *l2 = dynamic_cast<mp::List *>(depth->elements[1].get());
-      auto *l3 = dynamic_cast<mp::List *>(depth->elements[2].get());
+      for (int z = 0; z < 3; z++)
+        matrix.set_noexcept(x, y, z, deser_geocell(depth->elements[z], x, y, z));
+    }
+  }
 
-      if (l1 == nullptr) {
-        std::stringstream sb;
+}
 
-        sb << "malformed geometry cell at (x: " << x << ", y: " << y
-           << ", z: 0)";
-        throw deserialization_failure(sb.str());
-      }
+/// @brief Reads a single [type, [features]] geometry cell.
+/// @return What is malformed ("cell", "cell type" or "cell features"),
+/// or nullptr if the cell is valid.
+/// @note Doesn't throw on malformed cells, so that a lenient
+/// deserialization can skip any number of them without unwinding.
+static const char *read_geocell(mp::event_reader &reader, GeoCell &cell) {
+  if (reader.next().type != mp::event_type::begin_list) return "cell";
 
-      if (l2 == nullptr) {
-        std::stringstream sb;
+  const auto type = reader.next();
+  if (type.type == mp::event_type::end_list) return "cell";
+  if (type.type != mp::event_type::integer) return "cell type";
 
-        sb << "malformed geometry cell at (x: " << x << ", y: " << y
-           << ", z: 1)";
-        throw deserialization_failure(sb.str());
-      }
+  const auto features_begin = reader.next();
+  if (features_begin.type == mp::event_type::end_list) return "cell";
+  if (features_begin.type != mp::event_type::begin_list) return "cell features";
 
-      if (l3 == nullptr) {
-        std::stringstream sb;
+  auto features = GeoFeature::none;
 
-        sb << "malformed geometry cell at (x: " << x << ", y: " << y
-           << ", z: 2)";
-        throw deserialization_failure(sb.str());
-      }
+  while (reader.peek().type != mp::event_type::end_list) {
+    if (reader.peek().type == mp::event_type::integer) {
+      features = features | get_geo_feature(reader.next().integer);
+    } else {
+      reader.skip();
+    }
+  }
+  reader.next();
 
-      if (l1->elements.size() < 2) {
-        std::stringstream sb;
-        sb << "malformed geometry cell at (x: " << x << ", y: " << y
-           << ", z: 0)";
+  // Ignore any trailing elements
+  while (reader.peek().type != mp::event_type::end_list) reader.skip();
+  reader.next();
 
-        throw deserialization_failure(sb.str());
-      }
+  cell = GeoCell{get_geo_type(type.integer), features};
 
-      if (l2->elements.size() < 2) {
-        std::stringstream sb;
-        sb << "malformed geometry cell at (x: " << x << ", y: " << y
-           << ", z: 1)";
+  return nullptr;
+}
 
-        throw deserialization_failure(sb.str());
-      }
+void deser_geometry_matrix(mp::event_reader &reader, Matrix<GeoCell> &matrix, Diagnostics *diagnostics) {
+  if (reader.next().type != mp::event_type::begin_list)
+    throw deserialization_failure("top level node (columns) is not a linear list");
 
-      if (l3->elements.size() < 2) {
-        std::stringstream sb;
-        sb << "malformed geometry cell at (x: " << x << ", y: " << y
-           << ", z: 2)";
+  int x = 0;
 
-        throw deserialization_failure(sb.str());
-      }
+  for (; reader.peek().type != mp::event_type::end_list; x++) {
+    // Keep counting the columns for the error below.
+    if (x >= matrix.get_width()) {
+      reader.skip();
+      continue;
+    }
 
-      auto *geo1 = dynamic_cast<mp::Int *>(l1->elements[0].get());
-      auto *geo2 = dynamic_cast<mp::Int *>(l2->elements[0].get());
-      auto *geo3 = dynamic_cast<mp::Int *>(l3->elements[0].get());
+    if (reader.peek().type != mp::event_type::begin_list) {
+      std::stringstream sb;
 
-      auto *features1 = dynamic_cast<mp::List *>(l1->elements[1].get());
-      auto *features2 = dynamic_cast<mp::List *>(l2->elements[1].get());
-      auto *features3 = dynamic_cast<mp::List *>(l3->elements[1].get());
+      sb << "malformed geometry (expected a list of rows at column " << x
+         << ")";
 
-      if (geo1 == nullptr) {
-        std::stringstream sb;
-        sb << "malformed geometry cell type at (x: " << x << ", y: " << y
-           << ", z: 0)";
+      if (diagnostics == nullptr) throw deserialization_failure(sb.str());
 
-        throw deserialization_failure(sb.str());
-      }
+      diagnostics->report("geometry", x, -1, -1, sb.str());
+      reader.skip();
+      continue;
+    }
 
-      if (geo2 == nullptr) {
-        std::stringstream sb;
-        sb << "malformed geometry cell type at (x: " << x << ", y: " << y
-           << ", z: 1)";
+    reader.next();
 
-        throw deserialization_failure(sb.str());
+    int y = 0;
+
+    for (; reader.peek().type != mp::event_type::end_list; y++) {
+      if (y >= matrix.get_height()) {
+        reader.skip();
+        continue;
       }
 
-      if (geo3 == nullptr) {
-        std::stringstream sb;
-        sb << "malformed geometry cell type at (x: " << x << ", y: " << y
-           << ", z: 2)";
+      if (reader.peek().type != mp::event_type::begin_list) {
+        if (diagnostics == nullptr)
+          throw deserialization_failure(
+              "malformed geometry (expected a list of cell layers)");
 
-        throw deserialization_failure(sb.str());
+        diagnostics->report("geometry", x, y, -1, "malformed geometry (expected a list of cell layers)");
+        reader.skip();
+        continue;
       }
 
-      if (features1 == nullptr) {
-        std::stringstream sb;
+      reader.next();
 
-        sb << "malformed geometry cell features at (x: " << x << ", y: " << y
-           << ", z: 0";
+      int z = 0;
 
-        throw deserialization_failure(sb.str());
-      }
+      for (; reader.peek().type != mp::event_type::end_list; z++) {
+        if (z >= 3) {
+          reader.skip();
+          continue;
+        }
 
-      if (features2 == nullptr) {
-        std::stringstream sb;
+        // Where to resume from, should the cell be malformed.
+        std::optional<mp::event_reader> cell_start;
+        if (diagnostics != nullptr) cell_start = reader;
 
-        sb << "malformed geometry cell features at (x: " << x << ", y: " << y
-           << ", z: 1";
+        GeoCell cell{};
 
-        throw deserialization_failure(sb.str());
+        if (const char *what = read_geocell(reader, cell)) {
+          if (diagnostics == nullptr) throw malformed_geocell(what, x, y, z);
+
+          diagnostics->report("geometry", x, y, z, std::string("malformed geometry ")+what);
+
+          reader = *cell_start;
+          reader.skip();
+        }
+
+        matrix.set_noexcept(x, y, z, cell);
       }
 
-      if (features3 == nullptr) {
+      reader.next();
+
+      if (z != 3) {
         std::stringstream sb;
 
-        sb << "malformed geometry cell features at (x: " << x << ", y: " << y
-           << ", z: 2";
+        sb << "incorrect geometry depth; expected (3) but got (" << z << ')';
 
-        throw deserialization_failure(sb.str());
+        if (diagnostics == nullptr) throw deserialization_failure(sb.str());
+
+        diagnostics->report("geometry", x, y, -1, sb.str());
       }
+    }
 
-      matrix.set_noexcept(x, y, 0,
-                          GeoCell{get_geo_type(geo1->number),
-                                  get_geo_features(features1)});
-      matrix.set_noexcept(x, y, 1,
-                          GeoCell{get_geo_type(geo2->number),
-                                  get_geo_features(features2)});
-      matrix.set_noexcept(x, y, 2,
-                          GeoCell{get_geo_type(geo3->number),
-                                  get_geo_features(features3)});
+    reader.next();
+
+    if (y != matrix.get_height()) {
+      std::stringstream sb;
+
+      sb << "incorrect geometry height; expected (" << matrix.get_height()
+         << ") but got (" << y << ')';
+
+      if (diagnostics == nullptr) throw deserialization_failure(sb.str());
+
+      diagnostics->report("geometry", x, -1, -1, sb.str());
     }
   }
 
+  reader.next();
+
+  if (x != matrix.get_width()) {
+    std::stringstream sb;
+
+    sb << "incorrect matrix width; expected (" << matrix.get_width()
+       << "), but got (" << x << ')';
+
+    if (diagnostics == nullptr) throw deserialization_failure(sb.str());
+
+    diagnostics->report("geometry", sb.str());
+  }
+}
+
+/// @brief Deserializes the camera at the given (zero-based) position.
+static LevelCamera deser_camera(const mp::Node *camera_node, const mp::Node *quad_node, size_t e) {
+  LevelCamera camera;
+  Vector2 position;
+
+  try {
+    deser_point(camera_node, position.x, position.y);
+    camera.set_position(position);
+  } catch (deserialization_failure &de) {
+    throw deserialization_failure(
+      std::string("failed to deserialize camera position at element #")
+      +std::to_string(e)
+      +": "
+      +de.what()
+    );
+  }
+
+  // Quads
+
+  const mp::List *quad_points_node = mp::node_cast<mp::List>(quad_node);
+  if (quad_points_node == nullptr)
+    throw deserialization_failure(
+      std::string("camera quad #")
+      +std::to_string(e)
+      +" is not a Linear List"
+    );
+
+  if (quad_points_node->elements.size() < 4)
+    throw deserialization_failure(
+      std::string("camera quad #")
+      +std::to_string(e)
+      +" has insufficient element count (expected at least 4)"
+    );
+
+  // Top left
+  const mp::List *tl_node = mp::node_cast<mp::List>(quad_points_node->elements[0]);
+  if (tl_node == nullptr)
+    throw deserialization_failure(
+      std::string("camera quad #")
+      +std::to_string(e)
+      +" top left node is not a Linear List"
+    );
+
+  if (tl_node->elements.size() < 2)
+    throw deserialization_failure(
+      std::string("camera quad #")
+      +std::to_string(e)
+      +" top left node has insufficient element count (expected at least 2)"
+    );
+
+  try {
+    camera.set_top_left_angle(deser_int(tl_node->elements[0]));
+  } catch (deserialization_failure &de) {
+    throw deserialization_failure(
+      std::string("failed to deserialize camera quad #")
+      +std::to_string(e)
+      +" top left radius: "
+      +de.what()
+    );
+  }
+
+  try {
+    camera.set_top_left_radius(deser_float(tl_node->elements[1]));
+  } catch (deserialization_failure &de) {
+    throw deserialization_failure(
+      std::string("failed to deserialize camera quad #")
+      +std::to_string(e)
+      +" top left angle: "
+      +de.what()
+    );
+  }
+
+  // Top right
+  const mp::List *tr_node = mp::node_cast<mp::List>(quad_points_node->elements[1]);
+  if (tr_node == nullptr)
+    throw deserialization_failure(
+      std::string("camera quad #")
+      +std::to_string(e)
+      +" top left right is not a Linear List"
+    );
+
+  if (tr_node->elements.size() < 2)
+    throw deserialization_failure(
+      std::string("camera quad #")
+      +std::to_string(e)
+      +" top right node has insufficient element count (expected at least 2)"
+    );
+
+  try {
+    camera.set_top_right_angle(deser_int(tr_node->elements[0]));
+  } catch (deserialization_failure &de) {
+    throw deserialization_failure(
+      std::string("failed to deserialize camera quad #")
+      +std::to_string(e)
+      +" top right angle: "
+      +de.what()
+    );
+  }
+
+  try {
+    camera.set_top_right_radius(deser_float(tr_node->elements[1]));
+  } catch (deserialization_failure &de) {
+    throw deserialization_failure(
+      std::string("failed to deserialize camera quad #")
+      +std::to_string(e)
+      +" top right radius: "
+      +de.what()
+    );
+  }
+
+  // Bottom right
+  const mp::List *br_node = mp::node_cast<mp::List>(quad_points_node->elements[2]);
+  if (br_node == nullptr)
+    throw deserialization_failure(
+      std::string("camera quad #")
+      +std::to_string(e)
+      +" bottom right node is not a Linear List"
+    );
+
+  if (br_node->elements.size() < 2)
+    throw deserialization_failure(
+      std::string("camera quad #")
+      +std::to_string(e)
+      +" bottom right node has insufficient element count (expected at least 2)"
+    );
+
+  try {
+    camera.set_bottom_right_angle(deser_int(br_node->elements[0]));
+  } catch (deserialization_failure &de) {
+    throw deserialization_failure(
+      std::string("failed to deserialize camera quad #")
+      +std::to_string(e)
+      +" bottom right angle: "
+      +de.what()
+    );
+  }
+
+  try {
+    camera.set_bottom_right_radius(deser_float(br_node->elements[1]));
+  } catch (deserialization_failure &de) {
+    throw deserialization_failure(
+      std::string("failed to deserialize camera quad #")
+      +std::to_string(e)
+      +" bottom right radius: "
+      +de.what()
+    );
+  }
+
+  // Bottom left
+  const mp::List *bl_node = mp::node_cast<mp::List>(quad_points_node->elements[3]);
+  if (bl_node == nullptr)
+    throw deserialization_failure(
+      std::string("camera quad #")
+      +std::to_string(e)
+      +" bottom left node is not a Linear List"
+    );
+
+  if (bl_node->elements.size() < 2)
+    throw deserialization_failure(
+      std::string("camera quad #")
+      +std::to_string(e)
+      +" bottom left node has insufficient element count (expected at least 2)"
+    );
+
+  try {
+    camera.set_bottom_left_angle(deser_int(bl_node->elements[0]));
+  } catch (deserialization_failure &de) {
+    throw deserialization_failure(
+      std::string("failed to deserialize camera quad #")
+      +std::to_string(e)
+      +" bottom left angle: "
+      +de.what()
+    );
+  }
+
+  try {
+    camera.set_bottom_left_radius(deser_float(bl_node->elements[1]));
+  } catch (deserialization_failure &de) {
+    throw deserialization_failure(
+      std::string("failed to deserialize camera quad #")
+      +std::to_string(e)
+      +" bottom left radius: "
+      +de.what()
+    );
+  }
+
+  return camera;
 }
 
 /// @brief deserializes the cameras with their quads.
-void deser_cameras(const mp::Node *node, std::vector<LevelCamera> &cameras) {
-  const mp::Props *prop_list = dynamic_cast<const mp::Props *>(node);
+void deser_cameras(const mp::Node *node, std::vector<LevelCamera> &cameras, Diagnostics *diagnostics) {
+  const mp::Props *prop_list = mp::node_cast<mp::Props>(node);
 
   if (prop_list == nullptr)
     throw deserialization_failure("node is not a Property List");
 
-  auto cameras_node = prop_list->map.find("cameras");
+  auto cameras_node = prop_list->map.find(mp::keys::cameras);
 
   if (cameras_node == prop_list->map.end())
     throw deserialization_failure("#cameras not found");
 
-  auto *cameras_list = dynamic_cast<mp::List *>(cameras_node->second.get());
+  auto *cameras_list = mp::node_cast<mp::List>(cameras_node->second);
 
   if (cameras_list == nullptr)
     throw deserialization_failure("#cameras is not a Linear List");
 
-  auto quads_node = prop_list->map.find("quads");
-  
+  auto quads_node = prop_list->map.find(mp::keys::quads);
+
   if (quads_node == prop_list->map.end())
     throw deserialization_failure("#quads not found");
 
-  auto *quads_list = dynamic_cast<mp::List *>(quads_node->second.get());
+  auto *quads_list = mp::node_cast<mp::List>(quads_node->second);
+
+  if (quads_list == nullptr)
+    throw deserialization_failure("#quads is not a Linear List");
 
   if (cameras_list->elements.size() != quads_list->elements.size())
     throw deserialization_failure("#cameras and #quads mismatch (unequal element size)");
@@ -756,202 +1032,29 @@ void deser_cameras(const mp::Node *node, std::vector<LevelCamera> &cameras) {
   _cameras.reserve(cameras_list->elements.size());
 
   for (size_t e = 0; e < cameras_list->elements.size(); e++) {
-    const mp::Node *camera_node = cameras_list->elements[e].get();
-    const mp::Node *quad_node = quads_list->elements[e].get();
-
-    LevelCamera camera;
-    Vector2 position;
-
-    try {
-      deser_point(camera_node, position.x, position.y);
-      camera.set_position(position);
-    } catch (deserialization_failure &de) {
-      throw deserialization_failure(
-        std::string("failed to deserialize camera position at element #")
-        +std::to_string(e)
-        +": "
-        +de.what()
-      );
-    }
-
-    // Quads
-
-    const mp::List *quad_points_node = dynamic_cast<const mp::List*>(quad_node);
-    if (quad_points_node == nullptr) 
-      throw deserialization_failure(
-        std::string("camera quad #")
-        +std::to_string(e)
-        +" is not a Linear List"
-      );
-
-    // Top left
-    const mp::List *tl_node = dynamic_cast<const mp::List*>(quad_points_node->elements[0].get());
-    if (tl_node == nullptr)
-      throw deserialization_failure(
-        std::string("camera quad #")
-        +std::to_string(e)
-        +" top left node is not a Linear List"
-      );
-
-    if (tl_node->elements.size() < 2)
-      throw deserialization_failure(
-        std::string("camera quad #")
-        +std::to_string(e)
-        +" top left node has insufficient element count (expected at least 2)"
-      );
-
-    try {
-      camera.set_top_left_angle(deser_int(tl_node->elements[0].get()));
-    } catch (deserialization_failure &de) {
-      throw deserialization_failure(
-        std::string("failed to deserialize camera quad #")
-        +std::to_string(e)
-        +" top left radius: "
-        +de.what()
-      );
-    }
-
-    try {
-      camera.set_top_left_radius(deser_float(tl_node->elements[1].get()));
-    } catch (deserialization_failure &de) {
-      throw deserialization_failure(
-        std::string("failed to deserialize camera quad #")
-        +std::to_string(e)
-        +" top left angle: "
-        +de.what()
-      );
-    }
-
-    // Top right
-    const mp::List *tr_node = dynamic_cast<const mp::List*>(quad_points_node->elements[1].get());
-    if (tr_node == nullptr)
-      throw deserialization_failure(
-        std::string("camera quad #")
-        +std::to_string(e)
-        +" top left right is not a Linear List"
-      );
-
-    if (tr_node->elements.size() < 2)
-      throw deserialization_failure(
-        std::string("camera quad #")
-        +std::to_string(e)
-        +" top right node has insufficient element count (expected at least 2)"
-      );
-
-    try {
-      camera.set_top_right_angle(deser_int(tr_node->elements[0].get()));
-    } catch (deserialization_failure &de) {
-      throw deserialization_failure(
-        std::string("failed to deserialize camera quad #")
-        +std::to_string(e)
-        +" top right angle: "
-        +de.what()
-      );
-    }
-
-    try {
-      camera.set_top_right_radius(deser_float(tr_node->elements[1].get()));
-    } catch (deserialization_failure &de) {
-      throw deserialization_failure(
-        std::string("failed to deserialize camera quad #")
-        +std::to_string(e)
-        +" top right radius: "
-        +de.what()
-      );
-    }
-
-    // Bottom right
-    const mp::List *br_node = dynamic_cast<const mp::List*>(quad_points_node->elements[2].get());
-    if (br_node == nullptr)
-      throw deserialization_failure(
-        std::string("camera quad #")
-        +std::to_string(e)
-        +" bottom right node is not a Linear List"
-      );
-
-    if (br_node->elements.size() < 2)
-      throw deserialization_failure(
-        std::string("camera quad #")
-        +std::to_string(e)
-        +" bottom right node has insufficient element count (expected at least 2)"
-      );
-
-    try {
-      camera.set_bottom_right_angle(deser_int(br_node->elements[0].get()));
-    } catch (deserialization_failure &de) {
-      throw deserialization_failure(
-        std::string("failed to deserialize camera quad #")
-        +std::to_string(e)
-        +" bottom right angle: "
-        +de.what()
-      );
-    }
-
+    // A malformed camera is dropped in lenient mode.
     try {
-      camera.set_bottom_right_radius(deser_float(br_node->elements[1].get()));
+      _cameras.push_back(deser_camera(cameras_list->elements[e], quads_list->elements[e], e));
     } catch (deserialization_failure &de) {
-      throw deserialization_failure(
-        std::string("failed to deserialize camera quad #")
-        +std::to_string(e)
-        +" bottom right radius: "
-        +de.what()
-      );
-    }
-
-    // Bottom left
-    const mp::List *bl_node = dynamic_cast<const mp::List*>(quad_points_node->elements[3].get());
-    if (bl_node == nullptr)
-      throw deserialization_failure(
-        std::string("camera quad #")
-        +std::to_string(e)
-        +" bottom left node is not a Linear List"
-      );
-
-    if (bl_node->elements.size() < 2)
-      throw deserialization_failure(
-        std::string("camera quad #")
-        +std::to_string(e)
-        +" bottom left node has insufficient element count (expected at least 2)"
-      );
+      if (diagnostics == nullptr) throw;
 
-    try {
-      camera.set_bottom_left_angle(deser_int(bl_node->elements[0].get()));
-    } catch (deserialization_failure &de) {
-      throw deserialization_failure(
-        std::string("failed to deserialize camera quad #")
-        +std::to_string(e)
-        +" bottom left angle: "
-        +de.what()
-      );
+      diagnostics->report("cameras", static_cast<int>(e), -1, -1, de.what());
     }
-
-    try {
-      camera.set_bottom_left_radius(deser_float(bl_node->elements[1].get()));
-    } catch (deserialization_failure &de) {
-      throw deserialization_failure(
-        std::string("failed to deserialize camera quad #")
-        +std::to_string(e)
-        +" bottom left radius: "
-        +de.what()
-      );
-    }
-
-    _cameras.push_back(camera);
   }
 
   cameras = std::move(_cameras);
 }
 
 void deser_size(const mp::Node *line_node, uint16_t &width, uint16_t &height) {
-  const mp::Props *props = dynamic_cast<const mp::Props *>(line_node);
+  const mp::Props *props = mp::node_cast<mp::Props>(line_node);
 
   if (props == nullptr) {
     throw deserialization_failure("sizes line is not a property list");
   }
 
-  auto size_node = props->map.at("size").get();
+  auto size_node = props->map.at(mp::keys::size);
 
-  auto *size_gcall = dynamic_cast<mp::GCall *>(size_node);
+  auto *size_gcall = mp::node_cast<mp::GCall>(size_node);
 
   if (size_gcall == nullptr) {
     throw deserialization_failure("size node is not a global call");
@@ -962,11 +1065,11 @@ void deser_size(const mp::Node *line_node, uint16_t &width, uint16_t &height) {
         "size global call has insufficient arguments (expected at least 2)");
   }
 
-  auto parsed_width = size_gcall->args[0].get();
-  auto parsed_height = size_gcall->args[1].get();
+  auto parsed_width = size_gcall->args[0];
+  auto parsed_height = size_gcall->args[1];
 
-  auto *width_int = dynamic_cast<mp::Int *>(parsed_width);
-  auto *height_int = dynamic_cast<mp::Int *>(parsed_height);
+  auto *width_int = mp::node_cast<mp::Int>(parsed_width);
+  auto *height_int = mp::node_cast<mp::Int>(parsed_height);
 
   if (width_int == nullptr) {
     throw deserialization_failure(
@@ -983,19 +1086,19 @@ void deser_size(const mp::Node *line_node, uint16_t &width, uint16_t &height) {
 }
 
 void deser_buffer_geos(const mp::Node *line_node, BufferGeos &geos) {
-  const mp::Props *props = dynamic_cast<const mp::Props*>(line_node);
-  if (props == nullptr) 
+  const mp::Props *props = mp::node_cast<mp::Props>(line_node);
+  if (props == nullptr)
     throw deserialization_failure("line node is not a Property List");
 
-  const auto extra_iter = props->map.find("extratiles");
+  const auto extra_iter = props->map.find(mp::keys::extratiles);
   if (extra_iter == props->map.end())
     throw deserialization_failure("#extraTiles property not found");
-  
-  const auto *node = extra_iter->second.get(); 
 
-  const mp::List *list = dynamic_cast<const mp::List*>(node);
+  const auto *node = extra_iter->second;
+
+  const mp::List *list = mp::node_cast<mp::List>(node);
 
-  if (list == nullptr) 
+  if (list == nullptr)
     throw deserialization_failure("node is not a Linear List");
 
   if (list->elements.size() < 4)
@@ -1004,7 +1107,7 @@ void deser_buffer_geos(const mp::Node *line_node, BufferGeos &geos) {
   BufferGeos bg;
 
   try {
-    bg.left = deser_uint16(list->elements[0].get());
+    bg.left = deser_uint16(list->elements[0]);
   } catch (deserialization_failure &de) {
     throw deserialization_failure(
       std::string("failed to deserialize extra tiles #1 element (left): ")+de.what()
@@ -1012,7 +1115,7 @@ void deser_buffer_geos(const mp::Node *line_node, BufferGeos &geos) {
   }
 
   try {
-    bg.top = deser_uint16(list->elements[1].get());
+    bg.top = deser_uint16(list->elements[1]);
   } catch (deserialization_failure &de) {
     throw deserialization_failure(
       std::string("failed to deserialize extra tiles #2 element (top): ")+de.what()
@@ -1020,7 +1123,7 @@ void deser_buffer_geos(const mp::Node *line_node, BufferGeos &geos) {
   }
 
   try {
-    bg.right = deser_uint16(list->elements[2].get());
+    bg.right = deser_uint16(list->elements[2]);
   } catch (deserialization_failure &de) {
     throw deserialization_failure(
       std::string("failed to deserialize extra tiles #3 element (right): ")+de.what()
@@ -1028,7 +1131,7 @@ void deser_buffer_geos(const mp::Node *line_node, BufferGeos &geos) {
   }
 
   try {
-    bg.bottom = deser_uint16(list->elements[3].get());
+    bg.bottom = deser_uint16(list->elements[3]);
   } catch (deserialization_failure &de) {
     throw deserialization_failure(
       std::string("failed to deserialize extra tiles #4 element (bottom): ")+de.what()
@@ -1039,15 +1142,15 @@ void deser_buffer_geos(const mp::Node *line_node, BufferGeos &geos) {
 }
 
 void deser_seed(const mp::Node *line_node, int &seed) {
-  const mp::Props *props = dynamic_cast<const mp::Props*>(line_node);
-  if (props == nullptr) 
+  const mp::Props *props = mp::node_cast<mp::Props>(line_node);
+  if (props == nullptr)
     throw deserialization_failure("line node is not a Property List");
 
-  const auto seed_iter = props->map.find("tileseed");
+  const auto seed_iter = props->map.find(mp::keys::tileseed);
   if (seed_iter == props->map.end())
     throw deserialization_failure("#tileSeed property not found");
-  
-  const auto *node = seed_iter->second.get(); 
+
+  const auto *node = seed_iter->second;
 
   try {
     seed = deser_int(node);
@@ -1059,23 +1162,23 @@ void deser_seed(const mp::Node *line_node, int &seed) {
 }
 
 void deser_water(const mp::Node *line_node, int &level, bool &in_front) {
-  const mp::Props *props = dynamic_cast<const mp::Props*>(line_node);
-  if (props == nullptr) 
+  const mp::Props *props = mp::node_cast<mp::Props>(line_node);
+  if (props == nullptr)
     throw deserialization_failure("line node is not a Property List");
 
-  const auto level_iter = props->map.find("waterlevel");
+  const auto level_iter = props->map.find(mp::keys::waterlevel);
   if (level_iter == props->map.end())
     throw deserialization_failure("#waterLevel property not found");
-  
-  const auto infront_iter = props->map.find("waterinfront");
+
+  const auto infront_iter = props->map.find(mp::keys::waterinfront);
   if (infront_iter == props->map.end())
     throw deserialization_failure("#waterInFront property not found");
-  
+
   int level_v;
   bool infront_v;
 
   try {
-    level_v = deser_int(level_iter->second.get());
+    level_v = deser_int(level_iter->second);
   } catch (deserialization_failure &de) {
     throw deserialization_failure(
       std::string("failed to deserialize #waterLevel property: ")+de.what()
@@ -1083,7 +1186,7 @@ void deser_water(const mp::Node *line_node, int &level, bool &in_front) {
   }
 
   try {
-    infront_v = deser_bool(infront_iter->second.get());
+    infront_v = deser_bool(infront_iter->second);
   } catch (deserialization_failure &de) {
     throw deserialization_failure(
       std::string("failed to deserialize #waterInFront property: ")+de.what()
@@ -1095,16 +1198,16 @@ void deser_water(const mp::Node *line_node, int &level, bool &in_front) {
 }
 
 void deser_light(const mp::Node *line_node, bool &light) {
-  const mp::Props *props = dynamic_cast<const mp::Props*>(line_node);
-  if (props == nullptr) 
+  const mp::Props *props = mp::node_cast<mp::Props>(line_node);
+  if (props == nullptr)
     throw deserialization_failure("line node is not a Property List");
 
-  const auto light_iter = props->map.find("light");
+  const auto light_iter = props->map.find(mp::keys::light);
   if (light_iter == props->map.end())
     throw deserialization_failure("#light property not found");
-  
+
   try {
-    light = deser_bool(light_iter->second.get());
+    light = deser_bool(light_iter->second);
   } catch (deserialization_failure &de) {
     throw deserialization_failure(
       std::string("failed to deserialize #light property: ")+de.what()
@@ -1112,153 +1215,426 @@ void deser_light(const mp::Node *line_node, bool &light) {
   }
 }
 
+void deser_light_settings(const mp::Node *line_node, int &angle, int &flatness) {
+  const mp::Props *props = mp::node_cast<mp::Props>(line_node);
+  if (props == nullptr)
+    throw deserialization_failure("line node is not a Property List");
+
+  static const mp::symbol lightangle = mp::intern("lightangle");
+  static const mp::symbol flatness_key = mp::intern("flatness");
+
+  // Older projects may lack either property; those keep the defaults.
+
+  const auto angle_iter = props->map.find(lightangle);
+  if (angle_iter != props->map.end()) {
+    try {
+      angle = deser_int(angle_iter->second);
+    } catch (deserialization_failure &de) {
+      throw deserialization_failure(std::string("failed to deserialize #lightAngle property: ")+de.what());
+    }
+  }
+
+  const auto flatness_iter = props->map.find(flatness_key);
+  if (flatness_iter != props->map.end()) {
+    try {
+      flatness = deser_int(flatness_iter->second);
+    } catch (deserialization_failure &de) {
+      throw deserialization_failure(std::string("failed to deserialize #flatness property: ")+de.what());
+    }
+  }
+}
+
 void deser_terrain_medium(const mp::Node *line_node, bool &setting) {
-  const mp::Props *props = dynamic_cast<const mp::Props*>(line_node);
-  if (props == nullptr) 
+  const mp::Props *props = mp::node_cast<mp::Props>(line_node);
+  if (props == nullptr)
     throw deserialization_failure("line node is not a Property List");
 
-  const auto terr_iter = props->map.find("defaultterrain");
+  const auto terr_iter = props->map.find(mp::keys::defaultterrain);
   if (terr_iter == props->map.end())
     throw deserialization_failure("#defaultTerrain property not found");
-  
+
   try {
-    setting = deser_bool(terr_iter->second.get());
+    setting = deser_bool(terr_iter->second);
   } catch (deserialization_failure &de) {
     throw deserialization_failure(std::string("failed to deserialize #defaultTerrain property: ")+de.what());
   }
 }
 
-std::unique_ptr<Level> deser_level(const std::filesystem::path &path) {
-  std::unique_ptr<ProjectSaveFileNodes> nodes = parse_project(path);
+/// @brief Runs a deserializer that reads a line through mp::event_reader,
+/// reporting syntax errors the same way parse_project() does.
+template <typename Stage>
+static void stream_line(const char *name, Stage &&stage) {
+  try {
+    stage();
+  } catch (mp::parse_failure &e) {
+    throw parse_failure(std::string("failed to parse ")+name+": "+e.what());
+  } catch (mp::double_decimal_point &e) {
+    throw parse_failure(std::string("failed to parse ")+name+": "+e.what());
+  }
+}
 
-  uint16_t width, height;
+/// @brief Counts the elements of a linear list property without building
+/// any nodes.
+/// @return 0 if the property is missing.
+static size_t count_list_property(std::string_view line, std::string_view key) {
+  mp::event_reader reader(line);
 
-  deser_size(nodes->seed_and_sizes.get(), width, height);
+  if (reader.next().type != mp::event_type::begin_list) return 0;
+  if (!reader.seek_property(key)) return 0;
 
-  auto level = std::make_unique<Level>(width, height);
+  reader.expect(mp::event_type::begin_list);
 
-  level->set_path(path);
+  size_t count = 0;
 
-  // Geometry
+  while (reader.peek().type != mp::event_type::end_list) {
+    reader.skip();
+    count++;
+  }
+
+  return count;
+}
+
+LevelMetadata read_level_metadata(const std::filesystem::path &path) {
+  std::unique_ptr<ProjectSaveFileViews> views = map_project(path);
+
+  LevelMetadata metadata{0, 0, 0, 0, 0};
+
+  auto seed_and_sizes = parse_line(views->seed_and_sizes, "seed and sizes");
 
   try {
-    deser_geometry_matrix(nodes->geometry.get(), level->get_geo_matrix());
-  } catch (deserialization_failure &gde) {
+    deser_size(seed_and_sizes.get(), metadata.width, metadata.height);
+  } catch (std::out_of_range &) {
+    throw deserialization_failure("failed to deserialize size: #size not found");
+  } catch (deserialization_failure &de) {
     throw deserialization_failure(
-      std::string("failed to deserialize the geometry matrix: ")+gde.what()
+      std::string("failed to deserialize size: ")+de.what()
     );
   }
 
-  // Seed
-
   try {
-    deser_seed(nodes->seed_and_sizes.get(), level->seed);
+    deser_seed(seed_and_sizes.get(), metadata.seed);
   } catch (deserialization_failure &de) {
     throw deserialization_failure(
       std::string("failed to deserialize seed: ")+de.what()
     );
   }
 
-  // Light
+  stream_line("cameras", [&]() {
+    metadata.cameras = count_list_property(views->cameras, "cameras");
+  });
 
-  try {
-    deser_light(nodes->seed_and_sizes.get(), level->light);
-  } catch (deserialization_failure &de) {
-    throw deserialization_failure(
-      std::string("failed to deserialize light: ")+de.what()
-    );
+  stream_line("props", [&]() {
+    metadata.props = count_list_property(views->props, "props");
+  });
+
+  return metadata;
+}
+
+/// @brief Runs independent stages, the heavy ones on their own threads.
+/// @note Stages are joined in the order they were added, so the failure
+/// reported is the one a sequential run would have hit first.
+class stage_group {
+  std::vector<std::future<void>> _stages;
+  bool _parallel;
+
+public:
+  template <typename Stage>
+  void run(bool heavy, Stage &&stage) {
+    auto policy = _parallel && heavy
+      ? std::launch::async
+      : std::launch::deferred;
+
+    _stages.push_back(std::async(policy, std::forward<Stage>(stage)));
   }
 
+  void join() {
+    for (auto &stage : _stages) stage.get();
+    _stages.clear();
+  }
+
+  explicit stage_group(bool parallel)
+    : _parallel(parallel && std::thread::hardware_concurrency() > 1) {}
+};
+
+/// @brief Parses and deserializes a project file.
+/// @param diagnostics When given, problems are reported to it instead of
+/// thrown, as described by deser_level().
+static std::unique_ptr<Level> deser_level_project(const std::filesystem::path &path, Diagnostics *diagnostics) {
+  std::unique_ptr<ProjectSaveFileViews> views = map_project(path);
+
+  // The geometry and tiles lines are streamed straight into
+  // the matrices below, without building syntax trees.
+  std::unique_ptr<ProjectSaveFileNodes> nodes = parse_project(*views, false, true);
+
+  uint16_t width, height;
+
+  deser_size(nodes->seed_and_sizes.get(), width, height);
+
+  auto level = std::make_unique<Level>(width, height);
+
+  level->set_path(path);
+
+  // In lenient mode every stage reports to its own collector, since they
+  // run concurrently; the collectors are appended in stage order.
+  constexpr size_t stage_count = 11;
+
+  std::vector<Diagnostics> stage_diagnostics(diagnostics != nullptr ? stage_count : 0);
+  size_t next_stage = 0;
+
+  // Returns the next stage's collector, or nullptr in strict mode.
+  auto collector = [&]() -> Diagnostics* {
+    return diagnostics != nullptr ? &stage_diagnostics.at(next_stage++) : nullptr;
+  };
+
+  // Throws in strict mode; otherwise reports, and the level keeps
+  // its default for whatever the stage failed to set.
+  auto fail = [](Diagnostics *diag, const char *part, std::string message) {
+    if (diag == nullptr) throw deserialization_failure(message);
+    diag->report(part, std::move(message));
+  };
+
+  // Every stage writes a different part of the level.
+  // Declared after the level so that the stages still
+  // running when one fails are joined before it's freed.
+  stage_group stages(true);
+
+  // Geometry
+
+  stages.run(true, [&, diag = collector()]() {
+    try {
+      stream_line("geometry", [&]() {
+        mp::event_reader reader(views->geometry);
+        deser_geometry_matrix(reader, level->get_geo_matrix(), diag);
+      });
+    } catch (deserialization_failure &gde) {
+      fail(diag, "geometry", std::string("failed to deserialize the geometry matrix: ")+gde.what());
+    }
+  });
+
+  // Seed
+
+  stages.run(false, [&, diag = collector()]() {
+    try {
+      deser_seed(nodes->seed_and_sizes.get(), level->seed);
+    } catch (deserialization_failure &de) {
+      fail(diag, "seed", std::string("failed to deserialize seed: ")+de.what());
+    }
+  });
+
+  // Light
+
+  stages.run(false, [&, diag = collector()]() {
+    try {
+      deser_light(nodes->seed_and_sizes.get(), level->light);
+    } catch (deserialization_failure &de) {
+      fail(diag, "light", std::string("failed to deserialize light: ")+de.what());
+    }
+  });
+
+  // Light angle and flatness
+
+  stages.run(false, [&, diag = collector()]() {
+    try {
+      deser_light_settings(nodes->light_settings.get(), level->light_angle, level->light_flatness);
+    } catch (deserialization_failure &de) {
+      fail(diag, "light settings", std::string("failed to deserialize light settings: ")+de.what());
+    }
+  });
+
   // Terrain
 
-  try {
-    deser_terrain_medium(nodes->terrain_settings.get(), level->terrain);
-  } catch (deserialization_failure &de) {
-    throw deserialization_failure(
-      std::string("failed to deserialize default terrain: ")+de.what()
-    );
-  } 
+  stages.run(false, [&, diag = collector()]() {
+    try {
+      deser_terrain_medium(nodes->terrain_settings.get(), level->terrain);
+    } catch (deserialization_failure &de) {
+      fail(diag, "terrain", std::string("failed to deserialize default terrain: ")+de.what());
+    }
+  });
 
   // Extra geometry tiles
 
-  try {
-    deser_buffer_geos(nodes->seed_and_sizes.get(), level->buffer_geos);
-  } catch (deserialization_failure &de) {
-    throw deserialization_failure(
-      std::string("failed to deserialize extra tiles: ")+de.what()
-    );
-  }
+  stages.run(false, [&, diag = collector()]() {
+    try {
+      deser_buffer_geos(nodes->seed_and_sizes.get(), level->buffer_geos);
+    } catch (deserialization_failure &de) {
+      fail(diag, "extra tiles", std::string("failed to deserialize extra tiles: ")+de.what());
+    }
+  });
 
   // Tiles
-  
-  const mp::Props* tile_proplist = dynamic_cast<const mp::Props*>(nodes->tiles.get());
-  if (tile_proplist == nullptr) 
-    throw deserialization_failure("failed to deserialize the tile matrix: top-level node is not a Property list");
-  
-  const auto tile_matrix_iter = tile_proplist->map.find("tlmatrix");
-  if (tile_matrix_iter == tile_proplist->map.end())
-    throw deserialization_failure("failed to deserialize the tile matrix: #tlMatrix not found");
 
-  try {
-    deser_tile_matrix(tile_matrix_iter->second.get(), level->get_tile_matrix());
-  } catch (deserialization_failure &mde) {
-    throw deserialization_failure(
-      std::string("failed to deserialize the tile matrix: ")+mde.what()
-    );
-  }
+  stages.run(true, [&, diag = collector()]() {
+    try {
+      stream_line("tiles", [&]() {
+        mp::event_reader reader(views->tiles);
+
+        bool found_matrix = false, found_material = false;
+
+        if (reader.next().type != mp::event_type::begin_list)
+          throw deserialization_failure("failed to deserialize the tile matrix: top-level node is not a Property list");
+
+        while (reader.peek().type == mp::event_type::property) {
+          const auto key = reader.next();
+
+          if (key.is("tlmatrix")) {
+            try {
+              deser_tile_matrix(reader, level->get_tile_matrix(), diag);
+            } catch (deserialization_failure &mde) {
+              throw deserialization_failure(
+                std::string("failed to deserialize the tile matrix: ")+mde.what()
+              );
+            }
+
+            found_matrix = true;
+          } else if (key.is("defaultmaterial")) {
+            try {
+              level->default_material = deser_string(reader);
+            } catch (deserialization_failure &de) {
+              throw deserialization_failure(
+                std::string("failed to deserialize default material: failed to deserialize property #defaultMaterial: ")+de.what()
+              );
+            }
+
+            found_material = true;
+          } else {
+            reader.skip();
+          }
+        }
+
+        if (reader.next().type != mp::event_type::end_list)
+          throw deserialization_failure("failed to deserialize the tile matrix: top-level node is not a Property list");
+
+        if (!found_matrix)
+          fail(diag, "tiles", "failed to deserialize the tile matrix: #tlMatrix not found");
+
+        if (!found_material)
+          fail(diag, "tiles", "failed to deserialize default material: #defaultMaterial not found");
+      });
+    } catch (deserialization_failure &de) {
+      // The rest of the line can't be read past a failure.
+      fail(diag, "tiles", de.what());
+    }
+  });
 
-  // Default material
+  // Effects
 
-  try {
-    level->default_material = deser_default_material(nodes->tiles.get());
-  } catch (deserialization_failure &de) {
-    throw deserialization_failure(std::string("failed to deserialize default material: ")+de.what());
-  }
+  stages.run(true, [&, diag = collector()]() {
+    // A blank effects line leaves the level without effects.
+    if (views->effects.empty()) return;
+
+    try {
+      stream_line("effects", [&]() {
+        mp::event_reader reader(views->effects);
+        deser_effects(reader, level->get_effects(), level->get_width(), level->get_height(), diag);
+      });
+    } catch (deserialization_failure &de) {
+      fail(diag, "effects", std::string("failed to deserialize effects: ")+de.what());
+    }
+  });
 
   // Cameras
 
-  try {
-    deser_cameras(nodes->cameras.get(), level->cameras);
-  } catch (deserialization_failure &de) {
-    throw deserialization_failure(
-      std::string("failed to deserialize cameras: ")
-      +de.what()
-    );
-  }
+  stages.run(false, [&, diag = collector()]() {
+    try {
+      deser_cameras(nodes->cameras.get(), level->cameras, diag);
+    } catch (deserialization_failure &de) {
+      fail(diag, "cameras", std::string("failed to deserialize cameras: ")+de.what());
+    }
+  });
 
   // Water
 
-  try {
-    deser_water(nodes->water.get(), level->water, level->front_water);
-  } catch (deserialization_failure &de) {
-    throw deserialization_failure(
-      std::string("failed to deserialize water: ")+de.what()
-    );
-  }
+  stages.run(false, [&, diag = collector()]() {
+    try {
+      deser_water(nodes->water.get(), level->water, level->front_water);
+    } catch (deserialization_failure &de) {
+      fail(diag, "water", std::string("failed to deserialize water: ")+de.what());
+    }
+  });
 
   // Props
 
-  // I know that props some times are not included in the project file, 
+  // I know that props some times are not included in the project file,
   // but I don't care.
 
-  const mp::Props* props_line_node = dynamic_cast<const mp::Props*>(nodes->props.get());
-  if (props_line_node == nullptr) throw deserialization_failure(
-    "failed to parse props: props line is not a Property List*"
-  );
+  stages.run(true, [&, diag = collector()]() {
+    const mp::Props* props_line_node = mp::node_cast<mp::Props>(nodes->props.get());
+    if (props_line_node == nullptr) {
+      fail(diag, "props", "failed to parse props: props line is not a Property List*");
+      return;
+    }
 
-  auto props_iter = props_line_node->map.find("props");
-  if (props_iter == props_line_node->map.end()) throw deserialization_failure(
-    "failed to parse props: #props not found"
-  );
+    auto props_iter = props_line_node->map.find(mp::keys::props);
+    if (props_iter == props_line_node->map.end()) {
+      fail(diag, "props", "failed to parse props: #props not found");
+      return;
+    }
+
+    try {
+      deser_props(props_iter->second, level->props, diag);
+    } catch (deserialization_failure &de) {
+      fail(diag, "props", std::string("failed to deserialize props: ")+de.what());
+    }
+  });
+
+  stages.join();
+
+  for (auto &stage : stage_diagnostics) diagnostics->append(std::move(stage));
+
+  return level;
+}
+
+std::unique_ptr<Level> deser_level(const std::filesystem::path &path, bool cache, Diagnostics *diagnostics) {
+  if (!cache) return deser_level_project(path, diagnostics);
+
+  // Taken before parsing, so that a project modified in the meantime
+  // does not match the cache written below.
+  FileKey key;
 
   try {
-    deser_props(props_iter->second.get(), level->props);
-  } catch (deserialization_failure &de) {
-    throw deserialization_failure(
-      std::string("failed to deserialize props: ")+de.what()
-    );
+    key = file_key(path);
+  } catch (std::exception &) {
+    // Let parsing report the problem with the file.
+    return deser_level_project(path, diagnostics);
   }
 
+  auto level = read_level_cache(path, key);
+  if (level != nullptr) return level;
+
+  const size_t reported = diagnostics != nullptr ? diagnostics->size() : 0;
+
+  level = deser_level_project(path, diagnostics);
+
+  // Only levels read without problems are cached, so that a malformed
+  // project keeps failing strictly and keeps being reported.
+  if (diagnostics != nullptr && diagnostics->size() != reported) return level;
+
+  // The cache is only an optimization; the level was read either way.
+  try {
+    write_level_cache(*level, path, key);
+  } catch (serialization_failure &) {}
+
+  return level;
+}
+
+std::unique_ptr<Level> deser_level(
+  const std::filesystem::path &path,
+  const PropDex *propdex,
+  Diagnostics *diagnostics
+) {
+  auto level = deser_level(path, true, diagnostics);
+
+  // The tile matrix and the prop list are defined independently.
+  stage_group stages(true);
+
+  stages.run(true, [&]() {
+    define_tile_matrix(level->get_tile_matrix());
+  });
+
+  stages.run(true, [&]() { define_prop_list(level->props, propdex); });
+
+  stages.join();
+
   return level;
 }
 
@@ -0,0 +1,741 @@
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <raylib.h>
+
+#include <MobitParser/exceptions.h>
+#include <MobitParser/mapping.h>
+
+#include <MobitRenderer/castlibs.h>
+#include <MobitRenderer/definitions.h>
+#include <MobitRenderer/dex.h>
+#include <MobitRenderer/exceptions.h>
+#include <MobitRenderer/serialization.h>
+
+namespace mr::serde {
+
+// A snapshot is a byte stream of the dexes' categories and definitions in
+// registration order, written in native byte order. Bump the version
+// whenever a definition gains or loses a field.
+//
+// Texture paths are not kept: a definition only records the directory
+// of its Init file, and its texture is resolved again when restored.
+
+static constexpr char snapshot_magic[4] = { 'M', 'R', 'D', 'S' };
+static constexpr uint32_t snapshot_version = 2;
+static constexpr uint32_t snapshot_byte_order = 0x01020304;
+
+enum class snapshot_record : uint8_t { category, definition };
+
+class snapshot_writer {
+public:
+  std::string bytes;
+
+  template <typename T>
+  void put(T value) {
+    static_assert(std::is_trivially_copyable<T>::value, "only plain values are written as is");
+    bytes.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  void put(const std::string &str) {
+    put(static_cast<uint32_t>(str.size()));
+    bytes.append(str);
+  }
+
+  void put(const std::filesystem::path &path) { put(path.u8string()); }
+
+  void put(const std::vector<int> &ints) {
+    put(static_cast<uint32_t>(ints.size()));
+    for (int i : ints) put(static_cast<int32_t>(i));
+  }
+
+  void put(const std::unordered_set<std::string> &strs) {
+    put(static_cast<uint32_t>(strs.size()));
+    for (const auto &str : strs) put(str);
+  }
+};
+
+/// @brief Thrown when a snapshot ends early or holds an invalid value.
+struct snapshot_mismatch {};
+
+class snapshot_reader {
+  const char *_cursor;
+  const char *_end;
+
+public:
+  void read(void *destination, size_t size) {
+    if (static_cast<size_t>(_end - _cursor) < size) throw snapshot_mismatch{};
+
+    std::memcpy(destination, _cursor, size);
+    _cursor += size;
+  }
+
+  template <typename T>
+  T get() {
+    static_assert(std::is_trivially_copyable<T>::value, "only plain values are read as is");
+
+    T value;
+    read(&value, sizeof(T));
+    return value;
+  }
+
+  std::string get_string() {
+    auto size = get<uint32_t>();
+    if (static_cast<size_t>(_end - _cursor) < size) throw snapshot_mismatch{};
+
+    std::string str(_cursor, size);
+    _cursor += size;
+    return str;
+  }
+
+  std::filesystem::path get_path() { return std::filesystem::u8path(get_string()); }
+
+  std::vector<int> get_ints() {
+    auto count = get<uint32_t>();
+    if (static_cast<size_t>(_end - _cursor) / sizeof(int32_t) < count) throw snapshot_mismatch{};
+
+    std::vector<int> ints;
+    ints.reserve(count);
+    for (uint32_t i = 0; i < count; i++) ints.push_back(get<int32_t>());
+    return ints;
+  }
+
+  std::unordered_set<std::string> get_strings() {
+    auto count = get<uint32_t>();
+
+    std::unordered_set<std::string> strs;
+    for (uint32_t i = 0; i < count; i++) strs.insert(get_string());
+    return strs;
+  }
+
+  bool at_end() const noexcept { return _cursor == _end; }
+
+  snapshot_reader(const char *begin, const char *end) : _cursor(begin), _end(end) {}
+};
+
+// Tiles
+
+static void put_tiledef(snapshot_writer &out, const TileDef *def) {
+  out.put(def->get_name());
+  out.put(static_cast<uint8_t>(def->get_type()));
+  out.put(static_cast<int32_t>(def->get_width()));
+  out.put(static_cast<int32_t>(def->get_height()));
+  out.put(static_cast<int32_t>(def->get_buffer()));
+  out.put(static_cast<int32_t>(def->get_rnd()));
+  out.put(def->get_tags());
+  out.put(def->get_specs());
+  out.put(def->get_specs2());
+  out.put(def->get_specs3());
+  out.put(def->get_repeat());
+  out.put(def->get_tag_set().has(tags::internal) ? std::filesystem::path() : def->get_texture_path().parent_path());
+}
+
+static std::unique_ptr<TileDef> get_tiledef(snapshot_reader &in) {
+  auto name = in.get_string();
+  auto type = in.get<uint8_t>();
+  if (type > TileDefType::voxel_struct_sand_type) throw snapshot_mismatch{};
+
+  int width  = in.get<int32_t>();
+  int height = in.get<int32_t>();
+  int buffer = in.get<int32_t>();
+  int rnd    = in.get<int32_t>();
+
+  auto tags   = in.get_strings();
+  auto specs  = in.get_ints();
+  auto specs2 = in.get_ints();
+  auto specs3 = in.get_ints();
+  auto repeat = in.get_ints();
+
+  auto def = std::make_unique<TileDef>(
+    std::move(name), static_cast<TileDefType>(type), width, height, buffer, rnd,
+    std::move(tags), std::move(specs), std::move(specs2), std::move(specs3), std::move(repeat)
+  );
+
+  // The texture directory, resolved by resolve_textures().
+  def->set_texture_path(in.get_path());
+  return def;
+}
+
+// Props
+
+static void put_propdef(snapshot_writer &out, const PropDef *def) {
+  out.put(static_cast<uint8_t>(def->type));
+  out.put(static_cast<int32_t>(def->depth));
+  out.put(def->name);
+  out.put(def->tags);
+
+  switch (def->type) {
+  case PropType::standard: {
+    auto *p = static_cast<const Standard*>(def);
+    out.put<int32_t>(p->width);
+    out.put<int32_t>(p->height);
+    out.put(p->repeat);
+    out.put(static_cast<uint8_t>(p->color_treatment));
+    out.put<int32_t>(p->bevel);
+  } break;
+
+  case PropType::varied_standard: {
+    auto *p = static_cast<const VariedStandard*>(def);
+    out.put<int32_t>(p->width);
+    out.put<int32_t>(p->height);
+    out.put(p->repeat);
+    out.put<int32_t>(p->variations);
+    out.put<uint8_t>(p->random);
+    out.put(static_cast<uint8_t>(p->color_treatment));
+    out.put<uint8_t>(p->colorize);
+    out.put<int32_t>(p->bevel);
+  } break;
+
+  case PropType::soft: {
+    auto *p = static_cast<const Soft*>(def);
+    out.put<int32_t>(p->smooth_shading);
+    out.put(p->contour_exp);
+    out.put(p->highlight_border);
+    out.put(p->depth_affect_hilites);
+    out.put(p->shadow_border);
+    out.put<uint8_t>(p->round);
+    out.put<uint8_t>(p->self_shade);
+  } break;
+
+  case PropType::varied_soft: {
+    auto *p = static_cast<const VariedSoft*>(def);
+    out.put<int32_t>(p->pixel_width);
+    out.put<int32_t>(p->pixel_height);
+    out.put<int32_t>(p->variations);
+    out.put<uint8_t>(p->random);
+    out.put<uint8_t>(p->colorize);
+    out.put<int32_t>(p->smooth_shading);
+    out.put(p->contour_exp);
+    out.put(p->highlight_border);
+    out.put(p->depth_affect_hilites);
+    out.put(p->shadow_border);
+    out.put<uint8_t>(p->round);
+    out.put<uint8_t>(p->self_shade);
+  } break;
+
+  case PropType::colored_soft: {
+    auto *p = static_cast<const ColoredSoft*>(def);
+    out.put<int32_t>(p->pixel_width);
+    out.put<int32_t>(p->pixel_height);
+    out.put<uint8_t>(p->colorize);
+    out.put<int32_t>(p->smooth_shading);
+    out.put(p->contour_exp);
+    out.put(p->highlight_border);
+    out.put(p->depth_affect_hilites);
+    out.put(p->shadow_border);
+    out.put<uint8_t>(p->round);
+    out.put<uint8_t>(p->self_shade);
+  } break;
+
+  case PropType::varied_decal: {
+    auto *p = static_cast<const VariedDecal*>(def);
+    out.put<int32_t>(p->pixel_width);
+    out.put<int32_t>(p->pixel_height);
+    out.put<int32_t>(p->variations);
+    out.put<uint8_t>(p->random);
+  } break;
+
+  case PropType::rope: {
+    auto *p = static_cast<const Rope*>(def);
+    out.put<int32_t>(p->segment_length);
+    out.put<int32_t>(p->collision_depth);
+    out.put(p->segment_radius);
+    out.put(p->gravity);
+    out.put(p->friction);
+    out.put(p->air_friction);
+    out.put<uint8_t>(p->stiff);
+    out.put(p->edge_direction);
+    out.put(p->rigid);
+    out.put(p->self_push);
+    out.put(p->source_push);
+  } break;
+
+  case PropType::antimatter: {
+    auto *p = static_cast<const Antimatter*>(def);
+    out.put(p->contour_exp);
+  } break;
+
+  // Decals, soft effects and long props have no fields of their own.
+  default: break;
+  }
+
+  out.put(def->tag_set.has(tags::internal) ? std::filesystem::path() : def->get_texture_path().parent_path());
+}
+
+static PropColorTreatment get_color_treatment(snapshot_reader &in) {
+  auto treatment = in.get<uint8_t>();
+  if (treatment > static_cast<uint8_t>(PropColorTreatment::bevel)) throw snapshot_mismatch{};
+  return static_cast<PropColorTreatment>(treatment);
+}
+
+static std::unique_ptr<PropDef> get_propdef(snapshot_reader &in) {
+  auto type = static_cast<PropType>(in.get<uint8_t>());
+  int depth = in.get<int32_t>();
+  auto name = in.get_string();
+  auto tags = in.get_strings();
+
+  std::unique_ptr<PropDef> def;
+
+  switch (type) {
+  case PropType::standard: {
+    int width = in.get<int32_t>();
+    int height = in.get<int32_t>();
+    auto repeat = in.get_ints();
+    auto color_treatment = get_color_treatment(in);
+    int bevel = in.get<int32_t>();
+
+    def = std::make_unique<Standard>(
+      depth, std::move(name), std::move(tags),
+      width, height, std::move(repeat), color_treatment, bevel
+    );
+  } break;
+
+  case PropType::varied_standard: {
+    int width = in.get<int32_t>();
+    int height = in.get<int32_t>();
+    auto repeat = in.get_ints();
+    int variations = in.get<int32_t>();
+    bool random = in.get<uint8_t>() != 0;
+    auto color_treatment = get_color_treatment(in);
+    bool colorize = in.get<uint8_t>() != 0;
+    int bevel = in.get<int32_t>();
+
+    def = std::make_unique<VariedStandard>(
+      depth, std::move(name), std::move(tags),
+      width, height, std::move(repeat), variations, random, color_treatment, colorize, bevel
+    );
+  } break;
+
+  case PropType::soft: {
+    int smooth_shading = in.get<int32_t>();
+    float contour_exp = in.get<float>();
+    float highlight_border = in.get<float>();
+    float depth_affect_hilites = in.get<float>();
+    float shadow_border = in.get<float>();
+    bool round = in.get<uint8_t>() != 0;
+    bool self_shade = in.get<uint8_t>() != 0;
+
+    def = std::make_unique<Soft>(
+      depth, std::move(name), std::move(tags),
+      smooth_shading, contour_exp, highlight_border, depth_affect_hilites, shadow_border, round, self_shade
+    );
+  } break;
+
+  case PropType::varied_soft: {
+    int pixel_width = in.get<int32_t>();
+    int pixel_height = in.get<int32_t>();
+    int variations = in.get<int32_t>();
+    bool random = in.get<uint8_t>() != 0;
+    bool colorize = in.get<uint8_t>() != 0;
+    int smooth_shading = in.get<int32_t>();
+    float contour_exp = in.get<float>();
+    float highlight_border = in.get<float>();
+    float depth_affect_hilites = in.get<float>();
+    float shadow_border = in.get<float>();
+    bool round = in.get<uint8_t>() != 0;
+    bool self_shade = in.get<uint8_t>() != 0;
+
+    def = std::make_unique<VariedSoft>(
+      depth, std::move(name), std::move(tags),
+      pixel_width, pixel_height, variations, random, colorize,
+      smooth_shading, contour_exp, highlight_border, depth_affect_hilites, shadow_border, round, self_shade
+    );
+  } break;
+
+  case PropType::colored_soft: {
+    int pixel_width = in.get<int32_t>();
+    int pixel_height = in.get<int32_t>();
+    bool colorize = in.get<uint8_t>() != 0;
+    int smooth_shading = in.get<int32_t>();
+    float contour_exp = in.get<float>();
+    float highlight_border = in.get<float>();
+    float depth_affect_hilites = in.get<float>();
+    float shadow_border = in.get<float>();
+    bool round = in.get<uint8_t>() != 0;
+    bool self_shade = in.get<uint8_t>() != 0;
+
+    def = std::make_unique<ColoredSoft>(
+      depth, std::move(name), std::move(tags),
+      pixel_width, pixel_height, colorize,
+      smooth_shading, contour_exp, highlight_border, depth_affect_hilites, shadow_border, round, self_shade
+    );
+  } break;
+
+  case PropType::soft_effect:
+    def = std::make_unique<SoftEffect>(depth, std::move(name), std::move(tags));
+    break;
+
+  case PropType::decal:
+    def = std::make_unique<Decal>(depth, std::move(name), std::move(tags));
+    break;
+
+  case PropType::varied_decal: {
+    int pixel_width = in.get<int32_t>();
+    int pixel_height = in.get<int32_t>();
+    int variations = in.get<int32_t>();
+    bool random = in.get<uint8_t>() != 0;
+
+    def = std::make_unique<VariedDecal>(
+      depth, std::move(name), std::move(tags),
+      pixel_width, pixel_height, variations, random
+    );
+  } break;
+
+  case PropType::_long:
+    def = std::make_unique<Long>(depth, std::move(name), std::move(tags));
+    break;
+
+  case PropType::rope: {
+    int segment_length = in.get<int32_t>();
+    int collision_depth = in.get<int32_t>();
+    float segment_radius = in.get<float>();
+    float gravity = in.get<float>();
+    float friction = in.get<float>();
+    float air_friction = in.get<float>();
+    bool stiff = in.get<uint8_t>() != 0;
+    float edge_direction = in.get<float>();
+    float rigid = in.get<float>();
+    float self_push = in.get<float>();
+    float source_push = in.get<float>();
+
+    def = std::make_unique<Rope>(
+      depth, std::move(name), std::move(tags),
+      segment_length, collision_depth, segment_radius, gravity, friction, air_friction,
+      stiff, edge_direction, rigid, self_push, source_push
+    );
+  } break;
+
+  case PropType::antimatter:
+    def = std::make_unique<Antimatter>(depth, std::move(name), std::move(tags), in.get<float>());
+    break;
+
+  default: throw snapshot_mismatch{};
+  }
+
+  // The texture directory, resolved by resolve_textures().
+  def->set_texture_path(in.get_path());
+  return def;
+}
+
+// Snapshot
+
+static void put_sources(
+  snapshot_writer &out,
+  const std::vector<std::filesystem::path> &paths,
+  const std::vector<FileKey> &keys
+) {
+  out.put(static_cast<uint32_t>(paths.size()));
+
+  for (size_t s = 0; s < paths.size(); s++) {
+    out.put(paths[s]);
+    out.put(keys[s]);
+  }
+}
+
+static bool same_sources(
+  snapshot_reader &in,
+  const std::vector<std::filesystem::path> &paths,
+  const std::vector<FileKey> &keys
+) {
+  if (in.get<uint32_t>() != paths.size()) return false;
+
+  for (size_t s = 0; s < paths.size(); s++) {
+    if (in.get_path() != paths[s] || in.get<FileKey>() != keys[s]) return false;
+  }
+
+  return true;
+}
+
+static void write_snapshot(
+  const std::filesystem::path &path,
+  const DexSources &sources,
+  const std::vector<FileKey> &tile_keys,
+  const std::vector<FileKey> &prop_keys,
+  const TileDex &tiles,
+  const PropDex &props
+) {
+  snapshot_writer out;
+
+  out.bytes.append(snapshot_magic, sizeof(snapshot_magic));
+  out.put(snapshot_version);
+  out.put(snapshot_byte_order);
+
+  put_sources(out, sources.tiles, tile_keys);
+  put_sources(out, sources.props, prop_keys);
+
+  // Replaying categories and their definitions in order reproduces the
+  // registration order.
+
+  size_t tile_records = tiles.categories().size();
+  for (const auto &category : tiles.sorted_tiles()) tile_records += category.size();
+
+  out.put(static_cast<uint32_t>(tile_records));
+
+  for (size_t c = 0; c < tiles.categories().size(); c++) {
+    const auto &category = tiles.categories()[c];
+
+    out.put(snapshot_record::category);
+    out.put(category.name);
+    out.put(category.color);
+
+    for (const auto *def : tiles.sorted_tiles()[c]) {
+      out.put(snapshot_record::definition);
+      put_tiledef(out, def);
+    }
+  }
+
+  size_t prop_records = props.categories().size();
+  for (const auto &category : props.sorted_props()) prop_records += category.size();
+
+  out.put(static_cast<uint32_t>(prop_records));
+
+  for (size_t c = 0; c < props.categories().size(); c++) {
+    const auto &category = props.categories()[c];
+
+    out.put(snapshot_record::category);
+    out.put(category.name);
+    out.put(category.color);
+
+    for (const auto *def : props.sorted_props()[c]) {
+      out.put(snapshot_record::definition);
+      put_propdef(out, def);
+    }
+  }
+
+  auto temporary = path;
+  temporary += ".tmp";
+
+  {
+    std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+    if (!file) throw serialization_failure("failed to open '"+temporary.string()+"' for writing");
+
+    file.write(out.bytes.data(), static_cast<std::streamsize>(out.bytes.size()));
+    file.close();
+
+    if (!file) {
+      std::error_code ec;
+      std::filesystem::remove(temporary, ec);
+      throw serialization_failure("failed to write '"+temporary.string()+"'");
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(temporary, path, ec);
+
+  if (ec) {
+    std::filesystem::remove(temporary, ec);
+    throw serialization_failure("failed to replace '"+path.string()+"'");
+  }
+}
+
+/// @brief A category or a definition read from a snapshot, before it is
+/// handed to a dex.
+template <typename Category, typename Def>
+struct snapshot_entry {
+  bool is_category;
+  Category category;
+  std::unique_ptr<Def> def;
+};
+
+template <typename Category, typename Def, typename GetDef>
+static std::vector<snapshot_entry<Category, Def>> get_entries(snapshot_reader &in, GetDef get_def) {
+  auto count = in.get<uint32_t>();
+
+  std::vector<snapshot_entry<Category, Def>> entries;
+
+  for (uint32_t e = 0; e < count; e++) {
+    snapshot_entry<Category, Def> entry{false, Category{}, nullptr};
+
+    switch (in.get<snapshot_record>()) {
+    case snapshot_record::category:
+      entry.is_category = true;
+      entry.category.name = in.get_string();
+      entry.category.color = in.get<Color>();
+      break;
+
+    case snapshot_record::definition:
+      // Definitions always follow a category.
+      if (entries.empty()) throw snapshot_mismatch{};
+      entry.def = get_def(in);
+      break;
+
+    default: throw snapshot_mismatch{};
+    }
+
+    entries.push_back(std::move(entry));
+  }
+
+  return entries;
+}
+
+/// @brief The directory listings shared by the definitions of a snapshot.
+using directory_listings = std::unordered_map<std::string, std::unordered_map<std::string, std::filesystem::path>>;
+
+/// @brief Replaces the texture directories read from a snapshot with the
+/// texture paths registration would resolve now: the Cast members of
+/// internal definitions, and the textures next to the Init files of the
+/// others. Every directory is listed once.
+/// @return false if an internal definition's member is missing or a
+/// directory can't be listed; registration reports those.
+template <typename Category, typename Def, typename Name, typename Tags>
+static bool resolve_textures(
+  std::vector<snapshot_entry<Category, Def>> &entries,
+  Name name_of,
+  Tags tags_of,
+  const CastLibs *libs,
+  directory_listings &listings
+) {
+  for (auto &entry : entries) {
+    if (entry.is_category) continue;
+
+    auto &def = *entry.def;
+    const auto &name = name_of(def);
+
+    if (tags_of(def).has(tags::internal)) {
+      auto *member = libs != nullptr ? libs->member(name) : nullptr;
+      if (member == nullptr) return false;
+
+      def.set_texture_path(member->get_texture_path());
+      continue;
+    }
+
+    const auto directory = def.get_texture_path();
+    auto listing = listings.find(directory.string());
+
+    if (listing == listings.end()) {
+      try {
+        listing = listings.emplace(directory.string(), list_init_directory(directory)).first;
+      } catch (std::filesystem::filesystem_error &) {
+        return false;
+      }
+    }
+
+    def.set_texture_path(resolve_init_texture(directory, listing->second, name));
+  }
+
+  return true;
+}
+
+/// @brief Rebuilds the dexes from a snapshot.
+/// @return false, leaving the dexes untouched, if the snapshot does not
+/// exist or does not match the sources.
+static bool read_snapshot(
+  const std::filesystem::path &path,
+  const DexSources &sources,
+  const std::vector<FileKey> &tile_keys,
+  const std::vector<FileKey> &prop_keys,
+  TileDex &tiles,
+  PropDex &props,
+  const CastLibs *libs
+) {
+  std::error_code ec;
+  if (!std::filesystem::is_regular_file(path, ec)) return false;
+
+  std::unique_ptr<mp::mapped_file> file;
+
+  try {
+    file = std::make_unique<mp::mapped_file>(path);
+  } catch (mp::mapping_failure &) {
+    return false;
+  }
+
+  if (file->size() < sizeof(snapshot_magic) ||
+      std::memcmp(file->data(), snapshot_magic, sizeof(snapshot_magic)) != 0) return false;
+
+  snapshot_reader in(file->begin() + sizeof(snapshot_magic), file->end());
+
+  try {
+    if (in.get<uint32_t>() != snapshot_version ||
+        in.get<uint32_t>() != snapshot_byte_order) return false;
+
+    if (!same_sources(in, sources.tiles, tile_keys) ||
+        !same_sources(in, sources.props, prop_keys)) return false;
+
+    // Everything is read before anything is registered, so that a
+    // corrupt snapshot leaves nothing behind.
+    auto tile_entries = get_entries<TileDefCategory, TileDef>(in, get_tiledef);
+    auto prop_entries = get_entries<PropDefCategory, PropDef>(in, get_propdef);
+
+    if (!in.at_end()) return false;
+
+    directory_listings listings;
+
+    auto tile_name = [](const TileDef &def) -> const std::string& { return def.get_name(); };
+    auto tile_tags = [](const TileDef &def) -> const TagSet& { return def.get_tag_set(); };
+
+    auto prop_name = [](const PropDef &def) -> const std::string& { return def.name; };
+    auto prop_tags = [](const PropDef &def) -> const TagSet& { return def.tag_set; };
+
+    if (!resolve_textures(tile_entries, tile_name, tile_tags, libs, listings) ||
+        !resolve_textures(prop_entries, prop_name, prop_tags, libs, listings))
+      return false;
+
+    for (auto &entry : tile_entries) {
+      if (entry.is_category) tiles.add_category(entry.category);
+      else tiles.add(entry.def.release());
+    }
+
+    for (auto &entry : prop_entries) {
+      if (entry.is_category) props.add_category(entry.category);
+      else props.add(entry.def.release());
+    }
+  } catch (snapshot_mismatch &) {
+    return false;
+  }
+
+  return true;
+}
+
+/// @brief Keys every source file.
+/// @return false if any of them could not be read.
+static bool key_sources(const std::vector<std::filesystem::path> &paths, std::vector<FileKey> &keys) {
+  keys.clear();
+  keys.reserve(paths.size());
+
+  try {
+    for (const auto &path : paths) keys.push_back(file_key(path));
+  } catch (std::exception &) {
+    return false;
+  }
+
+  return true;
+}
+
+bool register_dexes(
+  const std::filesystem::path &snapshot,
+  const DexSources &sources,
+  TileDex &tiles,
+  PropDex &props,
+  const CastLibs *libs
+) {
+  // Taken before registering, so that an Init file modified in the
+  // meantime does not match the snapshot written below.
+  std::vector<FileKey> tile_keys, prop_keys;
+
+  bool keyed = key_sources(sources.tiles, tile_keys) && key_sources(sources.props, prop_keys);
+
+  if (keyed && read_snapshot(snapshot, sources, tile_keys, prop_keys, tiles, props, libs))
+    return true;
+
+  tiles.register_from(sources.tiles, libs);
+  props.register_from(sources.props, libs);
+
+  // The snapshot is only an optimization; the dexes are complete either way.
+  if (keyed) {
+    try {
+      write_snapshot(snapshot, sources, tile_keys, prop_keys, tiles, props);
+    } catch (serialization_failure &) {}
+  }
+
+  return false;
+}
+}; // namespace mr::serde
@@ -3,6 +3,7 @@
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <unordered_map>
@@ -17,6 +18,7 @@
 #include <toml++/impl/parse_error.hpp>
 #include <toml++/impl/parser.hpp>
 
+#include <MobitParser/events.h>
 #include <MobitParser/nodes.h>
 #include <MobitParser/tokens.h>
 
@@ -31,17 +33,17 @@ namespace mr::serde {
 
 
 TileDefCategory deser_tiledef_category(const mp::Node *node) {
-  const mp::List *list = dynamic_cast<const mp::List*>(node);
+  const mp::List *list = mp::node_cast<mp::List>(node);
   
   if (list == nullptr) 
     throw deserialization_failure("category is not a linear list");
 
-  mp::Node *name_node = list->elements[0].get();
-  mp::String *name_string_node = dynamic_cast<mp::String*>(name_node);
+  mp::Node *name_node = list->elements[0];
+  mp::String *name_string_node = mp::node_cast<mp::String>(name_node);
   if (name_string_node == nullptr)
     throw deserialization_failure("category name is not a string");
 
-  mp::Node *color_node = list->elements[1].get();
+  mp::Node *color_node = list->elements[1];
   Color color;
 
   try {
@@ -53,11 +55,11 @@ TileDefCategory deser_tiledef_category(const mp::Node *node) {
     throw deserialization_failure(msg);
   }
 
-  return TileDefCategory{name_string_node->str, color};
+  return TileDefCategory{std::string(name_string_node->str), color};
 }
 
 TileDef *deser_tiledef(const mp::Node *node) {
-  const mp::Props *props = dynamic_cast<const mp::Props*>(node);
+  const mp::Props *props = mp::node_cast<mp::Props>(node);
   
   if (props == nullptr) throw deserialization_failure("node is not a property list");
   
@@ -75,8 +77,8 @@ TileDef *deser_tiledef(const mp::Node *node) {
 
   // nm
   try {
-    const auto &name_node = dict.at("nm");
-    name = deser_string(name_node.get());
+    const auto &name_node = dict.at(mp::keys::nm);
+    name = deser_string(name_node);
   } catch (std::out_of_range &e) {
     throw deserialization_failure("missing required propery: 'nm'");
   } catch (deserialization_failure &de) {
@@ -87,9 +89,9 @@ TileDef *deser_tiledef(const mp::Node *node) {
 
   // sz
   try {
-    const auto &size_node = dict.at("sz");
+    const auto &size_node = dict.at(mp::keys::sz);
     int x, y;
-    deser_point(size_node.get(), x, y);
+    deser_point(size_node, x, y);
     width = (uint8_t)x;
     height = (uint8_t)y;
   } catch (std::out_of_range &e) {
@@ -102,8 +104,8 @@ TileDef *deser_tiledef(const mp::Node *node) {
 
   // tp
   try {
-    const auto &type_node = dict.at("tp");
-    type = deser_string(type_node.get());
+    const auto &type_node = dict.at(mp::keys::tp);
+    type = deser_string(type_node);
   } catch (std::out_of_range &e) {
     throw deserialization_failure("missing required propery: 'tp'");
   } catch (deserialization_failure &de) {
@@ -138,8 +140,8 @@ TileDef *deser_tiledef(const mp::Node *node) {
 
   // bfTiles
   try {
-    const auto &bftl_node = dict.at("bftiles");
-    buffer = deser_uint8(bftl_node.get());
+    const auto &bftl_node = dict.at(mp::keys::bftiles);
+    buffer = deser_uint8(bftl_node);
   } catch (std::out_of_range &e) {
     throw deserialization_failure("missing required propery: 'bfTiles'");
   } catch (deserialization_failure &de) {
@@ -150,8 +152,8 @@ TileDef *deser_tiledef(const mp::Node *node) {
 
   // specs
   try {
-    const auto &spc1_node = dict.at("specs");
-    specs1 = deser_int_vec(spc1_node.get());
+    const auto &spc1_node = dict.at(mp::keys::specs);
+    specs1 = deser_int_vec(spc1_node);
   } catch (std::out_of_range &e) {
     throw deserialization_failure("missing required propery: 'specs'");
   } catch (deserialization_failure &de) {
@@ -162,8 +164,8 @@ TileDef *deser_tiledef(const mp::Node *node) {
 
   // tags
   try {
-    const auto &tags_node = dict.at("tags");
-    tags = deser_string_set(tags_node.get());
+    const auto &tags_node = dict.at(mp::keys::tags);
+    tags = deser_string_set(tags_node);
   } catch (std::out_of_range &e) {
     throw deserialization_failure("missing required propery: 'tags'");
   } catch (deserialization_failure &de) {
@@ -174,12 +176,12 @@ TileDef *deser_tiledef(const mp::Node *node) {
 
   // Optional
 
-  auto spc2_node = dict.find("specs2");
+  auto spc2_node = dict.find(mp::keys::specs2);
   if (spc2_node != dict.end()) {
     try {
-      specs2 = deser_int_vec(spc2_node->second.get());
+      specs2 = deser_int_vec(spc2_node->second);
     } catch (deserialization_failure &e) {
-      const mp::List *list = dynamic_cast<const mp::List*>(spc2_node->second.get());
+      const mp::List *list = mp::node_cast<mp::List>(spc2_node->second);
       if (list != nullptr) {
         std::string msg("failed to deserialize property 'specs2': ");
         msg += e.what();
@@ -188,12 +190,12 @@ TileDef *deser_tiledef(const mp::Node *node) {
     }
   }
 
-  auto spc3_node = dict.find("specs3");
+  auto spc3_node = dict.find(mp::keys::specs3);
   if (spc3_node != dict.end()) {
     try {
-      specs3 = deser_int_vec(spc3_node->second.get());
+      specs3 = deser_int_vec(spc3_node->second);
     } catch (deserialization_failure &e) {
-      const mp::List *list = dynamic_cast<const mp::List*>(spc3_node->second.get());
+      const mp::List *list = mp::node_cast<mp::List>(spc3_node->second);
       if (list != nullptr) {
         std::string msg("failed to deserialize property 'specs3': ");
         msg += e.what();
@@ -202,10 +204,10 @@ TileDef *deser_tiledef(const mp::Node *node) {
     }
   }
 
-  auto rand_node = dict.find("rnd");
+  auto rand_node = dict.find(mp::keys::rnd);
   if (rand_node != dict.end()) {
     try {
-      rnd = deser_int8(rand_node->second.get());
+      rnd = deser_int8(rand_node->second);
     } catch (deserialization_failure &e) {
       std::string msg("failed to deserialize property 'rnd': ");
       msg += e.what();
@@ -213,10 +215,10 @@ TileDef *deser_tiledef(const mp::Node *node) {
     }
   }
 
-  auto rept_node = dict.find("repeatl");
+  auto rept_node = dict.find(mp::keys::repeatl);
   if (rept_node != dict.end()) {
     try {
-      repeat = deser_int_vec(rept_node->second.get());
+      repeat = deser_int_vec(rept_node->second);
     } catch (deserialization_failure &e) {
       std::string msg("failed to deserialize property 'repeatL': ");
       msg += e.what();
@@ -239,7 +241,7 @@ TileDef *deser_tiledef(const mp::Node *node) {
 }
 
 void deser_tile_matrix    (const mp::Node *node, Matrix<TileCell> &matrix) {
-  const mp::List *columns = dynamic_cast<const mp::List*>(node);
+  const mp::List *columns = mp::node_cast<mp::List>(node);
 
   if (columns == nullptr) throw deserialization_failure("top level node (columns) is not a linear list");
 
@@ -257,7 +259,7 @@ void deser_tile_matrix    (const mp::Node *node, Matrix<TileCell> &matrix) {
   }
 
   for (auto x = 0; x < matrix.get_width(); x++) {
-    auto *rows = dynamic_cast<mp::List *>(columns->elements[x].get());
+    auto *rows = mp::node_cast<mp::List>(columns->elements[x]);
 
     if (rows == nullptr) {
       std::stringstream sb;
@@ -278,7 +280,7 @@ void deser_tile_matrix    (const mp::Node *node, Matrix<TileCell> &matrix) {
     }
 
     for (auto y = 0; y < matrix.get_height(); y++) {
-      auto *depth = dynamic_cast<mp::List *>(rows->elements[y].get());
+      auto *depth = mp::node_cast<mp::List>(rows->elements[y]);
 
       if (depth == nullptr)
         throw deserialization_failure(
@@ -293,9 +295,9 @@ void deser_tile_matrix    (const mp::Node *node, Matrix<TileCell> &matrix) {
         throw deserialization_failure(sb.str());
       }
 
-      const auto *l1 = depth->elements[0].get();
-      const auto *l2 = depth->elements[1].get();
-      const auto *l3 = depth->elements[2].get();
+      const auto *l1 = depth->elements[0];
+      const auto *l2 = depth->elements[1];
+      const auto *l3 = depth->elements[2];
 
       TileCell new_cell1, new_cell2, new_cell3;
 
@@ -340,21 +342,21 @@ void deser_tile_matrix    (const mp::Node *node, Matrix<TileCell> &matrix) {
 }
 
 void deser_tilecell(const mp::Node *node, TileCell &cell) {
-  const mp::Props *props = dynamic_cast<const mp::Props*>(node);
+  const mp::Props *props = mp::node_cast<mp::Props>(node);
 
   if (props == nullptr) throw deserialization_failure("node is not a property list");
 
-  auto tp_iter = props->map.find("tp");
+  auto tp_iter = props->map.find(mp::keys::tp);
 
   if (tp_iter == props->map.end())
     throw deserialization_failure("missing required cell property #tp");
 
-  auto data_iter = props->map.find("data");
+  auto data_iter = props->map.find(mp::keys::data);
 
   if (data_iter == props->map.end())
     throw deserialization_failure("missing required cell property #Data");
 
-  mp::String *tp_node = dynamic_cast<mp::String*>(tp_iter->second.get());
+  mp::String *tp_node = mp::node_cast<mp::String>(tp_iter->second);
   if (tp_node == nullptr)
     throw deserialization_failure("cell property #tp is not a String");
   
@@ -369,12 +371,12 @@ void deser_tilecell(const mp::Node *node, TileCell &cell) {
     type = TileType::material;
   } else if (tp_node->str == "default") {
     type = TileType::_default;
-  } else throw deserialization_failure("unknown cell type '"+tp_node->str+"'");
+  } else throw deserialization_failure("unknown cell type '"+std::string(tp_node->str)+"'");
   
   switch (type) {
     case TileType::head:
     {
-      const mp::List *data_node = dynamic_cast<const mp::List*>(data_iter->second.get());
+      const mp::List *data_node = mp::node_cast<mp::List>(data_iter->second);
       if (data_node == nullptr)
         throw deserialization_failure("cell property #Data is not a Linear list (requierd for cell type 'tileHead')");
 
@@ -384,7 +386,7 @@ void deser_tilecell(const mp::Node *node, TileCell &cell) {
       std::string und_name;
 
       try {
-        und_name = deser_string(data_node->elements[1].get());
+        und_name = deser_string(data_node->elements[1]);
       } catch (deserialization_failure &sde) {
         throw deserialization_failure(
           std::string("failed tp deserialize cell #Data node's head tile name (second element): ") + sde.what()
@@ -397,7 +399,7 @@ void deser_tilecell(const mp::Node *node, TileCell &cell) {
 
     case TileType::body:
     {
-      const mp::List *data_node = dynamic_cast<const mp::List*>(data_iter->second.get());
+      const mp::List *data_node = mp::node_cast<mp::List>(data_iter->second);
       if (data_node == nullptr)
         throw deserialization_failure("cell property #Data is not a Linear list (requierd for cell type 'tileBody')");
 
@@ -407,7 +409,7 @@ void deser_tilecell(const mp::Node *node, TileCell &cell) {
       int x, y, z;
 
       try {
-        deser_point(data_node->elements[0].get(), x, y);
+        deser_point(data_node->elements[0], x, y);
       } catch (deserialization_failure &pde) {
         throw deserialization_failure(
           std::string("failed to deserialize cell's #Data node's first element: ")+pde.what()
@@ -415,7 +417,7 @@ void deser_tilecell(const mp::Node *node, TileCell &cell) {
       }
 
       try {
-        z = deser_int(data_node->elements[1].get());
+        z = deser_int(data_node->elements[1]);
       } catch (deserialization_failure &pde) {
         throw deserialization_failure(
           std::string("failed to deserialize cell's #Data node's second element: ")+pde.what()
@@ -428,7 +430,7 @@ void deser_tilecell(const mp::Node *node, TileCell &cell) {
 
     case TileType::material:
     {
-      const mp::String *data_node = dynamic_cast<const mp::String*>(data_iter->second.get());
+      const mp::String *data_node = mp::node_cast<mp::String>(data_iter->second);
       if (data_node == nullptr)
         throw deserialization_failure("cell property #Data is not a String (requierd for cell type 'material')");
 
@@ -453,58 +455,322 @@ void deser_tilecell(const mp::Node *node, TileCell &cell) {
     break;
   }
 }
-void define_tile_matrix(
-  Matrix<TileCell> &mtx, 
-  const TileDex *tiledex,
-  const MaterialDex *materialdex
-) {
-  if (tiledex == nullptr)
-    throw std::invalid_argument("tile dex was null");
-  
-  if (materialdex == nullptr)
-    throw std::invalid_argument("material dex was null");
 
+// The streaming cell readers report problems by returning a static
+// description instead of throwing, so that a lenient deserialization
+// can skip any number of malformed cells without unwinding.
+
+/// @brief Reads a 'point' global call.
+/// @return A description of the problem, or nullptr if the point is valid.
+static const char *read_point(mp::event_reader &reader, int &x, int &y) {
+  const auto call = reader.next();
+
+  if (call.type != mp::event_type::begin_call) return "node is not a Global Call";
+  if (call.value != "point") return "global call is not a point";
+
+  int values[2];
+
+  for (int &value : values) {
+    if (reader.peek().type == mp::event_type::end_call) 
+      return "point global call has insufficient arguments (expected at least 2)";
+
+    const auto e = reader.next();
+
+    if      (e.type == mp::event_type::integer)  value = e.integer;
+    else if (e.type == mp::event_type::floating) value = (int)e.floating;
+    else return "point argument is not an Int or a Float";
+  }
+
+  while (reader.peek().type != mp::event_type::end_call) reader.skip();
+  reader.next();
+
+  x = values[0];
+  y = values[1];
+
+  return nullptr;
+}
+
+/// @brief Reads a cell's #Data value once its #tp is known.
+/// @return A description of the problem, or nullptr if the data is valid.
+static const char *read_tilecell_data(mp::event_reader &reader, TileType type, TileCell &cell) {
+  switch (type) {
+    case TileType::head:
+    {
+      if (reader.next().type != mp::event_type::begin_list)
+        return "cell property #Data is not a Linear list (requierd for cell type 'tileHead')";
+
+      if (reader.peek().type == mp::event_type::end_list)
+        return "cell data has insufficient data (expected at least 2 elements)";
+      
+      reader.skip();
+
+      if (reader.peek().type == mp::event_type::end_list)
+        return "cell data has insufficient data (expected at least 2 elements)";
+
+      const auto und_name = reader.next();
+
+      if (und_name.type != mp::event_type::string)
+        return "failed to deserialize cell #Data node's head tile name (second element): node is not a String";
+
+      while (reader.peek().type != mp::event_type::end_list) reader.skip();
+      reader.next();
+
+      cell = TileCell(und_name.value, false);
+    }
+    break;
+
+    case TileType::body:
+    {
+      if (reader.next().type != mp::event_type::begin_list)
+        return "cell property #Data is not a Linear list (requierd for cell type 'tileBody')";
+
+      if (reader.peek().type == mp::event_type::end_list)
+        return "cell data has insufficient data (expected at least 2 elements)";
+
+      int x, y;
+
+      if (const char *error = read_point(reader, x, y)) return error;
+
+      if (reader.peek().type == mp::event_type::end_list)
+        return "cell data has insufficient data (expected at least 2 elements)";
+
+      const auto z = reader.next();
+
+      if (z.type != mp::event_type::integer && z.type != mp::event_type::floating)
+        return "failed to deserialize cell's #Data node's second element: node is not an Int or a Float";
+
+      while (reader.peek().type != mp::event_type::end_list) reader.skip();
+      reader.next();
+
+      int layer = z.type == mp::event_type::integer ? z.integer : (int)z.floating;
+
+      cell = TileCell(x - 1, y - 1, layer - 1);
+    }
+    break;
+
+    case TileType::material:
+    {
+      const auto material = reader.next();
+
+      if (material.type != mp::event_type::string)
+        return "cell property #Data is not a String (requierd for cell type 'material')";
+
+      cell = TileCell(material.value, true);
+    }
+    break;
+
+    default:
+    reader.skip();
+    if (cell.type != TileType::_default) cell = TileCell();
+    break;
+  }
+
+  return nullptr;
+}
+
+/// @brief Reads a [#tp: .., #Data: ..] cell.
+/// @return A description of the problem, or nullptr if the cell is valid.
+static const char *read_tilecell(mp::event_reader &reader, TileCell &cell) {
+  if (reader.next().type != mp::event_type::begin_list) 
+    return "node is not a property list";
+
+  bool has_type = false, has_data = false;
+  TileType type = TileType::_default;
+
+  // #Data is read as soon as #tp is known; should it come first, a copy
+  // of the reader is kept to come back to it.
+  std::optional<mp::event_reader> deferred_data;
+
+  while (reader.peek().type == mp::event_type::property) {
+    const auto key = reader.next();
+
+    if (key.is("tp")) {
+      const auto tp = reader.next();
+
+      if (tp.type != mp::event_type::string)
+        return "cell property #tp is not a String";
+
+      if (tp.value == "tileHead") {
+        type = TileType::head;
+      } else if (tp.value == "tileBody") {
+        type = TileType::body;
+      } else if (tp.value == "material") {
+        type = TileType::material;
+      } else if (tp.value == "default") {
+        type = TileType::_default;
+      } else return "unknown cell type";
+
+      has_type = true;
+    } else if (key.is("data")) {
+      if (has_type) {
+        if (const char *error = read_tilecell_data(reader, type, cell)) return error;
+      } else {
+        deferred_data = reader;
+        reader.skip();
+      }
+
+      has_data = true;
+    } else {
+      reader.skip();
+    }
+  }
+
+  if (reader.next().type != mp::event_type::end_list)
+    return "node is not a property list";
+
+  if (!has_type)
+    return "missing required cell property #tp";
+
+  if (!has_data)
+    return "missing required cell property #Data";
+
+  if (deferred_data.has_value()) 
+    return read_tilecell_data(*deferred_data, type, cell);
+
+  return nullptr;
+}
+
+void deser_tilecell(mp::event_reader &reader, TileCell &cell) {
+  if (const char *error = read_tilecell(reader, cell)) throw deserialization_failure(error);
+}
+
+void deser_tile_matrix(mp::event_reader &reader, Matrix<TileCell> &matrix, Diagnostics *diagnostics) {
+  if (reader.next().type != mp::event_type::begin_list) 
+    throw deserialization_failure("top level node (columns) is not a linear list");
+
+  int x = 0;
+
+  for (; reader.peek().type != mp::event_type::end_list; x++) {
+    // Keep counting the columns for the error below.
+    if (x >= matrix.get_width()) {
+      reader.skip();
+      continue;
+    }
+
+    if (reader.peek().type != mp::event_type::begin_list) {
+      std::stringstream sb;
+
+      sb << "malformed geometry (expected a list of rows at column " << x
+         << ")";
+
+      if (diagnostics == nullptr) throw malformed_geometry(sb.str());
+
+      diagnostics->report("tiles", x, -1, -1, sb.str());
+      reader.skip();
+      continue;
+    }
+
+    reader.next();
+
+    int y = 0;
+
+    for (; reader.peek().type != mp::event_type::end_list; y++) {
+      if (y >= matrix.get_height()) {
+        reader.skip();
+        continue;
+      }
+
+      if (reader.peek().type != mp::event_type::begin_list) {
+        if (diagnostics == nullptr) 
+          throw deserialization_failure(
+            "malformed tiles (expected a list of cell layers)");
+
+        diagnostics->report("tiles", x, y, -1, "malformed tiles (expected a list of cell layers)");
+        reader.skip();
+        continue;
+      }
+
+      reader.next();
+
+      int z = 0;
+
+      for (; reader.peek().type != mp::event_type::end_list; z++) {
+        if (z >= 3) {
+          reader.skip();
+          continue;
+        }
+
+        // Where to resume from, should the cell be malformed.
+        std::optional<mp::event_reader> cell_start;
+        if (diagnostics != nullptr) cell_start = reader;
+
+        auto &cell = matrix.get(x, y, z);
+
+        if (const char *error = read_tilecell(reader, cell)) {
+          if (diagnostics == nullptr) {
+            std::stringstream sb;
+            sb 
+              << "failed to deserialize cell at ("
+              << x << ", " << y << ", " << z << "): "
+              << error;
+
+            throw deserialization_failure(sb.str());
+          }
+
+          diagnostics->report("tiles", x, y, z, error);
+
+          cell = TileCell();
+          reader = *cell_start;
+          reader.skip();
+        }
+      }
+
+      reader.next();
+
+      if (z != 3) {
+        std::stringstream sb;
+
+        sb << "incorrect tiles depth; expected (3) but got ("
+           << z << ')';
+
+        if (diagnostics == nullptr) throw deserialization_failure(sb.str());
+
+        diagnostics->report("tiles", x, y, -1, sb.str());
+      }
+    }
+
+    reader.next();
+
+    if (y != matrix.get_height()) {
+      std::stringstream sb;
+
+      sb << "incorrect geometry height; expected (" << matrix.get_height()
+         << ") but got (" << y << ')';
+
+      if (diagnostics == nullptr) throw malformed_geometry(sb.str());
+
+      diagnostics->report("tiles", x, -1, -1, sb.str());
+    }
+  }
+
+  reader.next();
+
+  if (x != matrix.get_width()) {
+    std::stringstream sb;
+
+    sb 
+      << "incorrect matrix width; expected (" 
+      << matrix.get_width()
+      << "), but got (" 
+      << x
+      << ')';
+
+    if (diagnostics == nullptr) throw deserialization_failure(sb.str());
+
+    diagnostics->report("tiles", sb.str());
+  }
+}
+
+void define_tile_matrix(Matrix<TileCell> &mtx) {
   for (uint16_t z = 0; z < 3; z++) {
     for (uint16_t x = 0; x < mtx.get_width(); x++) {
       for (uint16_t y = 0; y < mtx.get_height(); y++) {
         auto &cell = mtx.get(x, y, z);
+        if (cell.type != TileType::body) continue;
 
-        switch (cell.type) {
-          case TileType::head:
-          {
-            cell.tile_def = tiledex->tile(cell.und_name);
-          }
-          break;
-
-          case TileType::body:
-          {
-            if (mtx.is_in_bounds(cell.head_pos_x, cell.head_pos_y, cell.head_pos_z)) {
-              auto &supposed_head = mtx.get(cell.head_pos_x, cell.head_pos_y, cell.head_pos_z);
-
-              if (supposed_head.type == TileType::head) {
-                if (supposed_head.tile_def == nullptr) {
-                  auto *def = tiledex->tile(supposed_head.und_name);
-
-                  cell.tile_def = def;
-                  supposed_head.tile_def = def;
-                }
-                else
-                {
-                  cell.tile_def = supposed_head.tile_def;
-                }
-              }
-            }
-          }
-          break;
-
-          case TileType::material:
-          {
-            auto *def = materialdex->material(cell.und_name);
-            cell.material_def = def;
-          }
-          break;
-
-          default: continue;
+        if (mtx.is_in_bounds(cell.head_pos_x, cell.head_pos_y, cell.head_pos_z)) {
+          const auto &supposed_head = mtx.get_const(cell.head_pos_x, cell.head_pos_y, cell.head_pos_z);
+          if (supposed_head.type == TileType::head) cell.name = supposed_head.name;
         }
       }
     }
@@ -512,14 +778,14 @@ void define_tile_matrix(
 }
 
 std::string deser_default_material(const mp::Node *line_node) {
-  const mp::Props *props = dynamic_cast<const mp::Props*>(line_node);
+  const mp::Props *props = mp::node_cast<mp::Props>(line_node);
   if (props == nullptr) throw deserialization_failure("node is not a property list");
 
-  auto iter = props->map.find("defaultmaterial");
+  auto iter = props->map.find(mp::keys::defaultmaterial);
   if (iter == props->map.end()) throw deserialization_failure("#defaultMaterial not found");
 
   try {
-    auto name = deser_string(iter->second.get());
+    auto name = deser_string(iter->second);
     return name;
   } catch (deserialization_failure &de) {
     throw deserialization_failure(std::string("failed to deserialize property #defaultMaterial: ")+de.what());
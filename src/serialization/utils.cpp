@@ -12,6 +12,7 @@
 
 #include <raylib.h>
 
+#include <MobitParser/events.h>
 #include <MobitParser/nodes.h>
 #include <MobitParser/tokens.h>
 
@@ -26,64 +27,61 @@ namespace mr::serde {
 
 
 bool deser_bool(const mp::Node *node) {
-  const auto *int_node = dynamic_cast<const mp::Int*>(node);
-
-  if (int_node != nullptr) {
-    return int_node->number != 0;
+  if (node != nullptr) {
+    switch (node->kind) {
+    case mp::node_kind::integer:  return node->as_int()->number != 0;
+    case mp::node_kind::floating: return node->as_float()->number != 0;
+    default: break;
+    }
   }
 
-  const auto *float_node = dynamic_cast<const mp::Float*>(node);
-
-  if (float_node == nullptr)
-    throw deserialization_failure("node is not Int or Float");
-
-  return float_node->number != 0;
+  throw deserialization_failure("node is not Int or Float");
 }
 int deser_int(const mp::Node *node) {
-  const mp::Int *int_node = dynamic_cast<const mp::Int*>(node);
-  if (int_node == nullptr) {
-    
-    const mp::Float *float_node = dynamic_cast<const mp::Float*>(node);
-    if (float_node == nullptr) throw deserialization_failure("node is not an Int or a Float");
-
-    return (int)float_node->number;
+  if (node != nullptr) {
+    switch (node->kind) {
+    case mp::node_kind::integer:  return node->as_int()->number;
+    case mp::node_kind::floating: return (int)node->as_float()->number;
+    default: break;
+    }
   }
-  return int_node->number;
+
+  throw deserialization_failure("node is not an Int or a Float");
 }
 float deser_float(const mp::Node *node) {
-  const mp::Float *float_node = dynamic_cast<const mp::Float*>(node);
-  if (float_node == nullptr) {
-    const mp::Int *int_node = dynamic_cast<const mp::Int*>(node);
-
-    if (int_node == nullptr) throw deserialization_failure("node is not a Float or an Int");
-
-    return (float)int_node->number;
+  if (node != nullptr) {
+    switch (node->kind) {
+    case mp::node_kind::floating: return node->as_float()->number;
+    case mp::node_kind::integer:  return (float)node->as_int()->number;
+    default: break;
+    }
   }
-  return float_node->number;
+
+  throw deserialization_failure("node is not a Float or an Int");
 }
 int8_t deser_int8(const mp::Node *node) {
-  const mp::Int *int_node = dynamic_cast<const mp::Int*>(node);
+  const mp::Int *int_node = mp::node_cast<mp::Int>(node);
   if (int_node == nullptr) throw deserialization_failure("node is not an uint8");
   return static_cast<int8_t>(int_node->number);
 }
 uint8_t deser_uint8(const mp::Node *node) {
-  const mp::Int *int_node = dynamic_cast<const mp::Int*>(node);
+  const mp::Int *int_node = mp::node_cast<mp::Int>(node);
   if (int_node == nullptr) throw deserialization_failure("node is not an uint8");
   
   return (uint8_t)abs(int_node->number);
 }
 uint16_t deser_uint16(const mp::Node *node) {
-  const mp::Int *int_node = dynamic_cast<const mp::Int*>(node);
+  const mp::Int *int_node = mp::node_cast<mp::Int>(node);
   if (int_node == nullptr) throw deserialization_failure("node is not an uint16");
   return (uint16_t)int_node->number;
 }
 std::string deser_string(const mp::Node *node) {
-  const mp::String *str_node = dynamic_cast<const mp::String*>(node);
+  const mp::String *str_node = mp::node_cast<mp::String>(node);
   if (str_node == nullptr) throw deserialization_failure("node is not a String");
-  return str_node->str;
+  return std::string(str_node->str);
 }
 Color deser_color(const mp::Node *node) {
-  const mp::GCall *color_gcall_node = dynamic_cast<const mp::GCall*>(node);
+  const mp::GCall *color_gcall_node = mp::node_cast<mp::GCall>(node);
   if (color_gcall_node == nullptr)
     throw deserialization_failure("color is not a global call");
   if (color_gcall_node->name != "color")
@@ -94,7 +92,7 @@ Color deser_color(const mp::Node *node) {
   uint8_t r, g, b;
 
   try {
-    r = deser_uint8(color_gcall_node->args[0].get());
+    r = deser_uint8(color_gcall_node->args[0]);
   } catch (deserialization_failure &e) {
     std::string msg("invalid color argument 1: ");
     msg.append(e.what());
@@ -103,7 +101,7 @@ Color deser_color(const mp::Node *node) {
   }
 
   try {
-    g = deser_uint8(color_gcall_node->args[1].get());
+    g = deser_uint8(color_gcall_node->args[1]);
   } catch (deserialization_failure &e) {
     std::string msg("invalid color argument 2: ");
     msg.append(e.what());
@@ -112,7 +110,7 @@ Color deser_color(const mp::Node *node) {
   }
 
   try {
-    b = deser_uint8(color_gcall_node->args[2].get());
+    b = deser_uint8(color_gcall_node->args[2]);
   } catch (deserialization_failure &e) {
     std::string msg("invalid color argument 2: ");
     msg.append(e.what());
@@ -123,7 +121,7 @@ Color deser_color(const mp::Node *node) {
   return Color{r, g, b, 255};
 }
 std::vector<std::string> deser_string_vec(const mp::Node *node) {
-  const mp::List *list = dynamic_cast<const mp::List*>(node);
+  const mp::List *list = mp::node_cast<mp::List>(node);
   if (list == nullptr) throw deserialization_failure("node is not a linear list");
 
   std::vector<std::string> strings;
@@ -131,10 +129,10 @@ std::vector<std::string> deser_string_vec(const mp::Node *node) {
 
   try {
     for (auto &element : list->elements) {
-      mp::Node *element_node = element.get();
-      mp::String *element_string = dynamic_cast<mp::String*>(element_node);
+      mp::Node *element_node = element;
+      mp::String *element_string = mp::node_cast<mp::String>(element_node);
       if (element_string == nullptr) throw deserialization_failure("failed to deserialize list element: node is not a string");
-      strings.push_back(element_string->str);
+      strings.emplace_back(element_string->str);
     }
   } catch (deserialization_failure &e) {
     std::string msg("failed to deserialize list element: ");
@@ -145,7 +143,7 @@ std::vector<std::string> deser_string_vec(const mp::Node *node) {
   return strings;
 }
 std::unordered_set<std::string> deser_string_set(const mp::Node *node) {
-  const mp::List *list = dynamic_cast<const mp::List*>(node);
+  const mp::List *list = mp::node_cast<mp::List>(node);
   if (list == nullptr) throw deserialization_failure("node is not a linear list");
 
   std::unordered_set<std::string> strings;
@@ -153,10 +151,10 @@ std::unordered_set<std::string> deser_string_set(const mp::Node *node) {
 
   try {
     for (auto &element : list->elements) {
-      mp::Node *element_node = element.get();
-      mp::String *element_string = dynamic_cast<mp::String*>(element_node);
+      mp::Node *element_node = element;
+      mp::String *element_string = mp::node_cast<mp::String>(element_node);
       if (element_string == nullptr) throw deserialization_failure("failed to deserialize list element: node is not a string");
-      strings.insert(element_string->str);
+      strings.emplace(element_string->str);
     }
   } catch (deserialization_failure &e) {
     std::string msg("failed to deserialize list element: ");
@@ -167,7 +165,7 @@ std::unordered_set<std::string> deser_string_set(const mp::Node *node) {
   return strings;
 }
 std::vector<int8_t> deser_int8_vec(const mp::Node *node) {
-  const mp::List *list = dynamic_cast<const mp::List*>(node);
+  const mp::List *list = mp::node_cast<mp::List>(node);
   if (list == nullptr) throw deserialization_failure("node is not a linear list");
 
   std::vector<int8_t> numbers;
@@ -175,7 +173,7 @@ std::vector<int8_t> deser_int8_vec(const mp::Node *node) {
 
   try {
     for (auto &element : list->elements) {
-      int8_t number = deser_int8(element.get());
+      int8_t number = deser_int8(element);
       numbers.push_back(number);
     }
   } catch (deserialization_failure &e) {
@@ -187,7 +185,7 @@ std::vector<int8_t> deser_int8_vec(const mp::Node *node) {
   return numbers;
 }
 std::vector<int> deser_int_vec(const mp::Node *node) {
-  const mp::List *list = dynamic_cast<const mp::List*>(node);
+  const mp::List *list = mp::node_cast<mp::List>(node);
   if (list == nullptr) throw deserialization_failure("node is not a linear list");
 
   std::vector<int> numbers;
@@ -195,7 +193,7 @@ std::vector<int> deser_int_vec(const mp::Node *node) {
 
   try {
     for (auto &element : list->elements) {
-      numbers.push_back(deser_int(element.get()));
+      numbers.push_back(deser_int(element));
     }
   } catch (deserialization_failure &e) {
     std::string msg("failed to deserialize list element: ");
@@ -206,7 +204,7 @@ std::vector<int> deser_int_vec(const mp::Node *node) {
   return numbers;
 }
 std::vector<uint8_t> deser_uint8_vec (const mp::Node *node) {
-  const mp::List *list = dynamic_cast<const mp::List*>(node);
+  const mp::List *list = mp::node_cast<mp::List>(node);
   if (list == nullptr) throw deserialization_failure("node is not a linear list");
 
   std::vector<uint8_t> numbers;
@@ -214,7 +212,7 @@ std::vector<uint8_t> deser_uint8_vec (const mp::Node *node) {
 
   try {
     for (auto &element : list->elements) {
-      uint8_t number = deser_uint8(element.get());
+      uint8_t number = deser_uint8(element);
       numbers.push_back(number);
     }
   } catch (deserialization_failure &e) {
@@ -226,7 +224,7 @@ std::vector<uint8_t> deser_uint8_vec (const mp::Node *node) {
   return numbers;
 }
 void deser_point(const mp::Node *node, int &x, int &y) {
-  const mp::GCall *gcall_node = dynamic_cast<const mp::GCall*>(node);
+  const mp::GCall *gcall_node = mp::node_cast<mp::GCall>(node);
   
   if (gcall_node == nullptr) throw deserialization_failure("node is not a Global Call");
   if (gcall_node->name != "point") throw deserialization_failure("global call is not a point");
@@ -235,7 +233,7 @@ void deser_point(const mp::Node *node, int &x, int &y) {
   int value_x, value_y;
 
   try {
-    value_x = deser_int(gcall_node->args[0].get());
+    value_x = deser_int(gcall_node->args[0]);
   } catch (deserialization_failure &e) {
     std::string msg("failed to deserialize point argument 1: ");
     msg += e.what();
@@ -243,7 +241,7 @@ void deser_point(const mp::Node *node, int &x, int &y) {
   }
 
   try {
-    value_y = deser_int(gcall_node->args[1].get());
+    value_y = deser_int(gcall_node->args[1]);
   } catch (deserialization_failure &e) {
     std::string msg("failed to deserialize point argument 2: ");
     msg += e.what();
@@ -254,7 +252,7 @@ void deser_point(const mp::Node *node, int &x, int &y) {
   y = value_y;
 }
 void deser_point(const mp::Node *node, float &x, float &y) {
-  const mp::GCall *gcall_node = dynamic_cast<const mp::GCall*>(node);
+  const mp::GCall *gcall_node = mp::node_cast<mp::GCall>(node);
   
   if (gcall_node == nullptr) throw deserialization_failure("node is not a Global Call");
   if (gcall_node->name != "point") throw deserialization_failure("global call is not a point");
@@ -263,7 +261,7 @@ void deser_point(const mp::Node *node, float &x, float &y) {
   float value_x, value_y;
 
   try {
-    value_x = deser_float(gcall_node->args[0].get());
+    value_x = deser_float(gcall_node->args[0]);
   } catch (deserialization_failure &e) {
     std::string msg("failed to deserialize point argument 1: ");
     msg += e.what();
@@ -271,7 +269,7 @@ void deser_point(const mp::Node *node, float &x, float &y) {
   }
 
   try {
-    value_y = deser_float(gcall_node->args[1].get());
+    value_y = deser_float(gcall_node->args[1]);
   } catch (deserialization_failure &e) {
     std::string msg("failed to deserialize point argument 2: ");
     msg += e.what();
@@ -283,7 +281,7 @@ void deser_point(const mp::Node *node, float &x, float &y) {
 }
 
 void deser_point(const mp::Node *node, Vector2 &vector) {
-  const mp::GCall *gcall_node = dynamic_cast<const mp::GCall*>(node);
+  const mp::GCall *gcall_node = mp::node_cast<mp::GCall>(node);
   
   if (gcall_node == nullptr) throw deserialization_failure("node is not a Global Call");
   if (gcall_node->name != "point") throw deserialization_failure("global call is not a point");
@@ -292,7 +290,7 @@ void deser_point(const mp::Node *node, Vector2 &vector) {
   float value_x, value_y;
 
   try {
-    value_x = deser_float(gcall_node->args[0].get());
+    value_x = deser_float(gcall_node->args[0]);
   } catch (deserialization_failure &e) {
     std::string msg("failed to deserialize point argument 1: ");
     msg += e.what();
@@ -300,7 +298,7 @@ void deser_point(const mp::Node *node, Vector2 &vector) {
   }
 
   try {
-    value_y = deser_float(gcall_node->args[1].get());
+    value_y = deser_float(gcall_node->args[1]);
   } catch (deserialization_failure &e) {
     std::string msg("failed to deserialize point argument 2: ");
     msg += e.what();
@@ -311,4 +309,51 @@ void deser_point(const mp::Node *node, Vector2 &vector) {
   vector.y = value_y;
 }
 
+int deser_int(mp::event_reader &reader) {
+  const auto e = reader.next();
+
+  if (e.type == mp::event_type::integer) return e.integer;
+  if (e.type == mp::event_type::floating) return (int)e.floating;
+
+  throw deserialization_failure("node is not an Int or a Float");
+}
+std::string deser_string(mp::event_reader &reader) {
+  const auto e = reader.next();
+  if (e.type != mp::event_type::string) throw deserialization_failure("node is not a String");
+  return std::string(e.value);
+}
+void deser_point(mp::event_reader &reader, int &x, int &y) {
+  const auto call = reader.next();
+
+  if (call.type != mp::event_type::begin_call) throw deserialization_failure("node is not a Global Call");
+  if (call.value != "point") throw deserialization_failure("global call is not a point");
+  if (reader.peek().type == mp::event_type::end_call) throw deserialization_failure("point global call has insufficient arguments (expected at least 2)");
+
+  int value_x, value_y;
+
+  try {
+    value_x = deser_int(reader);
+  } catch (deserialization_failure &e) {
+    std::string msg("failed to deserialize point argument 1: ");
+    msg += e.what();
+    throw deserialization_failure(msg);
+  }
+
+  if (reader.peek().type == mp::event_type::end_call) throw deserialization_failure("point global call has insufficient arguments (expected at least 2)");
+
+  try {
+    value_y = deser_int(reader);
+  } catch (deserialization_failure &e) {
+    std::string msg("failed to deserialize point argument 2: ");
+    msg += e.what();
+    throw deserialization_failure(msg);
+  }
+
+  while (reader.peek().type != mp::event_type::end_call) reader.skip();
+  reader.next();
+
+  x = value_x;
+  y = value_y;
+}
+
 };
\ No newline at end of file
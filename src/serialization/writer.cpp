@@ -0,0 +1,759 @@
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <raylib.h>
+
+#include <MobitRenderer/definitions.h>
+#include <MobitRenderer/dex.h>
+#include <MobitRenderer/exceptions.h>
+#include <MobitRenderer/level.h>
+#include <MobitRenderer/matrix.h>
+#include <MobitRenderer/serialization.h>
+
+namespace mr::serde {
+
+/// @brief Formats a project file straight into a buffer that is written
+/// out whenever it fills up.
+/// @note Numbers are formatted with std::to_chars; nothing goes through
+/// a stream until the buffer is flushed.
+class project_writer {
+  std::ofstream _file;
+  std::vector<char> _buffer;
+  size_t _size;
+
+  // Enough for any number written below.
+  static constexpr size_t max_number_size = 64;
+
+  void flush() {
+    _file.write(_buffer.data(), static_cast<std::streamsize>(_size));
+    _size = 0;
+
+    if (!_file) throw serialization_failure("failed to write to the project file");
+  }
+
+  char *reserve(size_t size) {
+    if (_buffer.size() - _size < size) flush();
+    return _buffer.data() + _size;
+  }
+
+public:
+  project_writer &operator<<(char c) {
+    *reserve(1) = c;
+    _size++;
+    return *this;
+  }
+
+  project_writer &operator<<(std::string_view str) {
+    if (str.size() > _buffer.size()) {
+      flush();
+      _file.write(str.data(), static_cast<std::streamsize>(str.size()));
+      return *this;
+    }
+
+    std::memcpy(reserve(str.size()), str.data(), str.size());
+    _size += str.size();
+    return *this;
+  }
+
+  // Keeps literals from converting to bool.
+  project_writer &operator<<(const char *str) { return *this << std::string_view(str); }
+
+  project_writer &operator<<(int number) {
+    char *first = reserve(max_number_size);
+    _size = std::to_chars(first, first + max_number_size, number).ptr - _buffer.data();
+    return *this;
+  }
+
+  /// @brief Writes the shortest decimal that reads back as the same float;
+  /// integral values keep a decimal point so that they remain floats.
+  project_writer &operator<<(float number) {
+    if (!std::isfinite(number)) number = 0;
+
+    char *first = reserve(max_number_size);
+    char *last = std::to_chars(first, first + max_number_size, number, std::chars_format::fixed).ptr;
+
+    if (std::memchr(first, '.', last - first) == nullptr) {
+      *last++ = '.';
+      *last++ = '0';
+    }
+
+    _size = last - _buffer.data();
+    return *this;
+  }
+
+  project_writer &operator<<(bool value) { return *this << (value ? '1' : '0'); }
+
+  /// @brief Writes a string literal; Lingo strings have no escapes.
+  void string(std::string_view str) { *this << '"' << str << '"'; }
+
+  void point(int x, int y) { *this << "point(" << x << ", " << y << ')'; }
+  void point(float x, float y) { *this << "point(" << x << ", " << y << ')'; }
+  void point(Vector2 v) { point(v.x, v.y); }
+
+  void close() {
+    flush();
+    _file.close();
+
+    if (!_file) throw serialization_failure("failed to write to the project file");
+  }
+
+  explicit project_writer(const std::filesystem::path &path, size_t buffer_size = 256 * 1024)
+    : _file(path, std::ios::binary | std::ios::trunc), _buffer(buffer_size), _size(0) {
+    if (!_file) throw serialization_failure("failed to open '"+path.string()+"' for writing");
+  }
+};
+
+/// @brief The (category, index) positions of definitions in the editor's
+/// lists, 1-based as Lingo lists are.
+/// @note Tiles used as props are listed in their own categories, after
+/// the prop categories. Unknown definitions are at point(0, 0).
+class def_positions {
+  struct position { int category, index; };
+
+  std::vector<position> _tiles, _props, _tile_props;
+
+  const TileDex *_tile_dex;
+  const PropDex *_prop_dex;
+
+  template <typename Def>
+  static void index(std::vector<position> &positions, size_t size, const std::vector<std::vector<Def*>> &sorted, int first_category) {
+    positions.assign(size, position{0, 0});
+
+    for (size_t c = 0; c < sorted.size(); c++) {
+      for (size_t i = 0; i < sorted[c].size(); i++) {
+        const auto id = sorted[c][i]->get_id();
+        if (id < positions.size()) positions[id] = position{ first_category + static_cast<int>(c), static_cast<int>(i) + 1 };
+      }
+    }
+  }
+
+  static position at(const std::vector<position> &positions, def_id_t id) noexcept {
+    return id < positions.size() ? positions[id] : position{0, 0};
+  }
+
+public:
+  void tile(project_writer &out, const TileCell &cell) const {
+    const TileDef *def = _tile_dex != nullptr ? _tile_dex->tile(cell) : nullptr;
+
+    const auto p = def == nullptr ? position{0, 0} : at(_tiles, def->get_id());
+    out.point(p.category, p.index);
+  }
+
+  void prop(project_writer &out, std::string_view name, const PropDef *prop_def, const TileDef *tile_def) const {
+    if (prop_def == nullptr && tile_def == nullptr && _prop_dex != nullptr) {
+      prop_def = _prop_dex->prop(std::string(name));
+      if (prop_def == nullptr) tile_def = _prop_dex->tile(std::string(name));
+    }
+
+    position p{0, 0};
+
+    if (prop_def != nullptr) p = at(_props, prop_def->get_id());
+    else if (tile_def != nullptr) p = at(_tile_props, tile_def->get_id());
+
+    out.point(p.category, p.index);
+  }
+
+  def_positions(const TileDex *tiles, const PropDex *props) : _tile_dex(tiles), _prop_dex(props) {
+    if (tiles != nullptr) index(_tiles, tiles->tiles().size(), tiles->sorted_tiles(), 1);
+
+    if (props != nullptr) {
+      index(_props, props->props().size(), props->sorted_props(), 1);
+
+      if (tiles != nullptr) {
+        index(_tile_props, tiles->tiles().size(), props->sorted_tiles(), static_cast<int>(props->categories().size()) + 1);
+      }
+    }
+  }
+};
+
+// The editor's key state; never meaningful in a saved file.
+
+static constexpr std::string_view tile_keys =
+  "[#L: 0, #m1: 0, #m2: 0, #w: 0, #a: 0, #s: 0, #d: 0, #c: 0, #q: 0]";
+
+static constexpr std::string_view effect_keys =
+  "[#n: 0, #m1: 0, #m2: 0, #w: 0, #a: 0, #s: 0, #d: 0, #e: 0, #r: 0, #f: 0]";
+
+static constexpr std::string_view light_keys =
+  "[#m1: 0, #m2: 0, #w: 0, #a: 0, #s: 0, #d: 0, #r: 0, #f: 0, #z: 0, #m: 0]";
+
+static constexpr std::string_view camera_keys =
+  "[#n: 0, #d: 0, #e: 0, #p: 0]";
+
+static constexpr std::string_view editor_keys =
+  "[#w: 0, #a: 0, #s: 0, #d: 0, #L: 0, #n: 0, #m1: 0, #m2: 0, #c: 0, #z: 0]";
+
+/// @brief The feature IDs of each GeoFeature bit, in bit order; the
+/// inverse of get_geo_feature().
+static constexpr int geo_feature_ids[16] = {
+  1, 2, 3, 4, 5, 6, 7, 9, 10, 11, 12, 13, 18, 19, 20, 21
+};
+
+static void ser_geometry_matrix(project_writer &out, const Matrix<GeoCell> &matrix) {
+  out << '[';
+
+  for (matrix_t x = 0; x < matrix.get_width(); x++) {
+    if (x > 0) out << ", ";
+    out << '[';
+
+    for (matrix_t y = 0; y < matrix.get_height(); y++) {
+      if (y > 0) out << ", ";
+      out << '[';
+
+      for (matrix_t z = 0; z < 3; z++) {
+        const GeoCell &cell = matrix.get_const(x, y, z);
+        const auto features = static_cast<uint16_t>(cell.features);
+
+        if (z > 0) out << ", ";
+        out << '[' << static_cast<int>(cell.type) << ", [";
+
+        bool first = true;
+        for (int bit = 0; bit < 16; bit++) {
+          if ((features & (1 << bit)) == 0) continue;
+
+          if (!first) out << ", ";
+          out << geo_feature_ids[bit];
+          first = false;
+        }
+
+        out << "]]";
+      }
+
+      out << ']';
+    }
+
+    out << ']';
+  }
+
+  out << ']';
+}
+
+static void ser_tilecell(project_writer &out, const TileCell &cell, const def_positions &positions) {
+  switch (cell.type) {
+  case TileType::head:
+    out << "[#tp: \"tileHead\", #Data: [";
+    positions.tile(out, cell);
+    out << ", ";
+    out.string(cell.und_name());
+    out << "]]";
+    break;
+
+  case TileType::body:
+    out << "[#tp: \"tileBody\", #Data: [";
+    out.point(cell.head_pos_x + 1, cell.head_pos_y + 1);
+    out << ", " << (static_cast<int>(cell.head_pos_z) + 1) << "]]";
+    break;
+
+  case TileType::material:
+    out << "[#tp: \"material\", #Data: ";
+    out.string(cell.und_name());
+    out << ']';
+    break;
+
+  default:
+    out << "[#tp: \"default\", #Data: 0]";
+    break;
+  }
+}
+
+static void ser_tiles(project_writer &out, const Level &level, const def_positions &positions) {
+  const auto &matrix = level.get_const_tile_matrix();
+
+  out << "[#lastKeys: " << tile_keys << ", #Keys: " << tile_keys
+      << ", #workLayer: 1, #lstMsPs: point(0, 0), #tlMatrix: [";
+
+  for (matrix_t x = 0; x < matrix.get_width(); x++) {
+    if (x > 0) out << ", ";
+    out << '[';
+
+    for (matrix_t y = 0; y < matrix.get_height(); y++) {
+      if (y > 0) out << ", ";
+      out << '[';
+
+      for (matrix_t z = 0; z < 3; z++) {
+        if (z > 0) out << ", ";
+        ser_tilecell(out, matrix.get_const(x, y, z), positions);
+      }
+
+      out << ']';
+    }
+
+    out << ']';
+  }
+
+  out << "], #defaultMaterial: ";
+  out.string(level.default_material);
+  out << ", #toolType: \"material\", #toolData: \"Big Metal\", #tmPos: point(1, 1), #tmSavPosL: [], #specialEdit: 0]";
+}
+
+static void ser_effect(project_writer &out, const Effect &effect) {
+  out << "[#nm: ";
+  out.string(effect.name);
+  out << ", #tp: ";
+  out.string(effect.type);
+
+  if (effect.type == "standardErosion") {
+    out << ", #repeats: " << effect.repeats
+        << ", #affectOpenAreas: " << effect.affect_open_areas;
+  }
+
+  out << ", #crossScreen: " << effect.cross_screen << ", #mtrx: [";
+
+  for (matrix_t x = 0; x < effect.matrix.get_width(); x++) {
+    if (x > 0) out << ", ";
+    out << '[';
+
+    for (matrix_t y = 0; y < effect.matrix.get_height(); y++) {
+      if (y > 0) out << ", ";
+      out << static_cast<int>(effect.matrix.get(x, y));
+    }
+
+    out << ']';
+  }
+
+  out << "], #Options: [";
+
+  for (size_t c = 0; c < effect.config.size(); c++) {
+    const auto &config = effect.config[c];
+
+    if (c > 0) out << ", ";
+    out << '[';
+    out.string(config.name);
+    out << ", [";
+
+    for (size_t o = 0; o < config.options.size(); o++) {
+      if (o > 0) out << ", ";
+      out.string(config.options[o]);
+    }
+
+    out << "], ";
+
+    if (config.choice_type != 0) {
+      out << config.choice;
+    } else if (config.choice >= 0 && static_cast<size_t>(config.choice) < config.options.size()) {
+      out.string(config.options[config.choice]);
+    } else {
+      out.string(config.unlisted_choice);
+    }
+
+    out << ']';
+  }
+
+  out << "]]";
+}
+
+static void ser_effects(project_writer &out, const Level &level) {
+  const auto &effects = level.get_const_effects();
+
+  out << "[#lastKeys: " << effect_keys << ", #Keys: " << effect_keys
+      << ", #lstMsPs: point(0, 0), #effects: [";
+
+  for (size_t e = 0; e < effects.size(); e++) {
+    if (e > 0) out << ", ";
+    ser_effect(out, effects[e]);
+  }
+
+  out << "], #emPos: point(1, 1), #editEffect: 0, #selectEditEffect: 0, #mode: \"createNew\", #brushSize: 5]";
+}
+
+/// @brief A property that the level models, rewritten when a settings
+/// line is carried over from the project being replaced.
+struct property_patch {
+  std::string_view key;
+  std::function<void(project_writer&)> write;
+};
+
+static bool is_space(char c) noexcept { return c == ' ' || c == '\t'; }
+
+static bool equals_ignore_case(std::string_view a, std::string_view b) noexcept {
+  if (a.size() != b.size()) return false;
+
+  for (size_t i = 0; i < a.size(); i++) {
+    if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i]))) return false;
+  }
+
+  return true;
+}
+
+/// @return The end of the value starting at begin: the next ',' or the
+/// closing ']' of the enclosing list, outside of nested lists, calls
+/// and strings. npos if the line ends first.
+static size_t value_end(std::string_view line, size_t begin) noexcept {
+  int depth = 0;
+  bool string = false;
+
+  for (size_t i = begin; i < line.size(); i++) {
+    const char c = line[i];
+
+    if (string) {
+      if (c == '"') string = false;
+      continue;
+    }
+
+    switch (c) {
+    case '"': string = true; break;
+    case '[': case '(': depth++; break;
+
+    case ']': case ')':
+      if (depth == 0) return i;
+      depth--;
+      break;
+
+    case ',':
+      if (depth == 0) return i;
+      break;
+    }
+  }
+
+  return std::string_view::npos;
+}
+
+/// @brief Writes a property list from the project being replaced, with
+/// the patched properties rewritten and every other one kept as it was.
+/// Patched properties missing from the list are appended to it.
+/// @return false, having written nothing, if the original line is not a
+/// property list.
+static bool ser_patched(project_writer &out, std::string_view original, const std::vector<property_patch> &patches) {
+  struct value { size_t begin, end; const property_patch *patch; };
+
+  while (!original.empty() && (is_space(original.front()) || original.front() == '\n')) original.remove_prefix(1);
+  while (!original.empty() && (is_space(original.back()) || original.back() == '\n')) original.remove_suffix(1);
+
+  if (original.size() < 2 || original.front() != '[' || original.back() != ']') return false;
+
+  std::vector<value> values;
+  std::vector<bool> found(patches.size(), false);
+
+  size_t i = 1;
+  bool empty = true;
+
+  // "[:]" is an empty property list.
+  while (i < original.size() && is_space(original[i])) i++;
+  if (original[i] == ':') i++;
+
+  for (;;) {
+    while (i < original.size() && is_space(original[i])) i++;
+    if (i >= original.size()) return false;
+    if (original[i] == ']' && i == original.size() - 1) break;
+    if (original[i] != '#') return false;
+
+    const size_t key_begin = ++i;
+    while (i < original.size() && (std::isalnum(static_cast<unsigned char>(original[i])) || original[i] == '_')) i++;
+
+    const auto key = original.substr(key_begin, i - key_begin);
+
+    while (i < original.size() && is_space(original[i])) i++;
+    if (i >= original.size() || original[i] != ':') return false;
+    i++;
+
+    while (i < original.size() && is_space(original[i])) i++;
+
+    const size_t end = value_end(original, i);
+    if (end == std::string_view::npos) return false;
+
+    for (size_t p = 0; p < patches.size(); p++) {
+      if (!found[p] && equals_ignore_case(key, patches[p].key)) {
+        values.push_back(value{ i, end, &patches[p] });
+        found[p] = true;
+        break;
+      }
+    }
+
+    empty = false;
+    i = end;
+
+    if (original[i] == ',') i++;
+    else if (i != original.size() - 1) return false;
+  }
+
+  size_t written = 0;
+
+  for (const auto &v : values) {
+    out << original.substr(written, v.begin - written);
+    v.patch->write(out);
+    written = v.end;
+  }
+
+  const size_t close = original.size() - 1;
+
+  if (empty) {
+    out << '[';
+  } else {
+    // Trailing spaces before the closing bracket are dropped.
+    size_t last = close;
+    while (last > written && is_space(original[last - 1])) last--;
+    out << original.substr(written, last - written);
+  }
+
+  for (size_t p = 0; p < patches.size(); p++) {
+    if (found[p]) continue;
+
+    if (!empty) out << ", ";
+    empty = false;
+
+    out << '#' << patches[p].key << ": ";
+    patches[p].write(out);
+  }
+
+  out << ']';
+  return true;
+}
+
+static void ser_light_settings(project_writer &out, const Level &level, std::string_view original) {
+  const std::vector<property_patch> patches = {
+    { "lightAngle", [&level](project_writer &o) { o << level.light_angle; } },
+    { "flatness",   [&level](project_writer &o) { o << level.light_flatness; } }
+  };
+
+  if (ser_patched(out, original, patches)) return;
+
+  out << "[#pos: point(0, 0), #rot: 0, #sz: point(50, 70), #col: 1, #Keys: "
+      << light_keys << ", #lastKeys: " << light_keys
+      << ", #lastTm: 0, #lightAngle: " << level.light_angle
+      << ", #flatness: " << level.light_flatness
+      << ", #lightRect: rect(1000, 1000, -1000, -1000), #paintShape: \"pxl\"]";
+}
+
+static void ser_terrain_settings(project_writer &out, const Level &level, std::string_view original) {
+  const std::vector<property_patch> patches = {
+    { "defaultTerrain", [&level](project_writer &o) { o << level.terrain; } }
+  };
+
+  if (ser_patched(out, original, patches)) return;
+
+  out << "[#timeLimit: 4800, #defaultTerrain: " << level.terrain
+      << ", #maxFlies: 10, #flySpawnRate: 50, #lizards: [], #ambientSounds: [], #music: \"NONE\", #tags: [], #lightType: \"Static\", #waterDrips: 1, #lightRect: rect(0, 0, "
+      << static_cast<int>(level.get_pixel_width()) << ", "
+      << static_cast<int>(level.get_pixel_height()) << "), #Matrix: []]";
+}
+
+static void ser_seed_and_sizes(project_writer &out, const Level &level, std::string_view original) {
+  const auto &buffer = level.buffer_geos;
+
+  auto write_size = [&level](project_writer &o) {
+    o.point(static_cast<int>(level.get_width()), static_cast<int>(level.get_height()));
+  };
+
+  auto write_extra_tiles = [&buffer](project_writer &o) {
+    o << '['
+      << static_cast<int>(buffer.left) << ", "
+      << static_cast<int>(buffer.top) << ", "
+      << static_cast<int>(buffer.right) << ", "
+      << static_cast<int>(buffer.bottom) << ']';
+  };
+
+  const std::vector<property_patch> patches = {
+    { "tileSeed",   [&level](project_writer &o) { o << level.seed; } },
+    { "size",       write_size },
+    { "extraTiles", write_extra_tiles },
+    { "light",      [&level](project_writer &o) { o << level.light; } }
+  };
+
+  if (ser_patched(out, original, patches)) return;
+
+  out << "[#lastKeys: " << editor_keys << ", #Keys: " << editor_keys
+      << ", #lstMsPs: point(0, 0), #tileSeed: " << level.seed
+      << ", #colGlows: [0, 0], #size: ";
+
+  write_size(out);
+
+  out << ", #extraTiles: ";
+  write_extra_tiles(out);
+  out << ", #light: " << level.light << ']';
+}
+
+static void ser_cameras(project_writer &out, const Level &level) {
+  out << "[#cameras: [";
+
+  for (size_t c = 0; c < level.cameras.size(); c++) {
+    if (c > 0) out << ", ";
+    out.point(level.cameras[c].get_position());
+  }
+
+  out << "], #selectedCamera: 0, #quads: [";
+
+  for (size_t c = 0; c < level.cameras.size(); c++) {
+    const auto &camera = level.cameras[c];
+
+    if (c > 0) out << ", ";
+
+    out << "[[" << camera.get_top_left_angle() << ", " << camera.get_top_left_radius()
+        << "], [" << camera.get_top_right_angle() << ", " << camera.get_top_right_radius()
+        << "], [" << camera.get_bottom_right_angle() << ", " << camera.get_bottom_right_radius()
+        << "], [" << camera.get_bottom_left_angle() << ", " << camera.get_bottom_left_radius()
+        << "]]";
+  }
+
+  out << "], #Keys: " << camera_keys << ", #lastKeys: " << camera_keys << ']';
+}
+
+static void ser_water(project_writer &out, const Level &level, std::string_view original) {
+  const std::vector<property_patch> patches = {
+    { "waterLevel",   [&level](project_writer &o) { o << level.water; } },
+    { "waterInFront", [&level](project_writer &o) { o << level.front_water; } }
+  };
+
+  if (ser_patched(out, original, patches)) return;
+
+  out << "[#waterLevel: " << level.water << ", #waterInFront: " << level.front_water
+      << ", #waveLength: 60, #waveAmplitude: 5, #waveSpeed: 10]";
+}
+
+static void ser_prop_settings(project_writer &out, const Prop &prop) {
+  const auto &settings = prop.settings;
+
+  out << "[#renderorder: " << settings.render_order
+      << ", #seed: " << settings.seed
+      << ", #renderTime: " << settings.render_time;
+
+  // Props that were never defined keep every setting; the rest
+  // only write what their type uses.
+  bool variation = true, custom_depth = true, apply_color = true, rope = true;
+
+  if (prop.prop_def != nullptr) {
+    const auto type = prop.prop_def->type;
+
+    variation =
+      type == PropType::varied_standard ||
+      type == PropType::varied_soft ||
+      type == PropType::varied_decal;
+
+    custom_depth =
+      type == PropType::soft ||
+      type == PropType::varied_soft ||
+      type == PropType::soft_effect ||
+      type == PropType::decal ||
+      type == PropType::varied_decal ||
+      type == PropType::antimatter;
+
+    apply_color = type == PropType::varied_soft || type == PropType::rope;
+    rope = type == PropType::rope;
+  } else if (prop.tile_def != nullptr) {
+    variation = custom_depth = apply_color = rope = false;
+  }
+
+  if (variation)    out << ", #var: " << (settings.variation + 1);
+  if (custom_depth) out << ", #customDepth: " << settings.custom_depth;
+  if (rope)         out << ", #release: " << static_cast<int>(settings.release)
+                        << ", #thickness: " << settings.thickness;
+  if (apply_color)  out << ", #applyColor: " << settings.apply_color;
+
+  out << ']';
+}
+
+static void ser_props(project_writer &out, const Level &level, const def_positions &positions) {
+  out << "[#props: [";
+
+  for (size_t p = 0; p < level.props.size(); p++) {
+    const Prop &prop = *level.props[p];
+
+    // Undo the scaling applied in deser_props().
+    Quad quad = prop.quad;
+    quad *= 1.0f / 1.25f;
+
+    if (p > 0) out << ", ";
+
+    const std::string_view name = prop.und_name != nullptr ? std::string_view(*prop.und_name) : std::string_view();
+
+    out << '[' << prop.depth << ", ";
+    out.string(name);
+    out << ", ";
+    positions.prop(out, name, prop.prop_def, prop.tile_def);
+    out << ", [";
+    out.point(quad.topleft);
+    out << ", ";
+    out.point(quad.topright);
+    out << ", ";
+    out.point(quad.bottomright);
+    out << ", ";
+    out.point(quad.bottomleft);
+    out << "], [#settings: ";
+
+    ser_prop_settings(out, prop);
+
+    if (!prop.settings.segments.empty()) {
+      out << ", #points: [";
+
+      for (size_t s = 0; s < prop.settings.segments.size(); s++) {
+        if (s > 0) out << ", ";
+        out.point(prop.settings.segments[s]);
+      }
+
+      out << ']';
+    }
+
+    out << "]]";
+  }
+
+  out << "], #lastKeys: " << editor_keys << ", #Keys: " << editor_keys
+      << ", #workLayer: 1, #lstMsPs: point(0, 0), #pmPos: point(1, 1), #pmSavPosL: [], #propRotation: 0, #propStretchX: 1, #propStretchY: 1, #propFlipX: 1, #propFlipY: 1, #depth: 0, #color: 0]";
+}
+
+void ser_level(const Level &level, const std::filesystem::path &path, const TileDex *tiles, const PropDex *props) {
+  const def_positions positions(tiles, props);
+
+  // The settings lines of the project being replaced keep the
+  // properties that the level doesn't model.
+  std::unique_ptr<ProjectSaveFileViews> original;
+  std::error_code exists_ec;
+
+  if (std::filesystem::is_regular_file(path, exists_ec)) {
+    try {
+      original = map_project(path);
+    } catch (const std::exception &) {
+      original = nullptr;
+    }
+  }
+
+  const ProjectSaveFileViews none;
+  const auto &lines = original != nullptr ? *original : none;
+
+  // Written next to the destination first, so that a failed save
+  // does not leave a truncated project behind.
+  auto temporary = path;
+  temporary += ".tmp";
+
+  try {
+    project_writer out(temporary);
+
+    ser_geometry_matrix(out, level.get_const_geo_matrix());   out << '\r';
+    ser_tiles(out, level, positions);                         out << '\r';
+    ser_effects(out, level);                                  out << '\r';
+    ser_light_settings(out, level, lines.light_settings);     out << '\r';
+    ser_terrain_settings(out, level, lines.terrain_settings); out << '\r';
+    ser_seed_and_sizes(out, level, lines.seed_and_sizes);     out << '\r';
+    ser_cameras(out, level);                                  out << '\r';
+    ser_water(out, level, lines.water);                       out << '\r';
+    ser_props(out, level, positions);                         out << '\r';
+
+    out.close();
+  } catch (...) {
+    original.reset();
+
+    std::error_code ec;
+    std::filesystem::remove(temporary, ec);
+    throw;
+  }
+
+  // The mapping would keep the project from being replaced on Windows.
+  original.reset();
+
+  std::error_code ec;
+  std::filesystem::rename(temporary, path, ec);
+
+  if (ec) {
+    std::filesystem::remove(temporary, ec);
+    throw serialization_failure("failed to replace '"+path.string()+"'");
+  }
+}
+}; // namespace mr::serde
@@ -20,6 +20,7 @@
 #include <MobitRenderer/state.h>
 #include <MobitRenderer/utils.h>
 #include <MobitRenderer/io.h>
+#include <MobitRenderer/keying.h>
 
 namespace mr {
 
@@ -247,7 +248,9 @@ context::context(std::shared_ptr<spdlog::logger> logger,
       f3_(std::make_shared<debug::f3>(GetFontDefault(), 22, WHITE, Color{GRAY.r, GRAY.g, GRAY.b, 120})),
       camera(Camera2D{Vector2{1, 40}, Vector2{0, 0}, 0, 0.5f}),
       enable_global_shortcuts(true),
-      level_layer_(0) {}
+      level_layer_(0) {
+  if (_config->cache_keyed_textures) set_keyed_image_cache(dirs->get_executable() / "cache" / "keyed");
+}
 
 
 context::~context() {
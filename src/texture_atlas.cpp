@@ -0,0 +1,164 @@
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <filesystem>
+
+#include <raylib.h>
+
+#include <MobitRenderer/keying.h>
+#include <MobitRenderer/managed.h>
+#include <MobitRenderer/texture_atlas.h>
+
+namespace mr {
+
+TextureAtlas::handle_t TextureAtlas::add(const std::filesystem::path &path) {
+  _entries.push_back(entry{ path, -1, Rectangle{0, 0, 0, 0} });
+  return _entries.size() - 1;
+}
+
+void TextureAtlas::build() {
+  _pages.clear();
+
+  std::vector<Image> images(_entries.size(), Image{nullptr, 0, 0, 0, 0});
+
+  for (size_t i = 0; i < _entries.size(); i++) {
+    auto &e = _entries[i];
+    e.page = -1;
+
+    auto &img = images[i];
+    img = _keyed ? load_keyed_image(e.path) : LoadImage(e.path.string().c_str());
+
+    if (img.data == nullptr) continue;
+
+    if (img.width > _page_size || img.height > _page_size) {
+      UnloadImage(img);
+      img = Image{nullptr, 0, 0, 0, 0};
+      continue;
+    }
+
+    ImageFormat(&img, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+  }
+
+  // Shelf packing: the tallest images first, each placed on the first
+  // shelf with room left, or on a new shelf under the last one.
+  std::vector<size_t> order(_entries.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&images](size_t a, size_t b) {
+    return images[a].height > images[b].height;
+  });
+
+  struct shelf { int y, height, x; };
+  struct layout { std::vector<shelf> shelves; int height; };
+
+  std::vector<layout> layouts;
+
+  for (auto i : order) {
+    const auto &img = images[i];
+    if (img.data == nullptr) continue;
+
+    int page = -1;
+    shelf *target = nullptr;
+
+    for (size_t p = 0; p < layouts.size() && target == nullptr; p++) {
+      for (auto &s : layouts[p].shelves) {
+        if (s.height >= img.height && s.x + img.width <= _page_size) {
+          page = static_cast<int>(p);
+          target = &s;
+          break;
+        }
+      }
+
+      if (target == nullptr && layouts[p].height + img.height <= _page_size) {
+        layouts[p].shelves.push_back(shelf{ layouts[p].height, img.height, 0 });
+        layouts[p].height += img.height;
+
+        page = static_cast<int>(p);
+        target = &layouts[p].shelves.back();
+      }
+    }
+
+    if (target == nullptr) {
+      layouts.push_back(layout{ { shelf{ 0, img.height, 0 } }, img.height });
+
+      page = static_cast<int>(layouts.size() - 1);
+      target = &layouts.back().shelves.back();
+    }
+
+    auto &e = _entries[i];
+    e.page = page;
+    e.rect = Rectangle{
+      static_cast<float>(target->x),
+      static_cast<float>(target->y),
+      static_cast<float>(img.width),
+      static_cast<float>(img.height)
+    };
+
+    target->x += img.width;
+  }
+
+  // Pages are only as tall as their shelves.
+  std::vector<std::vector<uint8_t>> pixels(layouts.size());
+
+  for (size_t p = 0; p < layouts.size(); p++) {
+    pixels[p].assign(static_cast<size_t>(_page_size) * layouts[p].height * 4, 0);
+  }
+
+  for (size_t i = 0; i < _entries.size(); i++) {
+    const auto &e = _entries[i];
+    auto &img = images[i];
+
+    if (img.data == nullptr) continue;
+
+    const auto *src = static_cast<const uint8_t *>(img.data);
+    auto *dst = pixels[e.page].data();
+
+    const size_t row = static_cast<size_t>(img.width) * 4;
+
+    for (int y = 0; y < img.height; y++) {
+      std::memcpy(
+        dst + ((static_cast<size_t>(e.rect.y) + y) * _page_size + static_cast<size_t>(e.rect.x)) * 4,
+        src + y * row,
+        row
+      );
+    }
+
+    UnloadImage(img);
+  }
+
+  _pages.reserve(layouts.size());
+
+  for (size_t p = 0; p < layouts.size(); p++) {
+    Image page = {
+      pixels[p].data(),
+      _page_size,
+      layouts[p].height,
+      1,
+      PIXELFORMAT_UNCOMPRESSED_R8G8B8A8
+    };
+
+    _pages.emplace_back(page);
+  }
+}
+
+AtlasRegion TextureAtlas::region(handle_t handle) const noexcept {
+  if (handle >= _entries.size()) return AtlasRegion{ nullptr, Rectangle{0, 0, 0, 0} };
+
+  const auto &e = _entries[handle];
+
+  if (e.page < 0 || static_cast<size_t>(e.page) >= _pages.size()) {
+    return AtlasRegion{ nullptr, Rectangle{0, 0, 0, 0} };
+  }
+
+  return AtlasRegion{ _pages[e.page].get_ptr(), e.rect };
+}
+
+void TextureAtlas::clear() {
+  _entries.clear();
+  _pages.clear();
+}
+
+TextureAtlas::TextureAtlas(int page_size, bool keyed) : _page_size(page_size), _keyed(keyed) {}
+
+}; // namespace mr
@@ -1,112 +1,131 @@
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <MobitRenderer/definitions.h>
 #include <MobitRenderer/matrix.h>
 
 namespace mr {
 
-// TileCell &TileCell::operator=(TileCell const &other) {
-//     if (this == &other) return *this;
-
-//     type = other.type;
-//     und_name = other.und_name;
-//     head_pos_x = other.head_pos_x;
-//     head_pos_y = other.head_pos_y;
-//     head_pos_z = other.head_pos_z;
-//     tile_def = other.tile_def;
-//     material_def = other.material_def;
-
-//     return *this;
-// }
-// TileCell &TileCell::operator=(TileCell &&other) noexcept {
-//     if (this == &other) return *this;
-
-//     und_name = std::move(other.und_name);
-    
-//     type = other.type;
-//     head_pos_x = other.head_pos_x;
-//     head_pos_y = other.head_pos_y;
-//     head_pos_z = other.head_pos_z;
-//     tile_def = other.tile_def;
-//     material_def = other.material_def;
-
-//     other.type = TileType::_default;
-//     other.head_pos_x = 0;
-//     other.head_pos_y = 0;
-//     other.head_pos_z = 0;
-//     other.tile_def = nullptr;
-//     other.material_def = nullptr;
-
-//     return *this;
-// }
-
-// TileCell::TileCell(TileCell const &other) {
-//     type = other.type;
-//     und_name = other.und_name;
-//     head_pos_x = other.head_pos_x;
-//     head_pos_y = other.head_pos_y;
-//     head_pos_z = other.head_pos_z;
-//     tile_def = other.tile_def;
-//     material_def = other.material_def;
-// }
-// TileCell::TileCell(TileCell &&other) noexcept {
-//     und_name = std::move(other.und_name);
-    
-//     type = other.type;
-//     head_pos_x = other.head_pos_x;
-//     head_pos_y = other.head_pos_y;
-//     head_pos_z = other.head_pos_z;
-//     tile_def = other.tile_def;
-//     material_def = other.material_def;
-
-//     other.type = TileType::_default;
-//     other.head_pos_x = 0;
-//     other.head_pos_y = 0;
-//     other.head_pos_z = 0;
-//     other.tile_def = nullptr;
-//     other.material_def = nullptr;
-// }
-
-TileCell::TileCell() : 
-    type(TileType::_default), 
-    und_name(std::string("")),
+namespace {
+
+/// @brief Names are stored in fixed blocks that never move, so that
+/// names can be read without locking while others are interned.
+/// @note Only names are kept here; definitions are resolved by the dexes.
+class tile_name_table {
+public:
+  static constexpr size_t block_bits = 10;
+  static constexpr size_t block_size = size_t(1) << block_bits;
+  static constexpr size_t max_blocks = 4096;
+
+private:
+  std::atomic<std::string*> _blocks[max_blocks];
+  std::atomic<tile_name_t> _count;
+
+  std::mutex _mutex;
+
+  // Views into the entries' names; guarded by _mutex.
+  std::unordered_map<std::string_view, tile_name_t> _ids;
+
+public:
+  const std::string *find(tile_name_t id) const noexcept {
+    if (id >= _count.load(std::memory_order_acquire)) return nullptr;
+    return &_blocks[id >> block_bits].load(std::memory_order_acquire)[id & (block_size - 1)];
+  }
+
+  tile_name_t intern(std::string_view name) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto found = _ids.find(name);
+    if (found != _ids.end()) return found->second;
+
+    const tile_name_t id = _count.load(std::memory_order_relaxed);
+    const size_t block = id >> block_bits;
+
+    if (block >= max_blocks) throw std::length_error("too many tile names");
+
+    auto *entries = _blocks[block].load(std::memory_order_relaxed);
+
+    if (entries == nullptr) {
+      entries = new std::string[block_size];
+      _blocks[block].store(entries, std::memory_order_release);
+    }
+
+    auto &entry = entries[id & (block_size - 1)];
+    entry.assign(name.data(), name.size());
+
+    _ids.emplace(entry, id);
+    _count.store(id + 1, std::memory_order_release);
+
+    return id;
+  }
+
+  tile_name_table() : _count(0) {
+    for (auto &block : _blocks) block.store(nullptr, std::memory_order_relaxed);
+    intern("");
+  }
+
+  ~tile_name_table() {
+    for (auto &block : _blocks) delete[] block.load(std::memory_order_relaxed);
+  }
+};
+
+tile_name_table &tile_names() {
+  static tile_name_table table;
+  return table;
+}
+
+}; // namespace
+
+tile_name_t intern_tile_name(std::string_view name) {
+  if (name.empty()) return 0;
+  return tile_names().intern(name);
+}
+
+std::string_view tile_name(tile_name_t id) noexcept {
+  const auto *entry = tile_names().find(id);
+  return entry == nullptr ? std::string_view() : std::string_view(*entry);
+}
+
+TileCell::TileCell() :
+    type(TileType::_default),
+    head_pos_z(0),
     head_pos_x(0),
     head_pos_y(0),
-    head_pos_z(0),
-    tile_def(nullptr),
-    material_def(nullptr) {}
+    name(0) {}
 
-TileCell::TileCell(TileDef *tile) : 
-    type(TileType::head), 
-    und_name(std::string("")),
+TileCell::TileCell(TileDef *tile) :
+    type(TileType::head),
+    head_pos_z(0),
     head_pos_x(0),
     head_pos_y(0),
-    head_pos_z(0),
-    tile_def(tile),
-    material_def(nullptr) { }
+    name(tile != nullptr ? intern_tile_name(tile->get_name()) : 0) { }
 
-TileCell::TileCell(uint16_t x, uint16_t y, uint16_t z, TileDef *tile) : 
-    type(TileType::body), 
-    und_name(std::string("")),
+TileCell::TileCell(uint16_t x, uint16_t y, uint16_t z, TileDef *tile) :
+    type(TileType::body),
+    // Out-of-range layers (e.g. -1 from a malformed project) must stay out of range.
+    head_pos_z(z > UINT8_MAX ? UINT8_MAX : static_cast<uint8_t>(z)),
     head_pos_x(x),
     head_pos_y(y),
-    head_pos_z(z),
-    tile_def(tile),
-    material_def(nullptr) { }
+    name(tile != nullptr ? intern_tile_name(tile->get_name()) : 0) { }
 
-TileCell::TileCell(MaterialDef *_material) : 
-    type(TileType::material), 
-    und_name(std::string("")),
+TileCell::TileCell(MaterialDef *material) :
+    type(TileType::material),
+    head_pos_z(0),
     head_pos_x(0),
     head_pos_y(0),
-    head_pos_z(0),
-    tile_def(nullptr),
-    material_def(_material) { }
+    name(material != nullptr ? intern_tile_name(material->get_name()) : 0) { }
 
-TileCell::TileCell(std::string name, bool material) : 
-    type(material ? TileType::material : TileType::head), 
-    und_name(name),
+TileCell::TileCell(std::string_view name, bool material) :
+    type(material ? TileType::material : TileType::head),
+    head_pos_z(0),
     head_pos_x(0),
     head_pos_y(0),
-    head_pos_z(0),
-    tile_def(nullptr),
-    material_def(nullptr) { }
+    name(intern_tile_name(name)) { }
 
-}
\ No newline at end of file
+}
@@ -12,6 +12,7 @@
 #include <raylib.h>
 
 #include <MobitRenderer/definitions.h>
+#include <MobitRenderer/keying.h>
 #include <MobitRenderer/utils.h>
 
 // To be used in unordered maps and sets
@@ -25,8 +26,12 @@ template <> struct hash<mr::TileDef> {
 
 namespace mr {
 
-void TileDef::load_texture() {
-  if (_is_texture_loaded) return;
+void TileDef::_load_textures(bool plain, bool keyed) {
+  plain = plain && !_is_texture_loaded;
+  keyed = keyed && !_is_keyed_texture_tried;
+  if (!plain && !keyed) return;
+
+  if (keyed) _is_keyed_texture_tried = true;
 
   if (!std::filesystem::exists(texture_path)) {
     #ifdef IS_DEBUG_BUILD
@@ -36,19 +41,46 @@ void TileDef::load_texture() {
     return;
   }
 
-  if (type != TileDefType::box) {
-    auto img = LoadImage(texture_path.string().c_str());
-    ImageCrop(&img, Rectangle{0, 1, (float)img.width, (float)img.height-1});
-    texture = LoadTextureFromImage(img);
+  // All but boxes have a row of pixels on top that isn't drawn.
+  const int skip_rows = type != TileDefType::box ? 1 : 0;
+
+  // The keyed texture alone may come from the cache; otherwise both are
+  // made from one decoded image.
+  if (!plain) {
+    auto img = load_keyed_image(texture_path, skip_rows);
+    if (img.data == nullptr) return;
+
+    keyed_texture = LoadTextureFromImage(img);
     UnloadImage(img);
-  } else {
-    texture = LoadTexture(texture_path.string().c_str());
+
+    _is_keyed_texture_loaded = true;
+    return;
   }
 
+  auto img = LoadImage(texture_path.string().c_str());
+  if (skip_rows > 0) ImageCrop(&img, Rectangle{0, (float)skip_rows, (float)img.width, (float)img.height-skip_rows});
+
+  texture = LoadTextureFromImage(img);
   _is_texture_loaded = true;
+
+  if (keyed && img.data != nullptr && img.height > 0) {
+    key_white(img);
+
+    keyed_texture = LoadTextureFromImage(img);
+    _is_keyed_texture_loaded = true;
+  }
+
+  UnloadImage(img);
 }
 
 void TileDef::unload_texture() {
+  if (_is_keyed_texture_loaded) {
+    mr::utils::unload_texture(keyed_texture);
+    _is_keyed_texture_loaded = false;
+  }
+
+  _is_keyed_texture_tried = false;
+
   if (!_is_texture_loaded) return;
   mr::utils::unload_texture(texture);
   _is_texture_loaded = false;
@@ -133,18 +165,23 @@ TileDef::TileDef(
     height(height), 
     buffer(buffer),
     rnd(rnd), 
-    tags(tags), 
     specs(specs), 
     specs2(specs2), 
     specs3(specs3),
     multilayer(!specs2.empty() || !specs3.empty()),
     repeat(repeat),
+    tags(tags), 
+    tag_set(TagSet::of(tags)),
     // first_layer_y((height + buffer*2) * repeat.size() * 20.0f),
     // total_layers(std::accumulate(repeat.begin(), repeat.end(), 0)),
     texture_path(""), 
-    texture(Texture2D{0}), 
+    id(no_def_id),
+    head_offset(mr::ivec2{(int)ceil(width / 2.0f) - 1, (int)ceil(height / 2.0f) - 1}),
     _is_texture_loaded(false),
-    head_offset(mr::ivec2{(int)ceil(width / 2.0f) - 1, (int)ceil(height / 2.0f) - 1}) 
+    _is_keyed_texture_loaded(false),
+    _is_keyed_texture_tried(false),
+    texture(Texture2D{0}), 
+    keyed_texture(Texture2D{0})
   {
     _preview_rectangle = Rectangle{
       0, 